@@ -437,6 +437,7 @@ declare global {
         "bannersetcolour" |
         "bannersetname" |
         "bannersetstyle" |
+        "batch" |
         "changemapsize" |
         "clearscenery" |
         "climateset" |
@@ -532,6 +533,14 @@ declare global {
         readonly ride: number;
     }
 
+    interface BatchGameActionResult extends GameActionResult {
+        /**
+         * The error of every action in the batch, in order. 0 if the action succeeded,
+         * actions that failed were skipped.
+         */
+        readonly errors: number[];
+    }
+
     interface NetworkEventArgs {
         readonly player: number;
     }
@@ -3139,6 +3148,7 @@ declare global {
 
     interface Profiler {
         getData(): ProfiledFunction[];
+        getCounters(): ProfiledCounter[];
         start(): void;
         stop(): void;
         reset(): void;
@@ -3154,4 +3164,12 @@ declare global {
         readonly parents: number[];
         readonly children: number[];
     }
+
+    interface ProfiledCounter {
+        readonly name: string;
+        readonly frameCount: number;
+        readonly total: number;
+        readonly max: number;
+        readonly frameSamples: number[];
+    }
 }
@@ -10,6 +10,7 @@
 #include "DrawingEngineFactory.hpp"
 
 #include <SDL.h>
+#include <algorithm>
 #include <cmath>
 #include <memory>
 #include <openrct2/Game.h>
@@ -31,6 +32,12 @@ class HardwareDisplayDrawingEngine final : public X8DrawingEngine
 private:
     constexpr static uint32_t DIRTY_VISUAL_TIME = 32;
 
+    struct DirtyVisual
+    {
+        ScreenRect Rect;
+        uint32_t TimeLeft;
+    };
+
     std::shared_ptr<IUiContext> const _uiContext;
     SDL_Window* _window = nullptr;
     SDL_Renderer* _sdlRenderer = nullptr;
@@ -47,7 +54,7 @@ private:
     bool _pausedBeforeOverlay = false;
     bool _useVsync = true;
 
-    std::vector<uint32_t> _dirtyVisualsTime;
+    std::vector<DirtyVisual> _dirtyVisuals;
 
     bool smoothNN = false;
 
@@ -185,19 +192,11 @@ public:
     }
 
 protected:
-    void OnDrawDirtyBlock(uint32_t left, uint32_t top, uint32_t columns, uint32_t rows) override
+    void OnDrawDirtyRect(const ScreenRect& rect) override
     {
         if (gShowDirtyVisuals)
         {
-            uint32_t right = left + columns;
-            uint32_t bottom = top + rows;
-            for (uint32_t x = left; x < right; x++)
-            {
-                for (uint32_t y = top; y < bottom; y++)
-                {
-                    SetDirtyVisualTime(x, y, DIRTY_VISUAL_TIME);
-                }
-            }
+            _dirtyVisuals.push_back({ rect, DIRTY_VISUAL_TIME });
         }
     }
 
@@ -299,40 +298,16 @@ private:
         }
     }
 
-    uint32_t GetDirtyVisualTime(uint32_t x, uint32_t y)
-    {
-        uint32_t result = 0;
-        uint32_t i = y * _dirtyGrid.BlockColumns + x;
-        if (_dirtyVisualsTime.size() > i)
-        {
-            result = _dirtyVisualsTime[i];
-        }
-        return result;
-    }
-
-    void SetDirtyVisualTime(uint32_t x, uint32_t y, uint32_t value)
-    {
-        uint32_t i = y * _dirtyGrid.BlockColumns + x;
-        if (_dirtyVisualsTime.size() > i)
-        {
-            _dirtyVisualsTime[i] = value;
-        }
-    }
-
     void UpdateDirtyVisuals()
     {
-        _dirtyVisualsTime.resize(_dirtyGrid.BlockRows * _dirtyGrid.BlockColumns);
-        for (uint32_t y = 0; y < _dirtyGrid.BlockRows; y++)
+        for (auto& visual : _dirtyVisuals)
         {
-            for (uint32_t x = 0; x < _dirtyGrid.BlockColumns; x++)
-            {
-                auto timeLeft = GetDirtyVisualTime(x, y);
-                if (timeLeft > 0)
-                {
-                    SetDirtyVisualTime(x, y, timeLeft - 1);
-                }
-            }
+            visual.TimeLeft--;
         }
+        _dirtyVisuals.erase(
+            std::remove_if(
+                _dirtyVisuals.begin(), _dirtyVisuals.end(), [](const DirtyVisual& visual) { return visual.TimeLeft == 0; }),
+            _dirtyVisuals.end());
     }
 
     void RenderDirtyVisuals()
@@ -341,25 +316,18 @@ private:
         float scaleY = gConfigGeneral.WindowScale;
 
         SDL_SetRenderDrawBlendMode(_sdlRenderer, SDL_BLENDMODE_BLEND);
-        for (uint32_t y = 0; y < _dirtyGrid.BlockRows; y++)
+        for (const auto& visual : _dirtyVisuals)
         {
-            for (uint32_t x = 0; x < _dirtyGrid.BlockColumns; x++)
-            {
-                auto timeLeft = GetDirtyVisualTime(x, y);
-                if (timeLeft > 0)
-                {
-                    uint8_t alpha = static_cast<uint8_t>(timeLeft * 5 / 2);
+            uint8_t alpha = static_cast<uint8_t>(visual.TimeLeft * 5 / 2);
 
-                    SDL_Rect ddRect;
-                    ddRect.x = static_cast<int32_t>(x * _dirtyGrid.BlockWidth * scaleX);
-                    ddRect.y = static_cast<int32_t>(y * _dirtyGrid.BlockHeight * scaleY);
-                    ddRect.w = static_cast<int32_t>(_dirtyGrid.BlockWidth * scaleX);
-                    ddRect.h = static_cast<int32_t>(_dirtyGrid.BlockHeight * scaleY);
+            SDL_Rect ddRect;
+            ddRect.x = static_cast<int32_t>(visual.Rect.GetLeft() * scaleX);
+            ddRect.y = static_cast<int32_t>(visual.Rect.GetTop() * scaleY);
+            ddRect.w = static_cast<int32_t>(visual.Rect.GetWidth() * scaleX);
+            ddRect.h = static_cast<int32_t>(visual.Rect.GetHeight() * scaleY);
 
-                    SDL_SetRenderDrawColor(_sdlRenderer, 255, 255, 255, alpha);
-                    SDL_RenderFillRect(_sdlRenderer, &ddRect);
-                }
-            }
+            SDL_SetRenderDrawColor(_sdlRenderer, 255, 255, 255, alpha);
+            SDL_RenderFillRect(_sdlRenderer, &ddRect);
         }
     }
 
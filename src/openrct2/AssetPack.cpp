@@ -10,6 +10,7 @@
 #include "AssetPack.h"
 
 #include "Context.h"
+#include "core/IStream.hpp"
 #include "core/Json.hpp"
 #include "core/Path.hpp"
 #include "core/Zip.h"
@@ -139,11 +140,21 @@ public:
         return _zipArchive->GetFileData(path);
     }
 
+    std::unique_ptr<IStream> GetStream(std::string_view path) override
+    {
+        return _zipArchive->GetFileStream(path);
+    }
+
     ObjectAsset GetAsset(std::string_view path) override
     {
         return ObjectAsset(_zipPath, path);
     }
 
+    std::shared_ptr<const void> GetSharedDataOwner() override
+    {
+        return nullptr;
+    }
+
     void LogVerbose(ObjectError code, const utf8* text) override
     {
     }
@@ -56,6 +56,7 @@
 #include "network/network.h"
 #include "object/ObjectManager.h"
 #include "object/ObjectRepository.h"
+#include "paint/Paint.StaticCache.h"
 #include "paint/Painter.h"
 #include "park/ParkFile.h"
 #include "platform/Crash.h"
@@ -348,6 +349,8 @@ namespace OpenRCT2
                 ConfigSaveDefault();
             }
 
+            gPaintStaticCacheEnabled = gConfigGeneral.StaticPaintCache;
+
             try
             {
                 _localisationService->OpenLanguage(gConfigGeneral.Language);
@@ -983,7 +986,18 @@ namespace OpenRCT2
                 {
                     gNetworkStartPort = gConfigNetwork.DefaultPort;
                 }
-                _network.BeginClient(gNetworkStartHost, gNetworkStartPort);
+                if (gNetworkStartRelayPort != 0)
+                {
+                    if (gNetworkStartAddress.empty())
+                    {
+                        gNetworkStartAddress = gConfigNetwork.ListenAddress;
+                    }
+                    _network.BeginRelay(gNetworkStartHost, gNetworkStartPort, gNetworkStartRelayPort, gNetworkStartAddress);
+                }
+                else
+                {
+                    _network.BeginClient(gNetworkStartHost, gNetworkStartPort);
+                }
             }
 #endif // DISABLE_NETWORK
 
@@ -0,0 +1,329 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2022 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "GameStateChecksum.h"
+
+#include "Game.h"
+#include "core/ChecksumStream.h"
+#include "core/DataSerialiser.h"
+#include "entity/EntityRegistry.h"
+#include "entity/Guest.h"
+#include "management/Finance.h"
+#include "profiling/Profiling.h"
+#include "ride/Ride.h"
+#include "world/Map.h"
+#include "world/Park.h"
+
+#include <cstring>
+
+static uint64_t GetChecksumValue(const std::array<std::byte, 20>& raw)
+{
+    uint64_t value;
+    std::memcpy(&value, raw.data(), sizeof(value));
+    return value;
+}
+
+// The map is split into interleaved bands of rows, each checksum only covers one of them. A tile element that diverged
+// is therefore only noticed once a checksum covers its band, on average after as many checks as there are bands, so
+// fewer bands detect tile desyncs sooner at the cost of hashing more rows per check. Both peers must agree on this, so
+// changing it needs a network version bump.
+constexpr uint32_t TileElementsChecksumBandsShift = 3;
+constexpr int32_t TileElementsChecksumBands = 1 << TileElementsChecksumBandsShift;
+
+static void SerialiseTileElement(DataSerialiser& ds, const TileElement& element)
+{
+    // Only the fields that are part of the game state, padding and local only flags like the last for tile and
+    // highlight bits are left out.
+    ds << element.GetType();
+    ds << element.GetDirection();
+    ds << element.GetOccupiedQuadrants();
+    ds << element.IsInvisible();
+    ds << element.base_height;
+    ds << element.clearance_height;
+    ds << element.owner;
+
+    switch (element.GetType())
+    {
+        case TileElementType::Surface:
+        {
+            const auto* surface = element.AsSurface();
+            ds << surface->GetSlope();
+            ds << surface->GetSurfaceStyle();
+            ds << surface->GetEdgeStyle();
+            ds << surface->GetGrassLength();
+            ds << surface->GetOwnership();
+            ds << surface->GetWaterHeight();
+            ds << surface->GetParkFences();
+            ds << surface->HasTrackThatNeedsWater();
+            break;
+        }
+        case TileElementType::Path:
+        {
+            const auto* path = element.AsPath();
+            ds << path->GetLegacyPathEntryIndex();
+            ds << path->GetRailingsEntryIndex();
+            ds << path->GetAddition();
+            ds << path->GetEdgesAndCorners();
+            ds << path->IsSloped();
+            ds << path->GetSlopeDirection();
+            ds << path->IsWide();
+            ds << path->IsQueue();
+            ds << path->IsBroken();
+            ds << path->IsBlockedByVehicle();
+            if (path->IsQueue())
+            {
+                ds << path->HasQueueBanner();
+                ds << path->GetQueueBannerDirection();
+                ds << path->GetRideIndex();
+                ds << path->GetStationIndex();
+            }
+            else
+            {
+                ds << path->GetAdditionStatus();
+            }
+            break;
+        }
+        case TileElementType::Track:
+        {
+            const auto* track = element.AsTrack();
+            ds << track->GetTrackType();
+            ds << track->GetRideType();
+            ds << track->GetRideIndex();
+            ds << track->HasChain();
+            ds << track->HasCableLift();
+            ds << track->IsInverted();
+            ds << track->BlockBrakeClosed();
+            ds << track->IsIndestructible();
+            if (track->GetRideType() == RIDE_TYPE_MAZE)
+            {
+                ds << track->GetMazeEntry();
+            }
+            else
+            {
+                ds << track->GetSequenceIndex();
+                ds << track->GetColourScheme();
+                ds << track->GetStationIndex();
+                ds << track->HasGreenLight();
+                ds << track->GetBrakeBoosterSpeed();
+                ds << track->GetPhotoTimeout();
+                ds << track->GetSeatRotation();
+            }
+            break;
+        }
+        case TileElementType::SmallScenery:
+        {
+            const auto* scenery = element.AsSmallScenery();
+            ds << scenery->GetEntryIndex();
+            ds << scenery->GetAge();
+            ds << scenery->GetPrimaryColour();
+            ds << scenery->GetSecondaryColour();
+            ds << scenery->GetTertiaryColour();
+            break;
+        }
+        case TileElementType::LargeScenery:
+        {
+            const auto* scenery = element.AsLargeScenery();
+            ds << scenery->GetEntryIndex();
+            ds << scenery->GetSequenceIndex();
+            ds << scenery->GetPrimaryColour();
+            ds << scenery->GetSecondaryColour();
+            ds << scenery->GetTertiaryColour();
+            ds << scenery->GetBannerIndex();
+            ds << scenery->IsAccounted();
+            break;
+        }
+        case TileElementType::Wall:
+        {
+            const auto* wall = element.AsWall();
+            ds << wall->GetEntryIndex();
+            ds << wall->GetSlope();
+            ds << wall->GetPrimaryColour();
+            ds << wall->GetSecondaryColour();
+            ds << wall->GetTertiaryColour();
+            ds << wall->GetAnimationFrame();
+            ds << wall->AnimationIsBackwards();
+            ds << wall->IsAcrossTrack();
+            ds << wall->GetBannerIndex();
+            break;
+        }
+        case TileElementType::Entrance:
+        {
+            const auto* entrance = element.AsEntrance();
+            ds << entrance->GetEntranceType();
+            ds << entrance->GetSequenceIndex();
+            ds << entrance->GetRideIndex();
+            ds << entrance->GetStationIndex();
+            ds << entrance->GetLegacyPathEntryIndex();
+            break;
+        }
+        case TileElementType::Banner:
+        {
+            const auto* banner = element.AsBanner();
+            ds << banner->GetIndex();
+            ds << banner->GetPosition();
+            ds << banner->GetAllowedEdges();
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+static uint64_t GetTileElementsChecksum()
+{
+    std::array<std::byte, 20> raw{};
+    OpenRCT2::ChecksumStream ms(raw);
+    DataSerialiser ds(true, ms);
+
+    // Hashing the whole map at every checksum tick is too slow for large parks, so only one band of rows is covered.
+    // The band is picked from the tick, which both peers agree on, and scrambled so any checksum interval eventually
+    // covers all bands.
+    const auto band = static_cast<int32_t>((gCurrentTicks * 2654435761u) >> (32 - TileElementsChecksumBandsShift));
+    ds << band;
+
+    // Walk the map tile by tile rather than hashing the element buffer, the buffer layout differs between peers
+    // after loading a park. Ghosts only exist locally, so skip them.
+    for (int32_t y = band; y < gMapSize.y; y += TileElementsChecksumBands)
+    {
+        for (int32_t x = 0; x < gMapSize.x; x++)
+        {
+            const auto* element = MapGetFirstElementAt(TileCoordsXY{ x, y });
+            if (element == nullptr)
+                continue;
+
+            do
+            {
+                if (!element->IsGhost())
+                {
+                    SerialiseTileElement(ds, *element);
+                }
+            } while (!(element++)->IsLastForTile());
+        }
+    }
+    return GetChecksumValue(raw);
+}
+
+static uint64_t GetRidesChecksum()
+{
+    std::array<std::byte, 20> raw{};
+    OpenRCT2::ChecksumStream ms(raw);
+    DataSerialiser ds(true, ms);
+
+    for (auto& ride : GetRideManager())
+    {
+        ds << ride.id;
+        ds << ride.type;
+        ds << ride.status;
+        ds << ride.lifecycle_flags;
+        ds << ride.mechanic_status;
+        ds << ride.breakdown_reason;
+        ds << ride.reliability;
+        ds << ride.num_riders;
+        ds << ride.cur_num_customers;
+        ds << ride.total_customers;
+        ds << ride.total_profit;
+        ds << ride.value;
+        for (auto price : ride.price)
+        {
+            ds << price;
+        }
+    }
+    return GetChecksumValue(raw);
+}
+
+static uint64_t GetFinancesChecksum()
+{
+    std::array<std::byte, 20> raw{};
+    OpenRCT2::ChecksumStream ms(raw);
+    DataSerialiser ds(true, ms);
+
+    ds << gCash;
+    ds << gBankLoan;
+    ds << gCurrentExpenditure;
+    ds << gCurrentProfit;
+    ds << gTotalIncomeFromAdmissions;
+    ds << gParkValue;
+    ds << gCompanyValue;
+    ds << gParkRating;
+    ds << gNumGuestsInPark;
+    return GetChecksumValue(raw);
+}
+
+GameStateChecksumSectionMask GameStateChecksum::Compare(const GameStateChecksum& other) const
+{
+    GameStateChecksumSectionMask mask = 0;
+    for (size_t i = 0; i < Sections.size(); i++)
+    {
+        if (Sections[i] != other.Sections[i])
+        {
+            mask |= 1u << i;
+        }
+    }
+    return mask;
+}
+
+GameStateChecksum GetGameStateChecksum()
+{
+    PROFILED_FUNCTION();
+
+    GameStateChecksum checksum;
+    for (size_t i = 0; i < checksum.Sections.size(); i++)
+    {
+        const auto section = static_cast<GameStateChecksumSection>(i);
+        const auto entityType = GetGameStateChecksumSectionEntityType(section);
+        if (entityType.has_value())
+        {
+            checksum.Sections[i] = GetRollingEntitiesChecksum(*entityType);
+        }
+    }
+    checksum.Sections[EnumValue(GameStateChecksumSection::TileElements)] = GetTileElementsChecksum();
+    checksum.Sections[EnumValue(GameStateChecksumSection::Rides)] = GetRidesChecksum();
+    checksum.Sections[EnumValue(GameStateChecksumSection::Finances)] = GetFinancesChecksum();
+    return checksum;
+}
+
+const char* GetGameStateChecksumSectionName(GameStateChecksumSection section)
+{
+    switch (section)
+    {
+        case GameStateChecksumSection::Guests:
+            return "guests";
+        case GameStateChecksumSection::Staff:
+            return "staff";
+        case GameStateChecksumSection::Vehicles:
+            return "vehicles";
+        case GameStateChecksumSection::Litter:
+            return "litter";
+        case GameStateChecksumSection::TileElements:
+            return "tile elements";
+        case GameStateChecksumSection::Rides:
+            return "rides";
+        case GameStateChecksumSection::Finances:
+            return "finances";
+        default:
+            return "unknown";
+    }
+}
+
+std::optional<EntityType> GetGameStateChecksumSectionEntityType(GameStateChecksumSection section)
+{
+    switch (section)
+    {
+        case GameStateChecksumSection::Guests:
+            return EntityType::Guest;
+        case GameStateChecksumSection::Staff:
+            return EntityType::Staff;
+        case GameStateChecksumSection::Vehicles:
+            return EntityType::Vehicle;
+        case GameStateChecksumSection::Litter:
+            return EntityType::Litter;
+        default:
+            return std::nullopt;
+    }
+}
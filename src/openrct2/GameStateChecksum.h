@@ -0,0 +1,59 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2022 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "common.h"
+#include "entity/EntityBase.h"
+
+#include <array>
+#include <optional>
+
+enum class GameStateChecksumSection : uint8_t
+{
+    Guests,
+    Staff,
+    Vehicles,
+    Litter,
+    TileElements,
+    Rides,
+    Finances,
+    Count,
+};
+
+using GameStateChecksumSectionMask = uint32_t;
+static_assert(static_cast<size_t>(GameStateChecksumSection::Count) <= sizeof(GameStateChecksumSectionMask) * 8);
+
+/*
+ * Separate hashes for parts of the game state, so a mismatch tells which part diverged.
+ */
+struct GameStateChecksum
+{
+    std::array<uint64_t, static_cast<size_t>(GameStateChecksumSection::Count)> Sections{};
+
+    /*
+     * Returns a mask of the sections that differ between both checksums.
+     */
+    GameStateChecksumSectionMask Compare(const GameStateChecksum& other) const;
+};
+
+/*
+ * Computes the checksum of the current game state, entities use the rolling checksum so only
+ * tile elements, rides and finances are hashed from scratch. Tile elements are covered one band of
+ * map rows at a time, picked from the current tick, so a diverged tile element may only be reported
+ * several checks after it diverged.
+ */
+GameStateChecksum GetGameStateChecksum();
+
+const char* GetGameStateChecksumSectionName(GameStateChecksumSection section);
+
+/*
+ * Returns the entity type covered by a section, nothing for sections that are not about entities.
+ */
+std::optional<EntityType> GetGameStateChecksumSectionEntityType(GameStateChecksumSection section);
@@ -22,6 +22,8 @@
 #include "entity/Staff.h"
 #include "ride/Vehicle.h"
 
+#include <algorithm>
+
 static constexpr size_t MaximumGameStateSnapshots = 32;
 static constexpr uint32_t InvalidTick = 0xFFFFFFFF;
 
@@ -186,6 +188,9 @@ struct GameStateSnapshots final : public IGameStateSnapshots
         snapshot.SerialiseSprites(
             [](const EntityId index) { return reinterpret_cast<EntitySnapshot*>(GetEntity(index)); }, MAX_ENTITIES, true);
 
+        // Snapshots are only taken for desync debugging, so also make sure the rolling checksum matches a full rehash.
+        VerifyRollingEntitiesChecksum();
+
         // log_info("Snapshot size: %u bytes", static_cast<uint32_t>(snapshot.storedSprites.GetLength()));
     }
 
@@ -207,6 +212,37 @@ struct GameStateSnapshots final : public IGameStateSnapshots
         ds << snapshot.parkParameters;
     }
 
+    virtual void SerialiseSnapshot(
+        GameStateSnapshot_t& snapshot, DataSerialiser& ds,
+        const std::optional<std::vector<EntityType>>& entityTypes) const override final
+    {
+        if (!entityTypes.has_value() || ds.IsLoading())
+        {
+            SerialiseSnapshot(snapshot, ds);
+            return;
+        }
+
+        GameStateSnapshot_t filtered;
+        filtered.tick = snapshot.tick;
+        filtered.srand0 = snapshot.srand0;
+        filtered.parkParameters = OpenRCT2::MemoryStream(snapshot.parkParameters);
+
+        std::vector<EntitySnapshot> spriteList = BuildSpriteList(snapshot);
+        filtered.SerialiseSprites(
+            [&spriteList, &entityTypes](const EntityId index) -> EntitySnapshot* {
+                auto& sprite = spriteList[index.ToUnderlying()];
+                return IsEntityTypeIncluded(sprite.base.Type, entityTypes) ? &sprite : nullptr;
+            },
+            MAX_ENTITIES, true);
+
+        SerialiseSnapshot(filtered, ds);
+    }
+
+    static bool IsEntityTypeIncluded(EntityType type, const std::optional<std::vector<EntityType>>& entityTypes)
+    {
+        return !entityTypes.has_value() || std::find(entityTypes->begin(), entityTypes->end(), type) != entityTypes->end();
+    }
+
     std::vector<EntitySnapshot> BuildSpriteList(GameStateSnapshot_t& snapshot) const
     {
         std::vector<EntitySnapshot> spriteList;
@@ -625,6 +661,13 @@ struct GameStateSnapshots final : public IGameStateSnapshots
     }
 
     virtual GameStateCompareData_t Compare(const GameStateSnapshot_t& base, const GameStateSnapshot_t& cmp) const override final
+    {
+        return Compare(base, cmp, std::nullopt);
+    }
+
+    virtual GameStateCompareData_t Compare(
+        const GameStateSnapshot_t& base, const GameStateSnapshot_t& cmp,
+        const std::optional<std::vector<EntityType>>& entityTypes) const override final
     {
         GameStateCompareData_t res;
         res.tickLeft = base.tick;
@@ -642,6 +685,8 @@ struct GameStateSnapshots final : public IGameStateSnapshots
 
             const EntitySnapshot& spriteBase = spritesBase[i];
             const EntitySnapshot& spriteCmp = spritesCmp[i];
+            if (!IsEntityTypeIncluded(spriteBase.base.Type, entityTypes) && !IsEntityTypeIncluded(spriteCmp.base.Type, entityTypes))
+                continue;
 
             changeData.entityType = spriteBase.base.Type;
 
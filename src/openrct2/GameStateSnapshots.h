@@ -13,8 +13,10 @@
 #include "core/DataSerialiser.h"
 
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
+#include <vector>
 
 struct GameStateSnapshot_t;
 
@@ -94,11 +96,26 @@ struct IGameStateSnapshots
      */
     virtual void SerialiseSnapshot(GameStateSnapshot_t& snapshot, DataSerialiser& serialiser) const = 0;
 
+    /*
+     * Serialisation of GameStateSnapshot_t keeping only entities of the given types, nullopt keeps all and an empty
+     * list none.
+     */
+    virtual void SerialiseSnapshot(
+        GameStateSnapshot_t& snapshot, DataSerialiser& serialiser,
+        const std::optional<std::vector<EntityType>>& entityTypes) const = 0;
+
     /*
      * Compares two states resulting GameStateCompareData_t with all mismatches stored.
      */
     virtual GameStateCompareData_t Compare(const GameStateSnapshot_t& base, const GameStateSnapshot_t& cmp) const = 0;
 
+    /*
+     * Compares two states like above but only entities of the given types, nullopt compares all and an empty list none.
+     */
+    virtual GameStateCompareData_t Compare(
+        const GameStateSnapshot_t& base, const GameStateSnapshot_t& cmp,
+        const std::optional<std::vector<EntityType>>& entityTypes) const = 0;
+
     /*
      * Writes the GameStateCompareData_t into the specified file as readable text.
      */
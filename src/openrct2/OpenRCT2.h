@@ -55,6 +55,7 @@ extern int32_t gNetworkStart;
 extern std::string gNetworkStartHost;
 extern int32_t gNetworkStartPort;
 extern std::string gNetworkStartAddress;
+extern int32_t gNetworkStartRelayPort;
 #endif
 
 extern uint32_t gCurrentDrawCount;
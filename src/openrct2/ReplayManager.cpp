@@ -11,6 +11,7 @@
 
 #include "Context.h"
 #include "Game.h"
+#include "GameState.h"
 #include "GameStateSnapshots.h"
 #include "OpenRCT2.h"
 #include "ParkImporter.h"
@@ -24,6 +25,8 @@
 #include "actions/TrackPlaceAction.h"
 #include "config/Config.h"
 #include "core/DataSerialiser.h"
+#include "core/File.h"
+#include "core/FileStream.h"
 #include "core/Path.hpp"
 #include "entity/EntityRegistry.h"
 #include "entity/EntityTweener.h"
@@ -35,7 +38,9 @@
 #include "world/Park.h"
 #include "zlib.h"
 
+#include <algorithm>
 #include <chrono>
+#include <deque>
 #include <memory>
 #include <vector>
 
@@ -78,6 +83,30 @@ namespace OpenRCT2
         OpenRCT2::MemoryStream data;
     };
 
+    enum class ReplayChunkType : uint8_t
+    {
+        Info,
+        Keyframe,
+        Commands,
+        Snapshot,
+        End,
+    };
+
+    /**
+     * Replays from version 11 onwards are a sequence of individually compressed chunks which are appended while recording.
+     * The chunk headers form the index of the file, keyframe chunks contain a full park which allows playback to seek.
+     */
+    struct ReplayChunk
+    {
+        ReplayChunkType type = ReplayChunkType::Info;
+        uint32_t tick = 0;
+        uint32_t numCommands = 0;
+        uint32_t numChecksums = 0;
+        uint32_t uncompressedSize = 0;
+        uint32_t compressedSize = 0;
+        uint64_t offset = 0; // Position of the compressed data, not stored in the file.
+    };
+
     struct ReplayRecordData
     {
         uint32_t magic;
@@ -92,16 +121,31 @@ namespace OpenRCT2
         uint32_t tickStart;    // First tick of replay.
         uint32_t tickEnd;      // Last tick of replay.
         std::multiset<ReplayCommand> commands;
-        std::vector<std::pair<uint32_t, EntitiesChecksum>> checksums;
+        std::deque<std::pair<uint32_t, EntitiesChecksum>> checksums;
         uint32_t checksumIndex;
+        uint32_t numCommands = 0;
+        uint32_t numChecksums = 0;
         OpenRCT2::MemoryStream gameStateSnapshots;
+
+        // Chunked replays only, legacy replays are read into memory at once.
+        std::unique_ptr<OpenRCT2::IStream> file;
+        std::vector<ReplayChunk> chunks;
+        size_t nextChunk = 0;        // Next chunk to look at for commands during playback.
+        uint32_t loadedTick = 0;     // Tick of the last commands chunk that was loaded.
+        uint32_t commandWatermark{}; // Commands below this index are part of the loaded keyframe.
     };
 
     class ReplayManager final : public IReplayManager
     {
-        static constexpr uint16_t ReplayVersion = 10;
+        static constexpr uint16_t ReplayVersion = 11;
+        static constexpr uint16_t LegacyReplayVersion = 10;
         static constexpr uint32_t ReplayMagic = 0x5243524F; // ORCR.
         static constexpr int ReplayCompressionLevel = 9;
+        // Keyframes are written while the game is running, trade some size for a shorter stall.
+        static constexpr int ReplayKeyframeCompressionLevel = 6;
+        static constexpr uint32_t ReplayChunkHeaderSize = 21;
+        static constexpr uint32_t CommandsChunkTicks = 40 * 30;
+        static constexpr uint32_t KeyframeTicks = 40 * 60 * 2;
         static constexpr int NormalRecordingChecksumTicks = 1;
         static constexpr int SilentRecordingChecksumTicks = 40; // Same as network server
 
@@ -146,11 +190,13 @@ namespace OpenRCT2
             auto ga = GameActions::Clone(action);
 
             _currentRecording->commands.emplace(gCurrentTicks, std::move(ga), _commandId++);
+            _currentRecording->numCommands++;
         }
 
         void AddChecksum(uint32_t tick, EntitiesChecksum&& checksum)
         {
             _currentRecording->checksums.emplace_back(std::make_pair(tick, std::move(checksum)));
+            _currentRecording->numChecksums++;
         }
 
         // Function runs each Tick.
@@ -174,9 +220,11 @@ namespace OpenRCT2
                     StopRecording();
                     return;
                 }
+                UpdateRecordingChunks();
             }
             else if (_mode == ReplayMode::PLAYING)
             {
+                LoadCommandChunks(*_currentReplay);
 #ifndef DISABLE_NETWORK
                 // If the network is disabled we will only get a dummy hash which will cause
                 // false positives during replay.
@@ -193,10 +241,12 @@ namespace OpenRCT2
             }
             else if (_mode == ReplayMode::NORMALISATION)
             {
+                UpdateRecordingChunks();
+                LoadCommandChunks(*_currentReplay);
                 ReplayCommands();
 
                 // If we run out of commands we can just stop
-                if (_currentReplay->commands.empty())
+                if (_currentReplay->commands.empty() && !HasCommandChunks(*_currentReplay))
                 {
                     StopPlayback();
                     StopRecording();
@@ -242,31 +292,46 @@ namespace OpenRCT2
                 replayData->tickEnd = k_MaxReplayTicks;
 
             replayData->filePath = name;
-
-            auto context = GetContext();
-            auto& objManager = context->GetObjectManager();
-            auto objects = objManager.GetPackableObjects();
-
-            auto exporter = std::make_unique<ParkFileExporter>();
-            exporter->ExportObjectsList = objects;
-            exporter->Export(replayData->parkData);
-
             replayData->timeRecorded = std::chrono::seconds(std::time(nullptr)).count();
 
-            DataSerialiser parkParamsDs(true, replayData->parkParams);
-            SerialiseParkParameters(parkParamsDs);
+            // The file is written while recording, starting with the info and the first keyframe.
+            try
+            {
+                replayData->file = std::make_unique<FileStream>(replayData->filePath, FILE_MODE_WRITE);
 
-            DataSerialiser cheatDataDs(true, replayData->cheatData);
-            SerialiseCheats(cheatDataDs);
+                DataSerialiser fileSerialiser(true, *replayData->file);
+                fileSerialiser << replayData->magic;
+                fileSerialiser << replayData->version;
+            }
+            catch (const std::exception& e)
+            {
+                log_error("Unable to write to file '%s': %s", replayData->filePath.c_str(), e.what());
+                return false;
+            }
+
+            MemoryStream info;
+            DataSerialiser infoDs(true, info);
+            SerialiseInfo(infoDs, *replayData);
 
             TakeGameStateSnapshot(replayData->gameStateSnapshots);
 
+            if (!WriteChunk(*replayData, ReplayChunkType::Info, gCurrentTicks, info)
+                || !WriteKeyframeChunk(*replayData)
+                || !WriteChunk(*replayData, ReplayChunkType::Snapshot, gCurrentTicks, replayData->gameStateSnapshots))
+            {
+                replayData->file.reset();
+                File::Delete(replayData->filePath);
+                return false;
+            }
+
             if (_mode != ReplayMode::NORMALISATION)
                 _mode = ReplayMode::RECORDING;
 
             _currentRecording = std::move(replayData);
             _recordType = rt;
             _nextChecksumTick = gCurrentTicks + 1;
+            _nextCommandsChunkTick = gCurrentTicks + CommandsChunkTicks;
+            _nextKeyframeTick = gCurrentTicks + KeyframeTicks;
 
             return true;
         }
@@ -278,6 +343,8 @@ namespace OpenRCT2
 
             if (discard)
             {
+                _currentRecording->file.reset();
+                File::Delete(_currentRecording->filePath);
                 _currentRecording.reset();
                 _mode = ReplayMode::NONE;
                 return true;
@@ -290,50 +357,15 @@ namespace OpenRCT2
                 AddChecksum(gCurrentTicks, std::move(checksum));
             }
 
-            TakeGameStateSnapshot(_currentRecording->gameStateSnapshots);
+            MemoryStream snapshot;
+            TakeGameStateSnapshot(snapshot);
 
-            // Serialise Body.
-            DataSerialiser recSerialiser(true);
-            Serialise(recSerialiser, *_currentRecording);
-
-            const auto& stream = recSerialiser.GetStream();
-            unsigned long streamLength = static_cast<unsigned long>(stream.GetLength());
-            unsigned long compressLength = compressBound(streamLength);
-
-            MemoryStream data(compressLength);
-
-            ReplayRecordFile file{ _currentRecording->magic, _currentRecording->version, streamLength, data };
-
-            auto compressBuf = std::make_unique<unsigned char[]>(compressLength);
-            compress2(
-                compressBuf.get(), &compressLength, static_cast<const unsigned char*>(stream.GetData()), stream.GetLength(),
-                ReplayCompressionLevel);
-            file.data.Write(compressBuf.get(), compressLength);
-
-            DataSerialiser fileSerialiser(true);
-            fileSerialiser << file.magic;
-            fileSerialiser << file.version;
-            fileSerialiser << file.uncompressedSize;
-            fileSerialiser << file.data;
-
-            bool result = false;
-
-            const std::string& outFile = _currentRecording->filePath;
-
-            FILE* fp = fopen(outFile.c_str(), "wb");
-            if (fp != nullptr)
-            {
-                const auto& fileStream = fileSerialiser.GetStream();
-                fwrite(fileStream.GetData(), 1, fileStream.GetLength(), fp);
-                fclose(fp);
-
-                result = true;
-            }
-            else
-            {
-                log_error("Unable to write to file '%s'", outFile.c_str());
-                result = false;
-            }
+            // The end chunk marks the recording as complete, replays without one are still playable up to the last
+            // commands chunk.
+            bool result = WriteCommandsChunk(*_currentRecording)
+                && WriteChunk(*_currentRecording, ReplayChunkType::Snapshot, gCurrentTicks, snapshot)
+                && WriteChunk(*_currentRecording, ReplayChunkType::End, gCurrentTicks, MemoryStream());
+            _currentRecording->file.reset();
 
             // When normalizing the output we don't touch the mode.
             if (_mode != ReplayMode::NORMALISATION)
@@ -369,8 +401,8 @@ namespace OpenRCT2
                 info.Ticks = gCurrentTicks - data->tickStart;
             else if (_mode == ReplayMode::PLAYING)
                 info.Ticks = data->tickEnd - data->tickStart;
-            info.NumCommands = static_cast<uint32_t>(data->commands.size());
-            info.NumChecksums = static_cast<uint32_t>(data->checksums.size());
+            info.NumCommands = data->numCommands;
+            info.NumChecksums = data->numChecksums;
 
             return true;
         }
@@ -427,7 +459,10 @@ namespace OpenRCT2
                 return false;
             }
 
-            if (!LoadReplayDataMap(*replayData))
+            bool mapLoaded = replayData->file != nullptr
+                ? LoadKeyframe(*replayData, FindKeyframe(*replayData, replayData->tickStart))
+                : LoadReplayDataMap(*replayData);
+            if (!mapLoaded)
             {
                 log_error("Unable to load map.");
                 return false;
@@ -435,11 +470,16 @@ namespace OpenRCT2
 
             gCurrentTicks = replayData->tickStart;
 
-            LoadAndCompareSnapshot(replayData->gameStateSnapshots);
+            if (replayData->file == nullptr
+                || ReadChunk(*replayData, ReplayChunkType::Snapshot, gCurrentTicks, replayData->gameStateSnapshots))
+            {
+                LoadAndCompareSnapshot(replayData->gameStateSnapshots);
+            }
 
             _currentReplay = std::move(replayData);
             _currentReplay->checksumIndex = 0;
             _faultyChecksumIndex = -1;
+            _numComparedChecksums = 0;
 
             // Make sure game is not paused.
             gGamePaused = 0;
@@ -455,12 +495,27 @@ namespace OpenRCT2
             return _faultyChecksumIndex != -1;
         }
 
+        virtual uint32_t GetNumComparedChecksums() const override
+        {
+            return _numComparedChecksums;
+        }
+
         virtual bool StopPlayback() override
         {
             if (_mode != ReplayMode::PLAYING && _mode != ReplayMode::NORMALISATION)
                 return false;
 
-            LoadAndCompareSnapshot(_currentReplay->gameStateSnapshots);
+            if (_currentReplay->file == nullptr)
+            {
+                LoadAndCompareSnapshot(_currentReplay->gameStateSnapshots);
+            }
+            else
+            {
+                // Only compare the final snapshot if playback actually got there.
+                MemoryStream snapshot;
+                if (ReadChunk(*_currentReplay, ReplayChunkType::Snapshot, gCurrentTicks, snapshot))
+                    LoadAndCompareSnapshot(snapshot);
+            }
 
             // During normal playback we pause the game if stopped.
             if (_mode == ReplayMode::PLAYING)
@@ -480,6 +535,76 @@ namespace OpenRCT2
             return true;
         }
 
+        virtual bool SeekPlayback(uint32_t replayTick) override
+        {
+            if (_mode != ReplayMode::PLAYING)
+                return false;
+
+            auto& replay = *_currentReplay;
+            uint32_t targetTick = replay.tickStart + std::min(replayTick, replay.tickEnd - replay.tickStart);
+
+            if (replay.file != nullptr)
+            {
+                // Restore the nearest keyframe unless the current position is already closer to the target.
+                size_t keyframe = FindKeyframe(replay, targetTick);
+                if (keyframe < replay.chunks.size()
+                    && (targetTick < gCurrentTicks || replay.chunks[keyframe].tick > gCurrentTicks))
+                {
+                    if (!LoadKeyframe(replay, keyframe))
+                    {
+                        log_error("Unable to load keyframe at tick %u.", replay.chunks[keyframe].tick);
+                        StopPlayback();
+                        return false;
+                    }
+                }
+            }
+            else if (targetTick < gCurrentTicks)
+            {
+                log_error("Replay version %u has no keyframes and can not seek backwards.", replay.version);
+                return false;
+            }
+
+            auto* gameState = GetContext()->GetGameState();
+            while (_mode == ReplayMode::PLAYING && gCurrentTicks < targetTick)
+            {
+                gameState->UpdateLogic();
+            }
+
+            return true;
+        }
+
+        virtual bool ReadReplayActions(
+            const std::string& file, std::vector<std::pair<uint32_t, std::unique_ptr<GameAction>>>& actions) override
+        {
+            ReplayRecordData data;
+            if (!ReadReplayData(file, data))
+                return false;
+
+            if (data.file != nullptr)
+            {
+                for (const auto& chunk : data.chunks)
+                {
+                    if (chunk.type != ReplayChunkType::Commands)
+                        continue;
+
+                    MemoryStream payload;
+                    if (!ReadChunk(data, chunk, payload))
+                        return false;
+
+                    DataSerialiser ds(false, payload);
+                    SerialiseCommandsChunk(ds, data);
+                }
+            }
+
+            actions.clear();
+            for (auto it = data.commands.begin(); it != data.commands.end();)
+            {
+                auto node = data.commands.extract(it++);
+                actions.emplace_back(node.value().tick - data.tickStart, std::move(node.value().action));
+            }
+            return true;
+        }
+
         virtual bool NormaliseReplay(const std::string& file, const std::string& outFile) override
         {
             _mode = ReplayMode::NORMALISATION;
@@ -518,6 +643,7 @@ namespace OpenRCT2
             try
             {
                 data.parkData.SetPosition(0);
+                data.parkParams.SetPosition(0);
 
                 auto context = GetContext();
                 auto& objManager = context->GetObjectManager();
@@ -545,22 +671,294 @@ namespace OpenRCT2
             return true;
         }
 
-        bool ReadReplayFromFile(const std::string& file, MemoryStream& stream)
+        bool WriteChunk(
+            ReplayRecordData& data, ReplayChunkType type, uint32_t tick, const MemoryStream& payload, uint32_t numCommands = 0,
+            uint32_t numChecksums = 0, int compressionLevel = ReplayCompressionLevel)
         {
-            FILE* fp = fopen(file.c_str(), "rb");
-            if (fp == nullptr)
+            unsigned long payloadLength = static_cast<unsigned long>(payload.GetLength());
+            unsigned long compressLength = compressBound(payloadLength);
+
+            auto compressBuf = std::make_unique<unsigned char[]>(compressLength);
+            compress2(
+                compressBuf.get(), &compressLength, static_cast<const unsigned char*>(payload.GetData()), payloadLength,
+                compressionLevel);
+
+            ReplayChunk chunk;
+            chunk.type = type;
+            chunk.tick = tick;
+            chunk.numCommands = numCommands;
+            chunk.numChecksums = numChecksums;
+            chunk.uncompressedSize = payloadLength;
+            chunk.compressedSize = compressLength;
+
+            try
+            {
+                DataSerialiser ds(true, *data.file);
+                SerialiseChunkHeader(ds, chunk);
+                data.file->Write(compressBuf.get(), compressLength);
+            }
+            catch (const std::exception& e)
+            {
+                log_error("Unable to write to file '%s': %s", data.filePath.c_str(), e.what());
+                return false;
+            }
+            return true;
+        }
+
+        bool WriteKeyframeChunk(ReplayRecordData& data)
+        {
+            MemoryStream parkData;
+            MemoryStream parkParams;
+            MemoryStream cheatData;
+
+            auto& objManager = GetContext()->GetObjectManager();
+            auto exporter = std::make_unique<ParkFileExporter>();
+            exporter->ExportObjectsList = objManager.GetPackableObjects();
+            exporter->Export(parkData);
+
+            DataSerialiser parkParamsDs(true, parkParams);
+            SerialiseParkParameters(parkParamsDs);
+
+            DataSerialiser cheatDataDs(true, cheatData);
+            SerialiseCheats(cheatDataDs);
+
+            // Every command recorded from here on has an index of at least _commandId, earlier ones are already part of the
+            // park even if they were executed on this very tick.
+            MemoryStream keyframe;
+            DataSerialiser keyframeDs(true, keyframe);
+            keyframeDs << _commandId;
+            keyframeDs << parkData;
+            keyframeDs << parkParams;
+            keyframeDs << cheatData;
+
+            return WriteChunk(
+                data, ReplayChunkType::Keyframe, gCurrentTicks, keyframe, 0, 0, ReplayKeyframeCompressionLevel);
+        }
+
+        bool WriteCommandsChunk(ReplayRecordData& data)
+        {
+            MemoryStream payload;
+            DataSerialiser ds(true, payload);
+            uint32_t numCommands = static_cast<uint32_t>(data.commands.size());
+            uint32_t numChecksums = static_cast<uint32_t>(data.checksums.size());
+            SerialiseCommandsChunk(ds, data);
+
+            data.commands.clear();
+            data.checksums.clear();
+
+            return WriteChunk(data, ReplayChunkType::Commands, gCurrentTicks, payload, numCommands, numChecksums);
+        }
+
+        void UpdateRecordingChunks()
+        {
+            auto& data = *_currentRecording;
+
+            // Exporting the park stalls the game, silent recordings only run in the background to be attached to crash
+            // reports, they keep the initial keyframe and are never seeked.
+            bool written = true;
+            if (_recordType == RecordType::NORMAL && gCurrentTicks >= _nextKeyframeTick)
+            {
+                // Commands before a keyframe must be in earlier chunks so seeking never has to look back.
+                written = WriteCommandsChunk(data) && WriteKeyframeChunk(data);
+                _nextCommandsChunkTick = gCurrentTicks + CommandsChunkTicks;
+                _nextKeyframeTick = gCurrentTicks + KeyframeTicks;
+            }
+            else if (gCurrentTicks >= _nextCommandsChunkTick)
+            {
+                written = WriteCommandsChunk(data);
+                _nextCommandsChunkTick = gCurrentTicks + CommandsChunkTicks;
+            }
+
+            if (!written)
+            {
+                log_error("Replay recording '%s' discarded.", data.filePath.c_str());
+                StopRecording(true);
+            }
+        }
+
+        bool ReadChunk(const ReplayRecordData& data, const ReplayChunk& chunk, MemoryStream& payload)
+        {
+            try
+            {
+                auto compressBuf = std::make_unique<unsigned char[]>(chunk.compressedSize);
+                data.file->SetPosition(chunk.offset);
+                data.file->Read(compressBuf.get(), chunk.compressedSize);
+
+                auto buff = std::make_unique<unsigned char[]>(chunk.uncompressedSize);
+                unsigned long outSize = chunk.uncompressedSize;
+                uncompress(buff.get(), &outSize, compressBuf.get(), chunk.compressedSize);
+                if (outSize != chunk.uncompressedSize)
+                {
+                    log_error("Unable to decompress replay chunk.");
+                    return false;
+                }
+
+                payload = MemoryStream();
+                payload.Write(buff.get(), outSize);
+                payload.SetPosition(0);
+            }
+            catch (const std::exception& e)
+            {
+                log_error("Unable to read replay chunk: %s", e.what());
+                return false;
+            }
+            return true;
+        }
+
+        bool ReadChunk(const ReplayRecordData& data, ReplayChunkType type, uint32_t tick, MemoryStream& payload)
+        {
+            auto it = std::find_if(data.chunks.begin(), data.chunks.end(), [type, tick](const ReplayChunk& chunk) {
+                return chunk.type == type && chunk.tick == tick;
+            });
+            if (it == data.chunks.end())
+                return false;
+
+            return ReadChunk(data, *it, payload);
+        }
+
+        // Returns the index of the last keyframe at or before the tick, or the number of chunks if there is none.
+        size_t FindKeyframe(const ReplayRecordData& data, uint32_t tick) const
+        {
+            size_t result = data.chunks.size();
+            for (size_t i = 0; i < data.chunks.size(); i++)
+            {
+                const auto& chunk = data.chunks[i];
+                if (chunk.type == ReplayChunkType::Keyframe && chunk.tick <= tick)
+                    result = i;
+            }
+            return result;
+        }
+
+        bool LoadKeyframe(ReplayRecordData& data, size_t chunkIndex)
+        {
+            if (chunkIndex >= data.chunks.size())
+                return false;
+
+            const auto& chunk = data.chunks[chunkIndex];
+
+            MemoryStream payload;
+            if (!ReadChunk(data, chunk, payload))
+                return false;
+
+            DataSerialiser ds(false, payload);
+            ds << data.commandWatermark;
+
+            data.parkData = MemoryStream();
+            data.parkParams = MemoryStream();
+            data.cheatData = MemoryStream();
+            ds << data.parkData;
+            ds << data.parkParams;
+            ds << data.cheatData;
+
+            if (!LoadReplayDataMap(data))
                 return false;
 
-            char buffer[128];
-            while (feof(fp) == 0)
+            gCurrentTicks = chunk.tick;
+
+            data.commands.clear();
+            data.checksums.clear();
+            data.nextChunk = chunkIndex + 1;
+            data.loadedTick = chunk.tick;
+
+            return true;
+        }
+
+        bool HasCommandChunks(const ReplayRecordData& data) const
+        {
+            return std::any_of(data.chunks.begin() + data.nextChunk, data.chunks.end(), [](const ReplayChunk& chunk) {
+                return chunk.type == ReplayChunkType::Commands;
+            });
+        }
+
+        void LoadCommandChunks(ReplayRecordData& data)
+        {
+            if (data.file == nullptr)
+                return;
+
+            // Commands of the tick a chunk was written on can also be in the next chunk, so playback always keeps the
+            // chunk after the current tick loaded. Normalisation ignores ticks and only needs more once it ran out.
+            while (data.nextChunk < data.chunks.size())
             {
-                size_t numBytesRead = fread(buffer, 1, 128, fp);
-                if (numBytesRead == 0)
+                if (_mode == ReplayMode::NORMALISATION ? !data.commands.empty() : data.loadedTick > gCurrentTicks)
                     break;
-                stream.Write(buffer, numBytesRead);
+
+                const auto& chunk = data.chunks[data.nextChunk++];
+                if (chunk.type != ReplayChunkType::Commands)
+                    continue;
+
+                MemoryStream payload;
+                if (!ReadChunk(data, chunk, payload))
+                    continue;
+
+                ReplayRecordData chunkData;
+                DataSerialiser ds(false, payload);
+                SerialiseCommandsChunk(ds, chunkData);
+
+                for (auto it = chunkData.commands.begin(); it != chunkData.commands.end();)
+                {
+                    auto node = chunkData.commands.extract(it++);
+                    if (node.value().commandIndex >= data.commandWatermark)
+                        data.commands.insert(std::move(node));
+                }
+                for (auto& checksum : chunkData.checksums)
+                {
+                    if (checksum.first >= gCurrentTicks)
+                        data.checksums.push_back(std::move(checksum));
+                }
+                data.loadedTick = chunk.tick;
+            }
+        }
+
+        bool ReadChunkIndex(ReplayRecordData& data)
+        {
+            auto& file = *data.file;
+            uint64_t fileLength = file.GetLength();
+            while (file.GetPosition() + ReplayChunkHeaderSize <= fileLength)
+            {
+                ReplayChunk chunk;
+                DataSerialiser ds(false, file);
+                SerialiseChunkHeader(ds, chunk);
+                chunk.offset = file.GetPosition();
+                if (chunk.offset + chunk.compressedSize > fileLength)
+                {
+                    log_warning("Replay '%s' is truncated, playing up to the last complete chunk.", data.filePath.c_str());
+                    break;
+                }
+                file.SetPosition(chunk.offset + chunk.compressedSize);
+                data.chunks.push_back(chunk);
+            }
+
+            if (data.chunks.empty() || data.chunks.front().type != ReplayChunkType::Info)
+            {
+                log_error("Replay '%s' has no info chunk.", data.filePath.c_str());
+                return false;
+            }
+
+            MemoryStream info;
+            if (!ReadChunk(data, data.chunks.front(), info))
+                return false;
+
+            DataSerialiser infoDs(false, info);
+            SerialiseInfo(infoDs, data);
+
+            // Recordings that never finished end with their last commands chunk.
+            bool hasEnd = false;
+            uint32_t lastTick = data.tickStart;
+            for (const auto& chunk : data.chunks)
+            {
+                data.numCommands += chunk.numCommands;
+                data.numChecksums += chunk.numChecksums;
+                if (chunk.type == ReplayChunkType::Commands)
+                    lastTick = std::max(lastTick, chunk.tick);
+                else if (chunk.type == ReplayChunkType::End)
+                {
+                    hasEnd = true;
+                    data.tickEnd = chunk.tick;
+                }
             }
+            if (!hasEnd)
+                data.tickEnd = lastTick;
 
-            fclose(fp);
             return true;
         }
 
@@ -598,32 +996,15 @@ namespace OpenRCT2
             return true;
         }
 
-        bool ReadReplayData(const std::string& file, ReplayRecordData& data)
+        bool ReadLegacyReplayData(IStream& file, ReplayRecordData& data)
         {
             MemoryStream stream;
 
-            std::string fileName = file;
-            if (fileName.size() < 5 || fileName.substr(fileName.size() - 5) != ".parkrep")
-            {
-                fileName += ".parkrep";
-            }
-
-            std::string outPath = GetContext()->GetPlatformEnvironment()->GetDirectoryPath(DIRBASE::USER, DIRID::REPLAY);
-            std::string outFile = Path::Combine(outPath, fileName);
-
-            bool loaded = false;
-            if (ReadReplayFromFile(outFile, stream))
-            {
-                data.filePath = outFile;
-                loaded = true;
-            }
-            else if (ReadReplayFromFile(file, stream))
-            {
-                data.filePath = file;
-                loaded = true;
-            }
-            if (!loaded)
-                return false;
+            file.SetPosition(0);
+            auto length = file.GetLength();
+            auto buffer = std::make_unique<uint8_t[]>(length);
+            file.Read(buffer.get(), length);
+            stream.Write(buffer.get(), length);
 
             if (!TryDecompress(stream))
                 return false;
@@ -641,9 +1022,62 @@ namespace OpenRCT2
             data.cheatData.SetPosition(0);
             data.gameStateSnapshots.SetPosition(0);
 
+            data.numCommands = static_cast<uint32_t>(data.commands.size());
+            data.numChecksums = static_cast<uint32_t>(data.checksums.size());
+
             return true;
         }
 
+        bool ReadReplayData(const std::string& file, ReplayRecordData& data)
+        {
+            std::string fileName = file;
+            if (fileName.size() < 5 || fileName.substr(fileName.size() - 5) != ".parkrep")
+            {
+                fileName += ".parkrep";
+            }
+
+            std::string outPath = GetContext()->GetPlatformEnvironment()->GetDirectoryPath(DIRBASE::USER, DIRID::REPLAY);
+            std::string outFile = Path::Combine(outPath, fileName);
+
+            if (File::Exists(outFile))
+                data.filePath = outFile;
+            else if (File::Exists(file))
+                data.filePath = file;
+            else
+                return false;
+
+            try
+            {
+                auto stream = std::make_unique<FileStream>(data.filePath, FILE_MODE_OPEN);
+
+                DataSerialiser fileSerialiser(false, *stream);
+                fileSerialiser << data.magic;
+                if (data.magic != ReplayMagic)
+                {
+                    log_error("Magic does not match %08X, expected: %08X", data.magic, ReplayMagic);
+                    return false;
+                }
+                fileSerialiser << data.version;
+                if (data.version == LegacyReplayVersion)
+                {
+                    return ReadLegacyReplayData(*stream, data);
+                }
+                if (data.version != ReplayVersion)
+                {
+                    log_error("Invalid version detected %04X, expected: %04X", data.version, ReplayVersion);
+                    return false;
+                }
+
+                data.file = std::move(stream);
+                return ReadChunkIndex(data);
+            }
+            catch (const std::exception& e)
+            {
+                log_error("Unable to read replay '%s': %s", data.filePath.c_str(), e.what());
+                return false;
+            }
+        }
+
         bool SerialiseCheats(DataSerialiser& serialiser)
         {
             CheatsSerialise(serialiser);
@@ -702,30 +1136,24 @@ namespace OpenRCT2
             return true;
         }
 
-        bool Compatible(ReplayRecordData& data)
+        bool SerialiseChunkHeader(DataSerialiser& serialiser, ReplayChunk& chunk)
         {
-            return data.version == ReplayVersion;
+            serialiser << chunk.type;
+            serialiser << chunk.tick;
+            serialiser << chunk.numCommands;
+            serialiser << chunk.numChecksums;
+            serialiser << chunk.uncompressedSize;
+            serialiser << chunk.compressedSize;
+
+            return true;
         }
 
-        bool Serialise(DataSerialiser& serialiser, ReplayRecordData& data)
+        bool SerialiseInfo(DataSerialiser& serialiser, ReplayRecordData& data)
         {
-            serialiser << data.magic;
-            if (data.magic != ReplayMagic)
-            {
-                log_error("Magic does not match %08X, expected: %08X", data.magic, ReplayMagic);
-                return false;
-            }
-            serialiser << data.version;
-            if (data.version != ReplayVersion && !Compatible(data))
-            {
-                log_error("Invalid version detected %04X, expected: %04X", data.version, ReplayVersion);
-                return false;
-            }
-
             serialiser << data.networkId;
 #ifndef DISABLE_NETWORK
             // NOTE: This does not mean the replay will not function, only a warning.
-            if (data.networkId != network_get_version())
+            if (serialiser.IsLoading() && data.networkId != network_get_version())
             {
                 log_warning(
                     "Replay network version mismatch: '%s', expected: '%s'", data.networkId.c_str(),
@@ -735,12 +1163,14 @@ namespace OpenRCT2
 
             serialiser << data.name;
             serialiser << data.timeRecorded;
-            serialiser << data.parkData;
-            serialiser << data.parkParams;
-            serialiser << data.cheatData;
             serialiser << data.tickStart;
             serialiser << data.tickEnd;
 
+            return true;
+        }
+
+        bool SerialiseCommandsChunk(DataSerialiser& serialiser, ReplayRecordData& data)
+        {
             uint32_t countCommands = static_cast<uint32_t>(data.commands.size());
             serialiser << countCommands;
 
@@ -776,6 +1206,46 @@ namespace OpenRCT2
                 serialiser << data.checksums[i].second.raw;
             }
 
+            return true;
+        }
+
+        // Reads replays up to version 10 which were written in one piece when the recording stopped.
+        bool Serialise(DataSerialiser& serialiser, ReplayRecordData& data)
+        {
+            serialiser << data.magic;
+            if (data.magic != ReplayMagic)
+            {
+                log_error("Magic does not match %08X, expected: %08X", data.magic, ReplayMagic);
+                return false;
+            }
+            serialiser << data.version;
+            if (data.version != LegacyReplayVersion)
+            {
+                log_error("Invalid version detected %04X, expected: %04X", data.version, LegacyReplayVersion);
+                return false;
+            }
+
+            serialiser << data.networkId;
+#ifndef DISABLE_NETWORK
+            // NOTE: This does not mean the replay will not function, only a warning.
+            if (data.networkId != network_get_version())
+            {
+                log_warning(
+                    "Replay network version mismatch: '%s', expected: '%s'", data.networkId.c_str(),
+                    network_get_version().c_str());
+            }
+#endif
+
+            serialiser << data.name;
+            serialiser << data.timeRecorded;
+            serialiser << data.parkData;
+            serialiser << data.parkParams;
+            serialiser << data.cheatData;
+            serialiser << data.tickStart;
+            serialiser << data.tickEnd;
+
+            SerialiseCommandsChunk(serialiser, data);
+
             serialiser << data.gameStateSnapshots;
             return true;
         }
@@ -783,15 +1253,22 @@ namespace OpenRCT2
 #ifndef DISABLE_NETWORK
         void CheckState()
         {
-            uint32_t checksumIndex = _currentReplay->checksumIndex;
+            auto& checksums = _currentReplay->checksums;
 
-            if (checksumIndex >= _currentReplay->checksums.size())
+            // Checksums of ticks that were skipped by seeking can no longer be verified.
+            while (!checksums.empty() && checksums.front().first < gCurrentTicks)
+                checksums.pop_front();
+
+            if (checksums.empty())
                 return;
 
-            const auto& savedChecksum = _currentReplay->checksums[checksumIndex];
-            if (_currentReplay->checksums[checksumIndex].first == gCurrentTicks)
+            uint32_t checksumIndex = _currentReplay->checksumIndex;
+            const auto savedChecksum = checksums.front();
+            if (savedChecksum.first == gCurrentTicks)
             {
                 _currentReplay->checksumIndex++;
+                _numComparedChecksums++;
+                checksums.pop_front();
 
                 EntitiesChecksum checksum = GetAllEntitiesChecksum();
                 if (savedChecksum.second.raw != checksum.raw)
@@ -867,8 +1344,11 @@ namespace OpenRCT2
         std::unique_ptr<ReplayRecordData> _currentRecording;
         std::unique_ptr<ReplayRecordData> _currentReplay;
         int32_t _faultyChecksumIndex = -1;
+        uint32_t _numComparedChecksums = 0;
         uint32_t _commandId = 0;
         uint32_t _nextChecksumTick = 0;
+        uint32_t _nextCommandsChunkTick = 0;
+        uint32_t _nextKeyframeTick = 0;
         uint32_t _nextReplayTick = 0;
         RecordType _recordType = RecordType::NORMAL;
     };
@@ -14,6 +14,8 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
 class GameAction;
 
@@ -60,9 +62,17 @@ namespace OpenRCT2
 
         virtual bool StartPlayback(const std::string& file) = 0;
         virtual bool IsPlaybackStateMismatching() const = 0;
+        // Number of stored checksums the current or last playback compared against the game state so far.
+        virtual uint32_t GetNumComparedChecksums() const = 0;
         virtual bool StopPlayback() = 0;
+        // Moves playback to the given number of ticks after the start of the replay.
+        virtual bool SeekPlayback(uint32_t replayTick) = 0;
 
         virtual bool NormaliseReplay(const std::string& inputFile, const std::string& outputFile) = 0;
+        // Reads the game actions of a replay without loading its park, ticks are relative to the start of the replay.
+        virtual bool ReadReplayActions(
+            const std::string& file, std::vector<std::pair<uint32_t, std::unique_ptr<GameAction>>>& actions)
+            = 0;
     };
 
     [[nodiscard]] std::unique_ptr<IReplayManager> CreateReplayManager();
@@ -0,0 +1,154 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2022 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "BatchAction.h"
+
+#include "../localisation/StringIds.h"
+#include "../management/Finance.h"
+
+#include <algorithm>
+
+void BatchAction::AddAction(GameAction::Ptr&& action)
+{
+    _actions.push_back(std::move(action));
+}
+
+const std::vector<GameAction::Ptr>& BatchAction::GetActions() const
+{
+    return _actions;
+}
+
+uint16_t BatchAction::GetActionFlags() const
+{
+    uint16_t flags = GameAction::GetActionFlags();
+    for (const auto& action : _actions)
+    {
+        // Only allowed while paused if every action is, editor only if any action is.
+        auto actionFlags = action->GetActionFlags();
+        if (!(actionFlags & GameActions::Flags::AllowWhilePaused))
+            flags &= ~GameActions::Flags::AllowWhilePaused;
+        flags |= actionFlags & GameActions::Flags::EditorOnly;
+    }
+    return flags;
+}
+
+void BatchAction::Serialise(DataSerialiser& stream)
+{
+    GameAction::Serialise(stream);
+
+    auto count = static_cast<uint16_t>(_actions.size());
+    stream << DS_TAG(count);
+
+    if (stream.IsLoading())
+    {
+        _actions.clear();
+        if (count > MaxActions)
+        {
+            _valid = false;
+            return;
+        }
+    }
+
+    for (uint16_t i = 0; i < count; i++)
+    {
+        uint32_t actionType = 0;
+        if (stream.IsSaving())
+        {
+            actionType = EnumValue(_actions[i]->GetType());
+        }
+        stream << DS_TAG(actionType);
+
+        if (stream.IsLoading())
+        {
+            // Without knowing the action the rest of the stream can not be read, batches can not be nested.
+            if (!GameActions::IsValidId(actionType) || actionType == EnumValue(GameCommand::Batch))
+            {
+                _valid = false;
+                return;
+            }
+            _actions.push_back(GameActions::Create(static_cast<GameCommand>(actionType)));
+        }
+
+        _actions[i]->Serialise(stream);
+    }
+}
+
+bool BatchAction::IsValid() const
+{
+    if (!_valid || _actions.empty() || _actions.size() > MaxActions)
+        return false;
+
+    return std::none_of(_actions.begin(), _actions.end(), [](const GameAction::Ptr& action) {
+        return action == nullptr || action->GetType() == GameCommand::Batch;
+    });
+}
+
+void BatchAction::PrepareAction(GameAction& action) const
+{
+    // Actions inside the batch are run on behalf of whoever ran the batch.
+    action.SetPlayer(GetPlayer());
+    action.SetFlags(action.GetFlags() | GetFlags());
+}
+
+GameActions::Result BatchAction::Query() const
+{
+    if (!IsValid())
+    {
+        return GameActions::Result(GameActions::Status::InvalidParameters, STR_CANT_DO_THIS, STR_NONE);
+    }
+
+    // The batch is only run if every action in it would succeed on its own.
+    auto result = GameActions::Result();
+    for (const auto& action : _actions)
+    {
+        PrepareAction(*action);
+
+        auto actionResult = GameActions::QueryNested(action.get());
+        if (actionResult.Error != GameActions::Status::Ok)
+        {
+            return actionResult;
+        }
+
+        if (result.Position.IsNull())
+            result.Position = actionResult.Position;
+        result.Cost += actionResult.Cost;
+    }
+    return result;
+}
+
+GameActions::Result BatchAction::Execute() const
+{
+    // Earlier actions in the batch may still make later ones fail, e.g. when they overlap. Those are skipped and the
+    // batch carries on, so once its query passed the batch always succeeds and is relayed, recorded and replayed
+    // exactly as it ran. The outcome of every action is part of the result.
+    // Every action is paid for under its own expenditure type, the result of the batch only carries the total cost and
+    // no expenditure type so it is not paid for again.
+    auto result = GameActions::Result();
+    BatchActionResult batchResult;
+    batchResult.Outcomes.reserve(_actions.size());
+    const bool payActions = finance_check_money_required(GetFlags());
+    for (const auto& action : _actions)
+    {
+        PrepareAction(*action);
+
+        auto actionResult = GameActions::ExecuteNested(action.get());
+        batchResult.Outcomes.push_back(actionResult.Error);
+        if (actionResult.Error != GameActions::Status::Ok)
+            continue;
+
+        if (payActions && actionResult.Cost != 0)
+            finance_payment(actionResult.Cost, actionResult.Expenditure);
+
+        if (result.Position.IsNull())
+            result.Position = actionResult.Position;
+        result.Cost += actionResult.Cost;
+    }
+    result.SetData(std::move(batchResult));
+    return result;
+}
@@ -0,0 +1,50 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2022 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "GameAction.h"
+
+#include <vector>
+
+struct BatchActionResult
+{
+    // Status of every action in the batch, in order. Actions that failed when the batch was executed were skipped.
+    std::vector<GameActions::Status> Outcomes;
+};
+
+/**
+ * Runs a list of game actions as one, e.g. for tools editing a large area. The batch is sent, queued and recorded
+ * once, the actions inside it are still queried, executed and paid for one by one as nested actions.
+ */
+class BatchAction final : public GameActionBase<GameCommand::Batch>
+{
+public:
+    static constexpr uint16_t MaxActions = 4096;
+
+private:
+    std::vector<GameAction::Ptr> _actions;
+    bool _valid = true;
+
+public:
+    BatchAction() = default;
+
+    void AddAction(GameAction::Ptr&& action);
+    const std::vector<GameAction::Ptr>& GetActions() const;
+
+    uint16_t GetActionFlags() const override;
+
+    void Serialise(DataSerialiser& stream) override;
+    GameActions::Result Query() const override;
+    GameActions::Result Execute() const override;
+
+private:
+    bool IsValid() const;
+    void PrepareAction(GameAction& action) const;
+};
@@ -14,6 +14,7 @@
 #include "../core/Guard.hpp"
 #include "../core/Memory.hpp"
 #include "../core/MemoryStream.h"
+#include "../core/TickQueue.hpp"
 #include "../entity/MoneyEffect.h"
 #include "../localisation/Formatter.h"
 #include "../localisation/Localisation.h"
@@ -42,27 +43,18 @@ namespace GameActions
         uint32_t uniqueId;
         GameAction::Ptr action;
 
+        QueuedGameAction() = default;
+
         explicit QueuedGameAction(uint32_t t, std::unique_ptr<GameAction>&& ga, uint32_t id)
             : tick(t)
             , uniqueId(id)
             , action(std::move(ga))
         {
         }
-
-        bool operator<(const QueuedGameAction& comp) const
-        {
-            // First sort by tick
-            if (tick < comp.tick)
-                return true;
-            if (tick > comp.tick)
-                return false;
-
-            // If the ticks are equal sort by commandIndex
-            return uniqueId < comp.uniqueId;
-        }
     };
 
-    static std::multiset<QueuedGameAction> _actionQueue;
+    // Ordered by tick, actions of the same tick stay in the order of their uniqueId.
+    static TickQueue<QueuedGameAction> _actionQueue;
     static uint32_t _nextUniqueId = 0;
     static bool _suspended = false;
 
@@ -90,7 +82,7 @@ namespace GameActions
             // as that normally happens when receiving them over network.
             ga->SetPlayer(network_get_current_player_id());
         }
-        _actionQueue.emplace(tick, std::move(ga), _nextUniqueId++);
+        _actionQueue.push(tick, QueuedGameAction(tick, std::move(ga), _nextUniqueId++));
     }
 
     void ProcessQueue()
@@ -103,14 +95,13 @@ namespace GameActions
 
         const uint32_t currentTick = gCurrentTicks;
 
-        while (_actionQueue.begin() != _actionQueue.end())
+        while (!_actionQueue.empty())
         {
             // run all the game commands at the current tick
-            const QueuedGameAction& queued = *_actionQueue.begin();
-
             if (network_get_mode() == NETWORK_MODE_CLIENT)
             {
-                if (queued.tick < currentTick)
+                const QueuedGameAction& front = _actionQueue.front();
+                if (front.tick < currentTick)
                 {
                     // This should never happen.
                     Guard::Assert(
@@ -118,14 +109,17 @@ namespace GameActions
                         "Discarding game action %s (%u) from tick behind current tick, ID: %08X, Action Tick: %08X, Current "
                         "Tick: "
                         "%08X\n",
-                        queued.action->GetName(), queued.action->GetType(), queued.uniqueId, queued.tick, currentTick);
+                        front.action->GetName(), front.action->GetType(), front.uniqueId, front.tick, currentTick);
                 }
-                else if (queued.tick > currentTick)
+                else if (front.tick > currentTick)
                 {
                     return;
                 }
             }
 
+            // Take the action out first, executing it may queue further actions.
+            const QueuedGameAction queued = _actionQueue.pop();
+
             // Remove ghost scenery so it doesn't interfere with incoming network command
             switch (queued.action->GetType())
             {
@@ -150,8 +144,6 @@ namespace GameActions
                 // Relay this action to all other clients.
                 network_send_game_action(action);
             }
-
-            _actionQueue.erase(_actionQueue.begin());
         }
     }
 
@@ -368,10 +360,11 @@ namespace GameActions
             if (!topLevel)
                 return result;
 
-            // Update money balance
+            // Update money balance, results without an expenditure type were already paid for by the action itself.
             if (result.Error == GameActions::Status::Ok && finance_check_money_required(flags) && result.Cost != 0)
             {
-                finance_payment(result.Cost, result.Expenditure);
+                if (result.Expenditure != ExpenditureType::Count)
+                    finance_payment(result.Cost, result.Expenditure);
                 MoneyEffect::Create(result.Cost, result.Position);
             }
 
@@ -13,6 +13,7 @@
 #include "BannerSetColourAction.h"
 #include "BannerSetNameAction.h"
 #include "BannerSetStyleAction.h"
+#include "BatchAction.h"
 #include "ChangeMapSizeAction.h"
 #include "ClearAction.h"
 #include "ClimateSetAction.h"
@@ -206,6 +207,7 @@ namespace GameActions
         REGISTER_ACTION(ParkSetDateAction);
         REGISTER_ACTION(SetCheatAction);
         REGISTER_ACTION(ChangeMapSizeAction);
+        REGISTER_ACTION(BatchAction);
 #ifdef ENABLE_SCRIPTING
         REGISTER_ACTION(CustomAction);
 #endif
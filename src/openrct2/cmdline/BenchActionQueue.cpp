@@ -0,0 +1,146 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2022 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "CommandLine.hpp"
+
+#ifdef USE_BENCHMARK
+
+#    include "../core/TickQueue.hpp"
+
+#    include <benchmark/benchmark.h>
+#    include <memory>
+#    include <set>
+#    include <vector>
+
+// Actions are queued up to this many ticks ahead, like a client receiving them from the server.
+constexpr uint32_t BenchQueueTickSpread = 4;
+
+struct BenchQueuedAction
+{
+    uint32_t tick{};
+    uint32_t uniqueId{};
+    std::unique_ptr<uint64_t> action;
+
+    bool operator<(const BenchQueuedAction& comp) const
+    {
+        if (tick != comp.tick)
+            return tick < comp.tick;
+        return uniqueId < comp.uniqueId;
+    }
+};
+
+// The previous implementation of the game action queue
+static void BM_multiset(benchmark::State& state)
+{
+    const auto actionsPerTick = static_cast<uint32_t>(state.range(0));
+    std::multiset<BenchQueuedAction> queue;
+    uint32_t currentTick = 0;
+    uint32_t uniqueId = 0;
+
+    for (auto _ : state)
+    {
+        for (uint32_t i = 0; i < actionsPerTick; i++)
+        {
+            uint32_t tick = currentTick + (i % BenchQueueTickSpread);
+            queue.insert(BenchQueuedAction{ tick, uniqueId++, std::make_unique<uint64_t>(i) });
+        }
+        while (!queue.empty() && queue.begin()->tick <= currentTick)
+        {
+            benchmark::DoNotOptimize(*queue.begin()->action);
+            queue.erase(queue.begin());
+        }
+        currentTick++;
+    }
+    state.SetItemsProcessed(state.iterations() * actionsPerTick);
+}
+
+static void BM_tick_queue(benchmark::State& state)
+{
+    const auto actionsPerTick = static_cast<uint32_t>(state.range(0));
+    TickQueue<BenchQueuedAction> queue;
+    uint32_t currentTick = 0;
+    uint32_t uniqueId = 0;
+
+    for (auto _ : state)
+    {
+        for (uint32_t i = 0; i < actionsPerTick; i++)
+        {
+            uint32_t tick = currentTick + (i % BenchQueueTickSpread);
+            queue.push(tick, BenchQueuedAction{ tick, uniqueId++, std::make_unique<uint64_t>(i) });
+        }
+        while (!queue.empty() && queue.front().tick <= currentTick)
+        {
+            auto queued = queue.pop();
+            benchmark::DoNotOptimize(*queued.action);
+        }
+        currentTick++;
+    }
+    state.SetItemsProcessed(state.iterations() * actionsPerTick);
+}
+
+static int CmdlineForBenchActionQueue(int argc, const char* const* argv)
+{
+    benchmark::RegisterBenchmark("actionqueue/multiset", BM_multiset)->RangeMultiplier(8)->Range(8, 4096);
+    benchmark::RegisterBenchmark("actionqueue/tickqueue", BM_tick_queue)->RangeMultiplier(8)->Range(8, 4096);
+
+    // Google benchmark does stuff to argv. It doesn't modify the pointees,
+    // but it wants to reorder the pointers, so present a copy of them.
+    std::vector<char*> argv_for_benchmark;
+
+    // argv[0] is expected to contain the binary name. It's only for logging purposes, don't bother.
+    argv_for_benchmark.push_back(nullptr);
+    for (int i = 0; i < argc; i++)
+    {
+        argv_for_benchmark.push_back(const_cast<char*>(argv[i]));
+    }
+
+    // Update argc with all the changes made
+    argc = static_cast<int>(argv_for_benchmark.size());
+    ::benchmark::Initialize(&argc, &argv_for_benchmark[0]);
+    if (::benchmark::ReportUnrecognizedArguments(argc, &argv_for_benchmark[0]))
+        return -1;
+
+    ::benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
+
+static exitcode_t HandleBenchActionQueue(CommandLineArgEnumerator* argEnumerator)
+{
+    const char* const* argv = static_cast<const char* const*>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    int32_t result = CmdlineForBenchActionQueue(argc, argv);
+    if (result < 0)
+    {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+#else
+static exitcode_t HandleBenchActionQueue(CommandLineArgEnumerator* argEnumerator)
+{
+    log_error("Sorry, Google benchmark not enabled in this build");
+    return EXITCODE_FAIL;
+}
+#endif // USE_BENCHMARK
+
+const CommandLineCommand CommandLine::BenchActionQueueCommands[]{
+#ifdef USE_BENCHMARK
+    DefineCommand(
+        "",
+        "[--benchmark_list_tests={true|false}] [--benchmark_filter=<regex>] [--benchmark_min_time=<min_time>] "
+        "[--benchmark_repetitions=<num_repetitions>] [--benchmark_report_aggregates_only={true|false}] "
+        "[--benchmark_format=<console|json|csv>] [--benchmark_out=<filename>] [--benchmark_out_format=<json|console|csv>] "
+        "[--benchmark_color={auto|true|false}] [--benchmark_counters_tabular={true|false}] [--v=<verbosity>]",
+        nullptr, HandleBenchActionQueue),
+    CommandTableEnd
+#else
+    DefineCommand("", "*** SORRY NOT ENABLED IN THIS BUILD ***", nullptr, HandleBenchActionQueue), CommandTableEnd
+#endif // USE_BENCHMARK
+};
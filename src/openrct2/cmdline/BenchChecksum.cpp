@@ -0,0 +1,211 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2022 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "CommandLine.hpp"
+
+#ifdef USE_BENCHMARK
+
+#    include "../Context.h"
+#    include "../GameState.h"
+#    include "../OpenRCT2.h"
+#    include "../core/DataSerialiser.h"
+#    include "../core/File.h"
+#    include "../core/MemoryStream.h"
+#    include "../entity/EntityList.h"
+#    include "../entity/EntityRegistry.h"
+#    include "../entity/Guest.h"
+#    include "../entity/Litter.h"
+#    include "../entity/Staff.h"
+#    include "../platform/Platform.h"
+#    include "../ride/Vehicle.h"
+
+#    include <benchmark/benchmark.h>
+#    include <vector>
+
+using namespace OpenRCT2;
+
+template<typename T> static void SerialiseEntities(DataSerialiser& ds)
+{
+    for (auto* entity : EntityList<T>())
+    {
+        entity->Serialise(ds);
+    }
+}
+
+static size_t CountChecksummedEntities()
+{
+    return GetEntityListCount(EntityType::Guest) + GetEntityListCount(EntityType::Staff)
+        + GetEntityListCount(EntityType::Vehicle) + GetEntityListCount(EntityType::Litter);
+}
+
+static std::unique_ptr<IContext> CreateBenchmarkContext(benchmark::State& state, const std::string& filename)
+{
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        state.SkipWithError("Context initialization failed.");
+        return nullptr;
+    }
+    if (!filename.empty() && !context->LoadParkFromFile(filename))
+    {
+        state.SkipWithError("Failed to load file!");
+        return nullptr;
+    }
+    return context;
+}
+
+// The checksum computed by the server and clients on every checksum tick
+static void BM_checksum(benchmark::State& state, const std::string& filename)
+{
+    auto context = CreateBenchmarkContext(state, filename);
+    if (context == nullptr)
+        return;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(GetAllEntitiesChecksum());
+    }
+    state.SetItemsProcessed(state.iterations() * CountChecksummedEntities());
+}
+
+// The rolling checksum after a game tick, only the entities the tick changed are serialised again
+static void BM_rolling_checksum(benchmark::State& state, const std::string& filename)
+{
+    auto context = CreateBenchmarkContext(state, filename);
+    if (context == nullptr)
+        return;
+
+    GetRollingEntitiesChecksum();
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        context->GetGameState()->UpdateLogic();
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(GetRollingEntitiesChecksum());
+    }
+    state.SetItemsProcessed(state.iterations() * CountChecksummedEntities());
+}
+
+// The rolling checksum when nothing changed since the last call, e.g. while the game is paused
+static void BM_rolling_checksum_unchanged(benchmark::State& state, const std::string& filename)
+{
+    auto context = CreateBenchmarkContext(state, filename);
+    if (context == nullptr)
+        return;
+
+    GetRollingEntitiesChecksum();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(GetRollingEntitiesChecksum());
+    }
+    state.SetItemsProcessed(state.iterations() * CountChecksummedEntities());
+}
+
+// The same entity serialisation into a memory stream, as used for network and snapshot data
+static void BM_serialise(benchmark::State& state, const std::string& filename)
+{
+    auto context = CreateBenchmarkContext(state, filename);
+    if (context == nullptr)
+        return;
+
+    MemoryStream ms;
+    for (auto _ : state)
+    {
+        ms.SetPosition(0);
+        DataSerialiser ds(true, ms);
+        SerialiseEntities<Guest>(ds);
+        SerialiseEntities<Staff>(ds);
+        SerialiseEntities<Vehicle>(ds);
+        SerialiseEntities<Litter>(ds);
+        benchmark::DoNotOptimize(ms.GetData());
+    }
+    state.SetItemsProcessed(state.iterations() * CountChecksummedEntities());
+    state.SetBytesProcessed(state.iterations() * ms.GetLength());
+}
+
+static int CmdlineForBenchChecksum(int argc, const char* const* argv)
+{
+    // Add a baseline test on an empty park
+    benchmark::RegisterBenchmark("checksum/baseline", BM_checksum, std::string{});
+    benchmark::RegisterBenchmark("rolling_checksum/baseline", BM_rolling_checksum, std::string{});
+    benchmark::RegisterBenchmark("rolling_checksum_unchanged/baseline", BM_rolling_checksum_unchanged, std::string{});
+    benchmark::RegisterBenchmark("serialise/baseline", BM_serialise, std::string{});
+
+    // Google benchmark does stuff to argv. It doesn't modify the pointees,
+    // but it wants to reorder the pointers, so present a copy of them.
+    std::vector<char*> argv_for_benchmark;
+
+    // argv[0] is expected to contain the binary name. It's only for logging purposes, don't bother.
+    argv_for_benchmark.push_back(nullptr);
+
+    // Extract file names from argument list. If there is no such file, consider it benchmark option.
+    for (int i = 0; i < argc; i++)
+    {
+        if (File::Exists(argv[i]))
+        {
+            benchmark::RegisterBenchmark((std::string("checksum/") + argv[i]).c_str(), BM_checksum, argv[i]);
+            benchmark::RegisterBenchmark(
+                (std::string("rolling_checksum/") + argv[i]).c_str(), BM_rolling_checksum, argv[i]);
+            benchmark::RegisterBenchmark(
+                (std::string("rolling_checksum_unchanged/") + argv[i]).c_str(), BM_rolling_checksum_unchanged, argv[i]);
+            benchmark::RegisterBenchmark((std::string("serialise/") + argv[i]).c_str(), BM_serialise, argv[i]);
+        }
+        else
+        {
+            argv_for_benchmark.push_back(const_cast<char*>(argv[i]));
+        }
+    }
+    // Update argc with all the changes made
+    argc = static_cast<int>(argv_for_benchmark.size());
+    ::benchmark::Initialize(&argc, &argv_for_benchmark[0]);
+    if (::benchmark::ReportUnrecognizedArguments(argc, &argv_for_benchmark[0]))
+        return -1;
+
+    Platform::CoreInit();
+    gOpenRCT2Headless = true;
+
+    ::benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
+
+static exitcode_t HandleBenchChecksum(CommandLineArgEnumerator* argEnumerator)
+{
+    const char* const* argv = static_cast<const char* const*>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    int32_t result = CmdlineForBenchChecksum(argc, argv);
+    if (result < 0)
+    {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+#else
+static exitcode_t HandleBenchChecksum(CommandLineArgEnumerator* argEnumerator)
+{
+    log_error("Sorry, Google benchmark not enabled in this build");
+    return EXITCODE_FAIL;
+}
+#endif // USE_BENCHMARK
+
+const CommandLineCommand CommandLine::BenchChecksumCommands[]{
+#ifdef USE_BENCHMARK
+    DefineCommand(
+        "",
+        "<file>... [--benchmark_list_tests={true|false}] [--benchmark_filter=<regex>] [--benchmark_min_time=<min_time>] "
+        "[--benchmark_repetitions=<num_repetitions>] [--benchmark_report_aggregates_only={true|false}] "
+        "[--benchmark_format=<console|json|csv>] [--benchmark_out=<filename>] [--benchmark_out_format=<json|console|csv>] "
+        "[--benchmark_color={auto|true|false}] [--benchmark_counters_tabular={true|false}] [--v=<verbosity>]",
+        nullptr, HandleBenchChecksum),
+    CommandTableEnd
+#else
+    DefineCommand("", "*** SORRY NOT ENABLED IN THIS BUILD ***", nullptr, HandleBenchChecksum), CommandTableEnd
+#endif // USE_BENCHMARK
+};
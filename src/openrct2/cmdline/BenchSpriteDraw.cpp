@@ -0,0 +1,222 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2022 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "CommandLine.hpp"
+
+#ifdef USE_BENCHMARK
+
+#    include "../drawing/Drawing.h"
+#    include "../interface/Colour.h"
+#    include "../util/Util.h"
+
+#    include <benchmark/benchmark.h>
+#    include <random>
+#    include <string>
+#    include <vector>
+
+constexpr int32_t BenchSpriteSize = 64;
+constexpr int32_t BenchTargetSize = 128;
+
+struct BenchRunBlitters
+{
+    const char* Name;
+    decltype(blit_run_transparent_fn) Transparent;
+    decltype(blit_run_remap_fn) Remap;
+    decltype(blit_run_remap_dst_fn) RemapDst;
+};
+
+struct BenchBlendOp
+{
+    const char* Name;
+    ImageId Image;
+    bool Transparency;
+};
+
+struct BenchSprite
+{
+    std::vector<uint8_t> Data;
+    rct_g1_element Element;
+};
+
+// A sprite of the given format, roughly one in eight pixels is transparent.
+static BenchSprite CreateSprite(bool rle)
+{
+    std::mt19937 random(0);
+    BenchSprite sprite;
+    sprite.Element.width = BenchSpriteSize;
+    sprite.Element.height = BenchSpriteSize;
+    if (!rle)
+    {
+        sprite.Data.resize(BenchSpriteSize * BenchSpriteSize);
+        for (auto& pixel : sprite.Data)
+        {
+            pixel = (random() % 8) == 0 ? 0 : static_cast<uint8_t>(1 + random() % 255);
+        }
+    }
+    else
+    {
+        // Each line has three runs of 16 pixels separated by gaps of 4.
+        sprite.Element.flags = G1_FLAG_RLE_COMPRESSION;
+        sprite.Data.resize(BenchSpriteSize * 2);
+        for (int32_t y = 0; y < BenchSpriteSize; y++)
+        {
+            auto lineOffset = sprite.Data.size();
+            sprite.Data[y * 2] = static_cast<uint8_t>(lineOffset & 0xFF);
+            sprite.Data[y * 2 + 1] = static_cast<uint8_t>(lineOffset >> 8);
+            for (int32_t run = 0; run < 3; run++)
+            {
+                sprite.Data.push_back(16 | (run == 2 ? 0x80 : 0));
+                sprite.Data.push_back(static_cast<uint8_t>(4 + run * 20));
+                for (int32_t x = 0; x < 16; x++)
+                {
+                    sprite.Data.push_back(static_cast<uint8_t>(1 + random() % 255));
+                }
+            }
+        }
+    }
+    sprite.Element.offset = sprite.Data.data();
+    return sprite;
+}
+
+static void BM_draw_sprite(
+    benchmark::State& state, const BenchRunBlitters& blitters, const BenchBlendOp& blendOp, bool rle)
+{
+    blit_run_transparent_fn = blitters.Transparent;
+    blit_run_remap_fn = blitters.Remap;
+    blit_run_remap_dst_fn = blitters.RemapDst;
+
+    auto sprite = CreateSprite(rle);
+    if (blendOp.Transparency)
+        sprite.Element.flags |= G1_FLAG_HAS_TRANSPARENCY;
+
+    // Enough maps to blend any source colour.
+    std::mt19937 random(1);
+    std::vector<uint8_t> paletteData(255 * 256);
+    for (auto& colour : paletteData)
+    {
+        colour = (random() % 16) == 0 ? 0 : static_cast<uint8_t>(random());
+    }
+    PaletteMap paletteMap(paletteData.data(), 255, 256);
+
+    std::vector<uint8_t> bits(BenchTargetSize * BenchTargetSize);
+    rct_drawpixelinfo dpi;
+    dpi.bits = bits.data();
+    dpi.width = BenchTargetSize;
+    dpi.height = BenchTargetSize;
+
+    auto* destinationBits = bits.data() + BenchTargetSize + 1;
+    DrawSpriteArgs args(
+        blendOp.Image, paletteMap, sprite.Element, 0, 0, BenchSpriteSize, BenchSpriteSize, destinationBits);
+    for (auto _ : state)
+    {
+        if (rle)
+            gfx_rle_sprite_to_buffer(dpi, args);
+        else
+            gfx_bmp_sprite_to_buffer(dpi, args);
+        benchmark::DoNotOptimize(bits.data());
+    }
+    state.SetItemsProcessed(state.iterations() * BenchSpriteSize * BenchSpriteSize);
+}
+
+static int CmdlineForBenchSpriteDraw(int argc, const char* const* argv)
+{
+    std::vector<BenchRunBlitters> blitters = {
+        { "scalar", blit_run_transparent_scalar, blit_run_remap_scalar, blit_run_remap_dst_scalar },
+    };
+    if (sse41_available())
+    {
+        blitters.push_back({ "sse4_1", blit_run_transparent_sse4_1, blit_run_remap_sse4_1, blit_run_remap_dst_sse4_1 });
+    }
+    if (avx2_available())
+    {
+        blitters.push_back({ "avx2", blit_run_transparent_avx2, blit_run_remap_avx2, blit_run_remap_dst_avx2 });
+    }
+
+    // One entry for every blend op gfx_bmp_sprite_to_buffer and gfx_rle_sprite_to_buffer pick from the image.
+    const BenchBlendOp blendOps[] = {
+        { "none", ImageId(0), false },
+        { "transparent", ImageId(0), true },
+        { "src", ImageId(0, COLOUR_BRIGHT_RED), true },
+        { "dst", ImageId(0).WithBlended(true), true },
+        { "src_dst", ImageId(0, COLOUR_BRIGHT_RED).WithBlended(true), true },
+    };
+
+    for (const auto& blitter : blitters)
+    {
+        for (const auto& blendOp : blendOps)
+        {
+            benchmark::RegisterBenchmark(
+                (std::string("bmp/") + blendOp.Name + "/" + blitter.Name).c_str(), BM_draw_sprite, blitter, blendOp, false);
+
+            // RLE sprites always encode their transparency.
+            if (blendOp.Transparency)
+            {
+                benchmark::RegisterBenchmark(
+                    (std::string("rle/") + blendOp.Name + "/" + blitter.Name).c_str(), BM_draw_sprite, blitter, blendOp,
+                    true);
+            }
+        }
+    }
+
+    // Google benchmark does stuff to argv. It doesn't modify the pointees,
+    // but it wants to reorder the pointers, so present a copy of them.
+    std::vector<char*> argv_for_benchmark;
+
+    // argv[0] is expected to contain the binary name. It's only for logging purposes, don't bother.
+    argv_for_benchmark.push_back(nullptr);
+    for (int i = 0; i < argc; i++)
+    {
+        argv_for_benchmark.push_back(const_cast<char*>(argv[i]));
+    }
+
+    // Update argc with all the changes made
+    argc = static_cast<int>(argv_for_benchmark.size());
+    ::benchmark::Initialize(&argc, &argv_for_benchmark[0]);
+    if (::benchmark::ReportUnrecognizedArguments(argc, &argv_for_benchmark[0]))
+        return -1;
+
+    ::benchmark::RunSpecifiedBenchmarks();
+    blit_run_init();
+    return 0;
+}
+
+static exitcode_t HandleBenchSpriteDraw(CommandLineArgEnumerator* argEnumerator)
+{
+    const char* const* argv = static_cast<const char* const*>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    int32_t result = CmdlineForBenchSpriteDraw(argc, argv);
+    if (result < 0)
+    {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+#else
+static exitcode_t HandleBenchSpriteDraw(CommandLineArgEnumerator* argEnumerator)
+{
+    log_error("Sorry, Google benchmark not enabled in this build");
+    return EXITCODE_FAIL;
+}
+#endif // USE_BENCHMARK
+
+const CommandLineCommand CommandLine::BenchSpriteDrawCommands[]{
+#ifdef USE_BENCHMARK
+    DefineCommand(
+        "",
+        "[--benchmark_list_tests={true|false}] [--benchmark_filter=<regex>] [--benchmark_min_time=<min_time>] "
+        "[--benchmark_repetitions=<num_repetitions>] [--benchmark_report_aggregates_only={true|false}] "
+        "[--benchmark_format=<console|json|csv>] [--benchmark_out=<filename>] [--benchmark_out_format=<json|console|csv>] "
+        "[--benchmark_color={auto|true|false}] [--benchmark_counters_tabular={true|false}] [--v=<verbosity>]",
+        nullptr, HandleBenchSpriteDraw),
+    CommandTableEnd
+#else
+    DefineCommand("", "*** SORRY NOT ENABLED IN THIS BUILD ***", nullptr, HandleBenchSpriteDraw), CommandTableEnd
+#endif // USE_BENCHMARK
+};
@@ -33,41 +33,282 @@
 #    include <benchmark/benchmark.h>
 #    include <cstdint>
 #    include <iterator>
+#    include <string>
 #    include <vector>
 
+static PaintStruct* entry_from_offset(RecordedPaintSession& s, PaintStruct* offset)
+{
+    if (offset == reinterpret_cast<PaintStruct*>(-1))
+        return nullptr;
+
+    // Don't use AsBasic(), it would reset the struct.
+    auto index = reinterpret_cast<size_t>(offset) / sizeof(PaintEntry);
+    return reinterpret_cast<PaintStruct*>(&s.Entries[index]);
+}
+
 static void fixup_pointers(std::vector<RecordedPaintSession>& s)
 {
     for (size_t i = 0; i < s.size(); i++)
     {
-        auto& entries = s[i].Entries;
-        auto& quadrants = s[i].Session.Quadrants;
-        for (size_t j = 0; j < entries.size(); j++)
+        // Only the paint structs in the quadrant lists have their next pointer recorded.
+        for (auto& quadrant : s[i].Session.Quadrants)
         {
-            if (entries[j].AsBasic()->next_quadrant_ps == reinterpret_cast<PaintStruct*>(-1))
+            quadrant = entry_from_offset(s[i], quadrant);
+            for (auto* ps = quadrant; ps != nullptr; ps = ps->next_quadrant_ps)
             {
-                entries[j].AsBasic()->next_quadrant_ps = nullptr;
+                ps->next_quadrant_ps = entry_from_offset(s[i], ps->next_quadrant_ps);
             }
-            else
+        }
+    }
+}
+
+// The previous implementation of PaintSessionArrange, which sorts the linked quadrant lists in place. It is kept to
+// compare the performance and draw order of the current one against.
+template<uint8_t>
+static bool CheckBoundingBox(const PaintStructBoundBox& initialBBox, const PaintStructBoundBox& currentBBox)
+{
+    return false;
+}
+
+template<> bool CheckBoundingBox<0>(const PaintStructBoundBox& initialBBox, const PaintStructBoundBox& currentBBox)
+{
+    if (initialBBox.z_end >= currentBBox.z && initialBBox.y_end >= currentBBox.y && initialBBox.x_end >= currentBBox.x
+        && !(initialBBox.z < currentBBox.z_end && initialBBox.y < currentBBox.y_end && initialBBox.x < currentBBox.x_end))
+    {
+        return true;
+    }
+    return false;
+}
+
+template<> bool CheckBoundingBox<1>(const PaintStructBoundBox& initialBBox, const PaintStructBoundBox& currentBBox)
+{
+    if (initialBBox.z_end >= currentBBox.z && initialBBox.y_end >= currentBBox.y && initialBBox.x_end < currentBBox.x
+        && !(initialBBox.z < currentBBox.z_end && initialBBox.y < currentBBox.y_end && initialBBox.x >= currentBBox.x_end))
+    {
+        return true;
+    }
+    return false;
+}
+
+template<> bool CheckBoundingBox<2>(const PaintStructBoundBox& initialBBox, const PaintStructBoundBox& currentBBox)
+{
+    if (initialBBox.z_end >= currentBBox.z && initialBBox.y_end < currentBBox.y && initialBBox.x_end < currentBBox.x
+        && !(initialBBox.z < currentBBox.z_end && initialBBox.y >= currentBBox.y_end && initialBBox.x >= currentBBox.x_end))
+    {
+        return true;
+    }
+    return false;
+}
+
+template<> bool CheckBoundingBox<3>(const PaintStructBoundBox& initialBBox, const PaintStructBoundBox& currentBBox)
+{
+    if (initialBBox.z_end >= currentBBox.z && initialBBox.y_end < currentBBox.y && initialBBox.x_end >= currentBBox.x
+        && !(initialBBox.z < currentBBox.z_end && initialBBox.y >= currentBBox.y_end && initialBBox.x < currentBBox.x_end))
+    {
+        return true;
+    }
+    return false;
+}
+
+namespace LinkedListSortFlags
+{
+    static constexpr uint8_t None = 0;
+    static constexpr uint8_t PendingVisit = (1U << 0);
+    static constexpr uint8_t Neighbour = (1U << 1);
+    static constexpr uint8_t OutsideQuadrant = (1U << 7);
+} // namespace LinkedListSortFlags
+
+template<uint8_t TRotation>
+static PaintStruct* LinkedListArrangeHelper(PaintStruct* ps_next, uint16_t quadrantIndex, uint8_t flag)
+{
+    PaintStruct* ps;
+    PaintStruct* ps_temp;
+
+    // Get the first node in the specified quadrant.
+    do
+    {
+        ps = ps_next;
+        ps_next = ps_next->next_quadrant_ps;
+        if (ps_next == nullptr)
+            return ps;
+    } while (quadrantIndex > ps_next->quadrant_index);
+
+    // We keep track of the first node in the quadrant so the next call with a higher quadrant index
+    // can use this node to skip some iterations.
+    PaintStruct* psQuadrantEntry = ps;
+
+    // Visit all nodes in the linked quadrant list and determine their current
+    // sorting relevancy.
+    ps_temp = ps;
+    do
+    {
+        ps = ps->next_quadrant_ps;
+        if (ps == nullptr)
+            break;
+
+        if (ps->quadrant_index > quadrantIndex + 1)
+        {
+            // Outside of the range.
+            ps->SortFlags = LinkedListSortFlags::OutsideQuadrant;
+        }
+        else if (ps->quadrant_index == quadrantIndex + 1)
+        {
+            // Is neighbour and requires a visit.
+            ps->SortFlags = LinkedListSortFlags::Neighbour | LinkedListSortFlags::PendingVisit;
+        }
+        else if (ps->quadrant_index == quadrantIndex)
+        {
+            // In specified quadrant, requires visit.
+            ps->SortFlags = flag | LinkedListSortFlags::PendingVisit;
+        }
+    } while (ps->quadrant_index <= quadrantIndex + 1);
+    ps = ps_temp;
+
+    // Iterate all nodes in the current list and re-order them based on
+    // the current rotation and their bounding box.
+    while (true)
+    {
+        // Get the first pending node in the quadrant list
+        while (true)
+        {
+            ps_next = ps->next_quadrant_ps;
+            if (ps_next == nullptr)
+            {
+                // End of the current list.
+                return psQuadrantEntry;
+            }
+            if (ps_next->SortFlags & LinkedListSortFlags::OutsideQuadrant)
             {
-                auto nextQuadrantPs = reinterpret_cast<size_t>(entries[j].AsBasic()->next_quadrant_ps) / sizeof(PaintEntry);
-                entries[j].AsBasic()->next_quadrant_ps = s[i].Entries[nextQuadrantPs].AsBasic();
+                // Reached point outside of specified quadrant.
+                return psQuadrantEntry;
             }
+            if (ps_next->SortFlags & LinkedListSortFlags::PendingVisit)
+            {
+                // Found node to check on.
+                break;
+            }
+            ps = ps_next;
         }
-        for (size_t j = 0; j < std::size(quadrants); j++)
+
+        // Mark visited.
+        ps_next->SortFlags &= ~LinkedListSortFlags::PendingVisit;
+        ps_temp = ps;
+
+        // Compare current node against the remaining children.
+        const PaintStructBoundBox& initialBBox = ps_next->bounds;
+        while (true)
         {
-            if (quadrants[j] == reinterpret_cast<PaintStruct*>(-1))
+            ps = ps_next;
+            ps_next = ps_next->next_quadrant_ps;
+            if (ps_next == nullptr)
+                break;
+            if (ps_next->SortFlags & LinkedListSortFlags::OutsideQuadrant)
+                break;
+            if (!(ps_next->SortFlags & LinkedListSortFlags::Neighbour))
+                continue;
+
+            const PaintStructBoundBox& currentBBox = ps_next->bounds;
+
+            const bool compareResult = CheckBoundingBox<TRotation>(initialBBox, currentBBox);
+
+            if (compareResult)
             {
-                quadrants[j] = nullptr;
+                // Child node intersects with current node, move behind.
+                ps->next_quadrant_ps = ps_next->next_quadrant_ps;
+                PaintStruct* ps_temp2 = ps_temp->next_quadrant_ps;
+                ps_temp->next_quadrant_ps = ps_next;
+                ps_next->next_quadrant_ps = ps_temp2;
+                ps_next = ps;
             }
-            else
+        }
+
+        ps = ps_temp;
+    }
+}
+
+template<int TRotation> static void LinkedListArrange(PaintSessionCore& session)
+{
+    PaintStruct* psHead = &session.PaintHead;
+
+    PaintStruct* ps = psHead;
+    ps->next_quadrant_ps = nullptr;
+
+    uint32_t quadrantIndex = session.QuadrantBackIndex;
+    if (quadrantIndex != UINT32_MAX)
+    {
+        do
+        {
+            PaintStruct* ps_next = session.Quadrants[quadrantIndex];
+            if (ps_next != nullptr)
             {
-                auto ps = reinterpret_cast<size_t>(quadrants[j]) / sizeof(PaintEntry);
-                quadrants[j] = entries[ps].AsBasic();
+                ps->next_quadrant_ps = ps_next;
+                do
+                {
+                    ps = ps_next;
+                    ps_next = ps_next->next_quadrant_ps;
+
+                } while (ps_next != nullptr);
             }
+        } while (++quadrantIndex <= session.QuadrantFrontIndex);
+
+        PaintStruct* ps_cache = LinkedListArrangeHelper<TRotation>(
+            psHead, session.QuadrantBackIndex & 0xFFFF, LinkedListSortFlags::Neighbour);
+
+        quadrantIndex = session.QuadrantBackIndex;
+        while (++quadrantIndex < session.QuadrantFrontIndex)
+        {
+            ps_cache = LinkedListArrangeHelper<TRotation>(ps_cache, quadrantIndex & 0xFFFF, LinkedListSortFlags::None);
         }
     }
 }
 
+static void linked_list_arrange(PaintSessionCore& session)
+{
+    switch (session.CurrentRotation)
+    {
+        case 0:
+            return LinkedListArrange<0>(session);
+        case 1:
+            return LinkedListArrange<1>(session);
+        case 2:
+            return LinkedListArrange<2>(session);
+        case 3:
+            return LinkedListArrange<3>(session);
+    }
+}
+
+static std::vector<size_t> get_draw_order(const RecordedPaintSession& s)
+{
+    std::vector<size_t> order;
+    for (auto* ps = s.Session.PaintHead.next_quadrant_ps; ps != nullptr; ps = ps->next_quadrant_ps)
+    {
+        order.push_back(reinterpret_cast<const PaintEntry*>(ps) - s.Entries.data());
+    }
+    return order;
+}
+
+// Checks that both implementations put every recorded session into the same draw order.
+static bool verify_paint_session_arrange(const std::vector<RecordedPaintSession>& inputSessions)
+{
+    auto linkedListSessions = inputSessions;
+    auto sessions = inputSessions;
+    fixup_pointers(linkedListSessions);
+    fixup_pointers(sessions);
+
+    bool result = true;
+    for (size_t i = 0; i < sessions.size(); i++)
+    {
+        linked_list_arrange(linkedListSessions[i].Session);
+        PaintSessionArrange(sessions[i].Session);
+        if (get_draw_order(linkedListSessions[i]) != get_draw_order(sessions[i]))
+        {
+            log_error("Paint session %u is drawn in a different order than by the linked list sort.", i);
+            result = false;
+        }
+    }
+    return result;
+}
+
 static std::vector<RecordedPaintSession> extract_paint_session(std::string_view parkFileName)
 {
     Platform::CoreInit();
@@ -132,6 +373,7 @@ static std::vector<RecordedPaintSession> extract_paint_session(std::string_view
 }
 
 // This function is based on benchgfx_render_screenshots
+template<void (*TArrange)(PaintSessionCore&)>
 static void BM_paint_session_arrange(benchmark::State& state, const std::vector<RecordedPaintSession> inputSessions)
 {
     auto sessions = inputSessions;
@@ -146,7 +388,7 @@ static void BM_paint_session_arrange(benchmark::State& state, const std::vector<
         state.PauseTiming();
         std::copy_n(local_s, std::size(sessions), sessions.begin());
         state.ResumeTiming();
-        PaintSessionArrange(sessions[0].Session);
+        TArrange(sessions[0].Session);
         benchmark::DoNotOptimize(sessions);
     }
     state.SetItemsProcessed(state.iterations() * std::size(sessions));
@@ -166,7 +408,7 @@ static int cmdline_for_bench_sprite_sort(int argc, const char** argv)
         {
             quad = reinterpret_cast<PaintStruct*>(-1);
         }
-        benchmark::RegisterBenchmark("baseline", BM_paint_session_arrange, sessions);
+        benchmark::RegisterBenchmark("baseline", BM_paint_session_arrange<PaintSessionArrange>, sessions);
     }
 
     // Google benchmark does stuff to argv. It doesn't modify the pointees,
@@ -184,7 +426,15 @@ static int cmdline_for_bench_sprite_sort(int argc, const char** argv)
             // Register benchmark for sv6 if valid
             std::vector<RecordedPaintSession> sessions = extract_paint_session(argv[i]);
             if (!sessions.empty())
-                benchmark::RegisterBenchmark(argv[i], BM_paint_session_arrange, sessions);
+            {
+                if (!verify_paint_session_arrange(sessions))
+                    return -1;
+
+                benchmark::RegisterBenchmark(argv[i], BM_paint_session_arrange<PaintSessionArrange>, sessions);
+                benchmark::RegisterBenchmark(
+                    (std::string(argv[i]) + "/linked_list").c_str(), BM_paint_session_arrange<linked_list_arrange>,
+                    sessions);
+            }
         }
         else
         {
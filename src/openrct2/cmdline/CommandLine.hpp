@@ -119,7 +119,12 @@ namespace CommandLine
     extern const CommandLineCommand BenchGfxCommands[];
     extern const CommandLineCommand BenchSpriteSortCommands[];
     extern const CommandLineCommand BenchUpdateCommands[];
+    extern const CommandLineCommand BenchChecksumCommands[];
+    extern const CommandLineCommand BenchActionQueueCommands[];
+    extern const CommandLineCommand BenchSpriteDrawCommands[];
     extern const CommandLineCommand SimulateCommands[];
+    extern const CommandLineCommand LoadTestCommands[];
+    extern const CommandLineCommand VerifyReplayCommands[];
     extern const CommandLineCommand ParkInfoCommands[];
 
     extern const CommandLineExample RootExamples[];
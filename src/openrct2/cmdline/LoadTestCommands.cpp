@@ -0,0 +1,415 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2022 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "CommandLine.hpp"
+
+// Workers are separate processes started through Platform::Execute, which is not implemented on Windows.
+#if !defined(DISABLE_NETWORK) && !defined(_WIN32)
+
+#    include "../Context.h"
+#    include "../GameState.h"
+#    include "../OpenRCT2.h"
+#    include "../PlatformEnvironment.h"
+#    include "../ReplayManager.h"
+#    include "../actions/GameAction.h"
+#    include "../core/Console.hpp"
+#    include "../core/File.h"
+#    include "../core/FileSystem.hpp"
+#    include "../core/Json.hpp"
+#    include "../core/Path.hpp"
+#    include "../core/String.hpp"
+#    include "../network/NetworkBase.h"
+#    include "../network/network.h"
+#    include "../platform/Platform.h"
+
+#    include <algorithm>
+#    include <atomic>
+#    include <chrono>
+#    include <cstdlib>
+#    include <memory>
+#    include <thread>
+#    include <utility>
+#    include <vector>
+
+using namespace OpenRCT2;
+
+using Clock = std::chrono::steady_clock;
+
+// How long a synthetic client may take to download the map before it gives up.
+constexpr auto LoadTestJoinTimeout = std::chrono::seconds(60);
+constexpr uint16_t LoadTestDefaultPort = 11753;
+
+struct LoadTestClientReport
+{
+    uint32_t JoinMs{};
+    double Seconds{};
+    uint64_t BytesReceived{};
+    uint64_t BytesSent{};
+    uint32_t ActionsSent{};
+    int32_t Joined{};
+    int32_t Desynced{};
+    int32_t Disconnected{};
+};
+
+static exitcode_t HandleLoadTest(CommandLineArgEnumerator* argEnumerator);
+static exitcode_t HandleLoadTestClient(CommandLineArgEnumerator* argEnumerator);
+
+// clang-format off
+const CommandLineCommand CommandLine::LoadTestCommands[]
+{
+    // Main commands
+    DefineCommand("",       "<park> <replay> <clients> <seconds> [port]",                   nullptr, HandleLoadTest      ),
+    DefineCommand("client", "<host> <port> <replay> <seconds> <user dir> <report file>", nullptr, HandleLoadTestClient),
+    CommandTableEnd
+};
+// clang-format on
+
+using ReplayActions = std::vector<std::pair<uint32_t, GameAction::Ptr>>;
+
+/**
+ * Sends the actions of the recorded script that are due at the given tick. The script starts over once all of its
+ * actions were sent. The actions go through the regular client path, i.e. they are serialised and validated by the
+ * server.
+ */
+static uint32_t SendScriptActions(const ReplayActions& script, size_t& next, uint32_t& scriptStart, uint32_t tick)
+{
+    uint32_t sent = 0;
+    while (!script.empty() && script[next].first <= tick - scriptStart)
+    {
+        auto action = GameActions::Clone(script[next].second.get());
+        GameActions::Execute(action.get());
+        sent++;
+
+        if (++next == script.size())
+        {
+            next = 0;
+            scriptStart = tick + 1;
+            break;
+        }
+    }
+    return sent;
+}
+
+static json_t ReportToJson(const LoadTestClientReport& report)
+{
+    return json_t{
+        { "joined", report.Joined },
+        { "joinMs", report.JoinMs },
+        { "seconds", report.Seconds },
+        { "bytesReceived", report.BytesReceived },
+        { "bytesSent", report.BytesSent },
+        { "actionsSent", report.ActionsSent },
+        { "desynced", report.Desynced },
+        { "disconnected", report.Disconnected },
+    };
+}
+
+static bool ReadReport(const std::string& path, LoadTestClientReport& report)
+{
+    try
+    {
+        const auto jsonReport = Json::ReadFromFile(path);
+        if (!jsonReport.is_object())
+        {
+            return false;
+        }
+        report.Joined = Json::GetNumber<int32_t>(jsonReport["joined"]);
+        report.JoinMs = Json::GetNumber<uint32_t>(jsonReport["joinMs"]);
+        report.Seconds = Json::GetNumber<double>(jsonReport["seconds"]);
+        report.BytesReceived = Json::GetNumber<uint64_t>(jsonReport["bytesReceived"]);
+        report.BytesSent = Json::GetNumber<uint64_t>(jsonReport["bytesSent"]);
+        report.ActionsSent = Json::GetNumber<uint32_t>(jsonReport["actionsSent"]);
+        report.Desynced = Json::GetNumber<int32_t>(jsonReport["desynced"]);
+        report.Disconnected = Json::GetNumber<int32_t>(jsonReport["disconnected"]);
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        Console::Error::WriteLine("Unable to read load test report '%s': %s", path.c_str(), e.what());
+        return false;
+    }
+}
+
+static uint64_t GetTotalBytes(const uint64_t (&bytes)[EnumValue(NetworkStatisticsGroup::Max)])
+{
+    return bytes[EnumValue(NetworkStatisticsGroup::Total)];
+}
+
+static exitcode_t HandleLoadTestClient(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+
+    if (argc < 6)
+    {
+        Console::Error::WriteLine("Missing arguments <host> <port> <replay> <seconds> <user dir> <report file>.");
+        return EXITCODE_FAIL;
+    }
+
+    Platform::CoreInit();
+
+    const std::string host = argv[0];
+    const int32_t port = atoi(argv[1]);
+    const std::string replayPath = argv[2];
+    const auto duration = std::chrono::seconds(atol(argv[3]));
+    const std::string reportPath = argv[5];
+
+    // Every client has its own user directory, so the clients do not race each other on the object index and caches.
+    gCustomUserDataPath = Path::GetAbsolute(argv[4]);
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return EXITCODE_FAIL;
+    }
+
+    ReplayActions script;
+    if (!context->GetReplayManager()->ReadReplayActions(replayPath, script))
+    {
+        Console::Error::WriteLine("Unable to read the actions of replay '%s'.", replayPath.c_str());
+        return EXITCODE_FAIL;
+    }
+
+    auto& network = context->GetNetwork();
+    LoadTestClientReport report;
+
+    const auto startTime = Clock::now();
+    auto joinTime = startTime;
+    auto nextTick = startTime;
+    uint32_t ticksSinceJoin = 0;
+    uint32_t scriptStart = 0;
+    size_t nextAction = 0;
+
+    network_begin_client(host, port);
+    while (true)
+    {
+        const auto now = Clock::now();
+        if (report.Joined != 0 ? now - joinTime >= duration : now - startTime >= LoadTestJoinTimeout)
+        {
+            break;
+        }
+        if (network_get_mode() != NETWORK_MODE_CLIENT)
+        {
+            report.Disconnected = 1;
+            break;
+        }
+
+        if (now < nextTick)
+        {
+            std::this_thread::sleep_until(nextTick);
+            continue;
+        }
+        nextTick += std::chrono::milliseconds(static_cast<int32_t>(GAME_UPDATE_TIME_MS * 1000.0f));
+
+        context->GetGameState()->Tick();
+
+        if (report.Joined == 0 && network.IsClientMapLoaded())
+        {
+            report.Joined = 1;
+            joinTime = Clock::now();
+            report.JoinMs = static_cast<uint32_t>(
+                std::chrono::duration_cast<std::chrono::milliseconds>(joinTime - startTime).count());
+        }
+        if (network.IsDesynchronised())
+        {
+            report.Desynced = 1;
+        }
+        if (report.Joined != 0)
+        {
+            report.ActionsSent += SendScriptActions(script, nextAction, scriptStart, ticksSinceJoin++);
+        }
+    }
+
+    if (report.Joined != 0)
+    {
+        report.Seconds = std::chrono::duration<double>(Clock::now() - joinTime).count();
+    }
+    if (network_get_mode() == NETWORK_MODE_CLIENT)
+    {
+        const auto stats = network_get_stats();
+        report.BytesReceived = GetTotalBytes(stats.bytesReceived);
+        report.BytesSent = GetTotalBytes(stats.bytesSent);
+        network.Close();
+    }
+
+    Json::WriteToFile(reportPath, ReportToJson(report));
+    return EXITCODE_OK;
+}
+
+static exitcode_t HandleLoadTest(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+
+    if (argc < 4)
+    {
+        Console::Error::WriteLine("Missing arguments <park> <replay> <clients> <seconds>.");
+        return EXITCODE_FAIL;
+    }
+
+    Platform::CoreInit();
+
+    const char* inputPath = argv[0];
+    const auto replayPath = Path::GetAbsolute(argv[1]);
+    const uint32_t clientCount = std::max(1, atoi(argv[2]));
+    const uint32_t seconds = std::max(1, atoi(argv[3]));
+    const int32_t port = argc >= 5 ? atoi(argv[4]) : LoadTestDefaultPort;
+
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return EXITCODE_FAIL;
+    }
+    if (!context->LoadParkFromFile(inputPath))
+    {
+        return EXITCODE_FAIL;
+    }
+    if (!network_begin_server(port, "127.0.0.1"))
+    {
+        Console::Error::WriteLine("Unable to listen on port %d.", port);
+        return EXITCODE_FAIL;
+    }
+
+    // Every synthetic client is a separate headless process, the game state is global so they can not share ours.
+    // The clients get a user directory of their own with a copy of our configuration.
+    const auto executable = Platform::GetCurrentExecutablePath();
+    const auto configPath = context->GetPlatformEnvironment()->GetFilePath(PATHID::CONFIG);
+    const auto workDirectory = Path::Combine(
+        fs::temp_directory_path().u8string(), String::StdFormat("openrct2-loadtest-%d", port));
+    std::vector<std::string> reportPaths;
+    std::vector<std::thread> clients;
+    std::atomic<uint32_t> clientsFinished{};
+    for (uint32_t i = 0; i < clientCount; i++)
+    {
+        auto userDataPath = Path::Combine(workDirectory, String::StdFormat("client-%u", i));
+        Path::CreateDirectory(userDataPath);
+        File::Copy(configPath, Path::Combine(userDataPath, "config.ini"), true);
+
+        auto reportPath = Path::Combine(workDirectory, String::StdFormat("report-%u.json", i));
+        File::Delete(reportPath);
+        auto command = String::StdFormat(
+            "\"%s\" loadtest client 127.0.0.1 %d \"%s\" %u \"%s\" \"%s\"", executable.c_str(), port, replayPath.c_str(),
+            seconds, userDataPath.c_str(), reportPath.c_str());
+        reportPaths.push_back(reportPath);
+        clients.emplace_back([command, &clientsFinished]() {
+            std::string output;
+            Platform::Execute(command, &output);
+            clientsFinished++;
+        });
+    }
+
+    Console::WriteLine("Started %u clients on port %d, running for %u seconds...", clientCount, port, seconds);
+
+    // Run the server at the normal tick rate until every client has exited.
+    std::vector<double> tickTimes;
+    const auto tickInterval = std::chrono::milliseconds(static_cast<int32_t>(GAME_UPDATE_TIME_MS * 1000.0f));
+    auto nextTick = Clock::now();
+    while (clientsFinished < clientCount)
+    {
+        const auto now = Clock::now();
+        if (now < nextTick)
+        {
+            std::this_thread::sleep_until(nextTick);
+            continue;
+        }
+        nextTick += tickInterval;
+
+        context->GetGameState()->Tick();
+        tickTimes.push_back(std::chrono::duration<double, std::milli>(Clock::now() - now).count());
+    }
+    for (auto& client : clients)
+    {
+        client.join();
+    }
+
+    context->GetNetwork().Close();
+
+    Console::WriteLine("%-8s %-8s %-10s %-14s %-14s %-8s %-8s", "client", "joined", "join ms", "recv B/s", "sent B/s", "actions",
+        "desynced");
+    uint32_t joinedCount = 0;
+    uint32_t desyncCount = 0;
+    uint32_t disconnectCount = 0;
+    double joinMsTotal = 0;
+    double bytesPerSecondTotal = 0;
+    for (uint32_t i = 0; i < clientCount; i++)
+    {
+        LoadTestClientReport report;
+        if (!File::Exists(reportPaths[i]) || !ReadReport(reportPaths[i], report))
+        {
+            Console::WriteLine("%-8u no report", i);
+            disconnectCount++;
+            continue;
+        }
+
+        const double received = report.Seconds > 0 ? report.BytesReceived / report.Seconds : 0;
+        const double sent = report.Seconds > 0 ? report.BytesSent / report.Seconds : 0;
+        Console::WriteLine(
+            "%-8u %-8s %-10u %-14.0f %-14.0f %-8u %-8s", i, report.Joined != 0 ? "yes" : "no", report.JoinMs, received, sent,
+            report.ActionsSent, report.Desynced != 0 ? "yes" : "no");
+
+        if (report.Joined != 0)
+        {
+            joinedCount++;
+            joinMsTotal += report.JoinMs;
+            bytesPerSecondTotal += received + sent;
+        }
+        desyncCount += report.Desynced != 0 ? 1 : 0;
+        disconnectCount += report.Disconnected != 0 ? 1 : 0;
+    }
+
+    std::error_code ec;
+    fs::remove_all(fs::u8path(workDirectory), ec);
+
+    std::sort(tickTimes.begin(), tickTimes.end());
+    const auto tickPercentile = [&tickTimes](double percentile) {
+        return tickTimes.empty() ? 0.0 : tickTimes[static_cast<size_t>((tickTimes.size() - 1) * percentile)];
+    };
+
+    Console::WriteLine();
+    Console::WriteLine("Clients joined:        %u / %u", joinedCount, clientCount);
+    Console::WriteLine("Clients desynced:      %u", desyncCount);
+    Console::WriteLine("Clients disconnected:  %u", disconnectCount);
+    if (joinedCount > 0)
+    {
+        Console::WriteLine("Average join latency:  %.0f ms", joinMsTotal / joinedCount);
+        Console::WriteLine("Average client bytes:  %.0f B/s", bytesPerSecondTotal / joinedCount);
+    }
+    Console::WriteLine(
+        "Server tick time:      median %.3f ms, p99 %.3f ms, max %.3f ms", tickPercentile(0.5), tickPercentile(0.99),
+        tickPercentile(1.0));
+
+    return desyncCount == 0 && disconnectCount == 0 ? EXITCODE_OK : EXITCODE_FAIL;
+}
+
+#else
+
+#    include "../core/Console.hpp"
+
+static exitcode_t HandleLoadTest(CommandLineArgEnumerator* argEnumerator)
+{
+#    if defined(_WIN32)
+    Console::Error::WriteLine("Load testing is not supported on this platform.");
+#    else
+    Console::Error::WriteLine("Load testing is not available in builds without network support.");
+#    endif
+    return EXITCODE_FAIL;
+}
+
+const CommandLineCommand CommandLine::LoadTestCommands[]{
+    DefineCommand("", "*** SORRY NOT ENABLED IN THIS BUILD ***", nullptr, HandleLoadTest), CommandTableEnd
+};
+
+#endif // !defined(DISABLE_NETWORK) && !defined(_WIN32)
@@ -42,6 +42,7 @@ int32_t gNetworkStart = NETWORK_MODE_NONE;
 std::string gNetworkStartHost;
 int32_t gNetworkStartPort = NETWORK_DEFAULT_PORT;
 std::string gNetworkStartAddress;
+int32_t gNetworkStartRelayPort = 0;
 
 static uint32_t _port = 0;
 static char* _address = nullptr;
@@ -92,6 +93,7 @@ static exitcode_t HandleCommandIntro(CommandLineArgEnumerator * enumerator);
 #ifndef DISABLE_NETWORK
 static exitcode_t HandleCommandHost(CommandLineArgEnumerator * enumerator);
 static exitcode_t HandleCommandJoin(CommandLineArgEnumerator * enumerator);
+static exitcode_t HandleCommandRelay(CommandLineArgEnumerator * enumerator);
 #endif
 static exitcode_t HandleCommandSetRCT2(CommandLineArgEnumerator * enumerator);
 static exitcode_t HandleCommandScanObjects(CommandLineArgEnumerator * enumerator);
@@ -127,6 +129,7 @@ const CommandLineCommand CommandLine::RootCommands[]
 #ifndef DISABLE_NETWORK
     DefineCommand("host",     "<uri>",                  StandardOptions, HandleCommandHost   ),
     DefineCommand("join",     "<hostname>",             StandardOptions, HandleCommandJoin   ),
+    DefineCommand("relay",    "<hostname> <port>",      StandardOptions, HandleCommandRelay  ),
 #endif
     DefineCommand("set-rct2", "<path>",                 StandardOptions, HandleCommandSetRCT2),
     DefineCommand("convert",  "<source> <destination>", StandardOptions, CommandLine::HandleCommandConvert),
@@ -143,7 +146,12 @@ const CommandLineCommand CommandLine::RootCommands[]
     DefineSubCommand("benchgfx",        CommandLine::BenchGfxCommands         ),
     DefineSubCommand("benchspritesort", CommandLine::BenchSpriteSortCommands  ),
     DefineSubCommand("benchsimulate",   CommandLine::BenchUpdateCommands      ),
+    DefineSubCommand("benchchecksum",   CommandLine::BenchChecksumCommands    ),
+    DefineSubCommand("benchactionqueue", CommandLine::BenchActionQueueCommands),
+    DefineSubCommand("benchspritedraw", CommandLine::BenchSpriteDrawCommands  ),
     DefineSubCommand("simulate",        CommandLine::SimulateCommands         ),
+    DefineSubCommand("loadtest",        CommandLine::LoadTestCommands         ),
+    DefineSubCommand("verifyreplays",   CommandLine::VerifyReplayCommands     ),
     DefineSubCommand("parkinfo",        CommandLine::ParkInfoCommands         ),
     CommandTableEnd
 };
@@ -158,6 +166,7 @@ const CommandLineExample CommandLine::RootExamples[]
 #endif
 #ifndef DISABLE_NETWORK
     { "host ./my_park.sv6 --port 11753 --headless",   "run a headless server for a saved park" },
+    { "relay example.org 11754 --headless",           "relay a server to spectators"           },
 #endif
     ExampleTableEnd
 };
@@ -326,6 +335,26 @@ exitcode_t HandleCommandJoin(CommandLineArgEnumerator* enumerator)
     return EXITCODE_CONTINUE;
 }
 
+exitcode_t HandleCommandRelay(CommandLineArgEnumerator* enumerator)
+{
+    exitcode_t result = HandleCommandJoin(enumerator);
+    if (result != EXITCODE_CONTINUE)
+    {
+        return result;
+    }
+
+    int32_t relayPort;
+    if (!enumerator->TryPopInteger(&relayPort) || relayPort <= 0)
+    {
+        Console::Error::WriteLine("Expected a port to accept spectators on.");
+        return EXITCODE_FAIL;
+    }
+
+    gNetworkStartRelayPort = relayPort;
+    gNetworkStartAddress = String::ToStd(_address);
+    return EXITCODE_CONTINUE;
+}
+
 #endif // DISABLE_NETWORK
 
 static exitcode_t HandleCommandSetRCT2(CommandLineArgEnumerator* enumerator)
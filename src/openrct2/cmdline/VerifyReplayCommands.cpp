@@ -0,0 +1,449 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2022 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "CommandLine.hpp"
+
+// Workers are separate processes started through Platform::Execute, which is not implemented on Windows.
+#if !defined(DISABLE_NETWORK) && !defined(_WIN32)
+
+#    include "../Context.h"
+#    include "../Game.h"
+#    include "../GameState.h"
+#    include "../OpenRCT2.h"
+#    include "../ReplayManager.h"
+#    include "../core/Console.hpp"
+#    include "../core/File.h"
+#    include "../core/FileScanner.h"
+#    include "../core/FileSystem.hpp"
+#    include "../core/Json.hpp"
+#    include "../core/Path.hpp"
+#    include "../core/String.hpp"
+#    include "../platform/Platform.h"
+
+#    include <algorithm>
+#    include <chrono>
+#    include <cstdlib>
+#    include <memory>
+#    include <sstream>
+#    include <thread>
+#    include <vector>
+
+using namespace OpenRCT2;
+
+using Clock = std::chrono::steady_clock;
+
+struct ReplayVerifyResult
+{
+    std::string Path;
+    std::string Status = "error"; // passed, desync or error.
+    uint32_t Ticks{};
+    uint32_t Checksums{};
+    uint32_t MismatchTick{};
+    double Seconds{};
+};
+
+static int32_t _jobs = 0;
+static char* _jsonReport = nullptr;
+static char* _junitReport = nullptr;
+
+// clang-format off
+static constexpr const CommandLineOptionDefinition VerifyReplayOptionsDef[]
+{
+    { CMDLINE_TYPE_INTEGER, &_jobs,        'j', "jobs",  "number of worker processes (default: number of cores)" },
+    { CMDLINE_TYPE_STRING,  &_jsonReport,  NAC, "json",  "write a JSON report to the given file"                 },
+    { CMDLINE_TYPE_STRING,  &_junitReport, NAC, "junit", "write a JUnit XML report to the given file"            },
+    OptionTableEnd
+};
+
+static exitcode_t HandleVerifyReplays(CommandLineArgEnumerator* argEnumerator);
+static exitcode_t HandleVerifyReplaysWorker(CommandLineArgEnumerator* argEnumerator);
+
+const CommandLineCommand CommandLine::VerifyReplayCommands[]
+{
+    // Main commands
+    DefineCommand("",       "<replay or directory> [...]",   VerifyReplayOptionsDef, HandleVerifyReplays      ),
+    DefineCommand("worker", "<replay list> <report file>",   nullptr,                HandleVerifyReplaysWorker),
+    CommandTableEnd
+};
+// clang-format on
+
+// One line per replay, the path goes last as it may contain spaces.
+static std::string FormatResult(const ReplayVerifyResult& result)
+{
+    return String::StdFormat(
+        "%s %u %u %u %.6f %s\n", result.Status.c_str(), result.Ticks, result.Checksums, result.MismatchTick, result.Seconds,
+        result.Path.c_str());
+}
+
+static bool ParseResult(const std::string& line, ReplayVerifyResult& result)
+{
+    std::istringstream stream(line);
+    stream >> result.Status >> result.Ticks >> result.Checksums >> result.MismatchTick >> result.Seconds;
+    if (stream.fail())
+        return false;
+
+    std::getline(stream >> std::ws, result.Path);
+    return !result.Path.empty();
+}
+
+static std::vector<std::string> SplitLines(const std::string& text)
+{
+    std::vector<std::string> lines;
+    std::istringstream stream(text);
+    std::string line;
+    while (std::getline(stream, line))
+    {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if (!line.empty())
+            lines.push_back(line);
+    }
+    return lines;
+}
+
+static ReplayVerifyResult VerifyReplay(IContext& context, const std::string& path)
+{
+    ReplayVerifyResult result;
+    result.Path = path;
+
+    auto* replayManager = context.GetReplayManager();
+    auto* gameState = context.GetGameState();
+
+    const auto startTime = Clock::now();
+    if (!replayManager->StartPlayback(path))
+    {
+        return result;
+    }
+
+    ReplayRecordInfo info;
+    replayManager->GetCurrentReplayInfo(info);
+    result.Ticks = info.Ticks;
+    result.Status = "passed";
+
+    // The replay manager compares every stored checksum as it reaches its tick, stop at the first mismatch.
+    while (replayManager->IsReplaying())
+    {
+        gameState->UpdateLogic();
+        if (replayManager->IsPlaybackStateMismatching())
+        {
+            result.Status = "desync";
+            result.MismatchTick = gCurrentTicks;
+            replayManager->StopPlayback();
+            break;
+        }
+    }
+
+    // Only count the checksums that were actually compared, the replay may have stopped early.
+    result.Checksums = replayManager->GetNumComparedChecksums();
+    result.Seconds = std::chrono::duration<double>(Clock::now() - startTime).count();
+    return result;
+}
+
+static exitcode_t HandleVerifyReplaysWorker(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+
+    if (argc < 2)
+    {
+        Console::Error::WriteLine("Missing arguments <replay list> <report file>.");
+        return EXITCODE_FAIL;
+    }
+
+    Platform::CoreInit();
+
+    const auto replays = SplitLines(File::ReadAllText(argv[0]));
+    const std::string reportPath = argv[1];
+
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return EXITCODE_FAIL;
+    }
+
+    // The report is rewritten after every replay so a crash only loses the replay that caused it.
+    std::string report;
+    for (const auto& replay : replays)
+    {
+        report += FormatResult(VerifyReplay(*context, replay));
+        File::WriteAllBytes(reportPath, report.data(), report.size());
+    }
+    return EXITCODE_OK;
+}
+
+static void AddReplayPaths(const std::string& path, std::vector<std::string>& replays)
+{
+    if (!fs::is_directory(fs::u8path(path)))
+    {
+        replays.push_back(path);
+        return;
+    }
+
+    auto scanner = Path::ScanDirectory(Path::Combine(path, u8"*.parkrep"), true);
+    while (scanner->Next())
+    {
+        replays.push_back(scanner->GetPath());
+    }
+}
+
+static std::string XmlEscape(const std::string& text)
+{
+    std::string result;
+    for (char c : text)
+    {
+        switch (c)
+        {
+            case '&':
+                result += "&amp;";
+                break;
+            case '<':
+                result += "&lt;";
+                break;
+            case '>':
+                result += "&gt;";
+                break;
+            case '"':
+                result += "&quot;";
+                break;
+            default:
+                result += c;
+                break;
+        }
+    }
+    return result;
+}
+
+static double GetTicksPerSecond(const ReplayVerifyResult& result)
+{
+    return result.Seconds > 0 ? result.Ticks / result.Seconds : 0;
+}
+
+static void WriteJsonReport(const std::string& path, const std::vector<ReplayVerifyResult>& results)
+{
+    json_t replays = json_t::array();
+    for (const auto& result : results)
+    {
+        json_t replay = {
+            { "path", result.Path },
+            { "status", result.Status },
+            { "ticks", result.Ticks },
+            { "checksums", result.Checksums },
+            { "seconds", result.Seconds },
+            { "ticksPerSecond", GetTicksPerSecond(result) },
+        };
+        if (result.Status == "desync")
+        {
+            replay["mismatchTick"] = result.MismatchTick;
+        }
+        replays.push_back(replay);
+    }
+    Json::WriteToFile(path, json_t{ { "replays", replays } });
+}
+
+static void WriteJUnitReport(const std::string& path, const std::vector<ReplayVerifyResult>& results)
+{
+    size_t failures = 0;
+    size_t errors = 0;
+    double seconds = 0;
+    std::string cases;
+    for (const auto& result : results)
+    {
+        seconds += result.Seconds;
+        cases += String::StdFormat(
+            "    <testcase classname=\"replays\" name=\"%s\" time=\"%.3f\">\n", XmlEscape(result.Path).c_str(), result.Seconds);
+        if (result.Status == "desync")
+        {
+            failures++;
+            cases += String::StdFormat("      <failure message=\"Checksum mismatch at tick %u\"/>\n", result.MismatchTick);
+        }
+        else if (result.Status != "passed")
+        {
+            errors++;
+            cases += "      <error message=\"Replay could not be played\"/>\n";
+        }
+        cases += String::StdFormat(
+            "      <system-out>ticks=%u checksums=%u ticks_per_second=%.0f</system-out>\n", result.Ticks, result.Checksums,
+            GetTicksPerSecond(result));
+        cases += "    </testcase>\n";
+    }
+
+    auto xml = String::StdFormat(
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        "<testsuites>\n"
+        "  <testsuite name=\"replays\" tests=\"%zu\" failures=\"%zu\" errors=\"%zu\" time=\"%.3f\">\n",
+        results.size(), failures, errors, seconds);
+    xml += cases;
+    xml += "  </testsuite>\n</testsuites>\n";
+    File::WriteAllBytes(path, xml.data(), xml.size());
+}
+
+static exitcode_t HandleVerifyReplays(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+
+    if (argc < 1)
+    {
+        Console::Error::WriteLine("Missing arguments <replay or directory>.");
+        return EXITCODE_FAIL;
+    }
+
+    Platform::CoreInit();
+
+    std::vector<std::string> replays;
+    for (int32_t i = 0; i < argc; i++)
+    {
+        AddReplayPaths(argv[i], replays);
+    }
+    if (replays.empty())
+    {
+        Console::Error::WriteLine("No replays found.");
+        return EXITCODE_FAIL;
+    }
+
+    // Balance the shards by file size, replay length is roughly proportional to it.
+    std::vector<std::pair<uint64_t, std::string>> sortedReplays;
+    for (const auto& replay : replays)
+    {
+        std::error_code ec;
+        auto size = fs::file_size(fs::u8path(replay), ec);
+        sortedReplays.emplace_back(ec ? 0 : size, replay);
+    }
+    std::sort(sortedReplays.begin(), sortedReplays.end(), std::greater<>());
+
+    const uint32_t jobCount = std::clamp<uint32_t>(
+        _jobs > 0 ? _jobs : std::max(1u, std::thread::hardware_concurrency()), 1, static_cast<uint32_t>(replays.size()));
+    std::vector<std::vector<std::string>> shards(jobCount);
+    std::vector<uint64_t> shardSizes(jobCount);
+    for (const auto& [size, replay] : sortedReplays)
+    {
+        auto shard = std::min_element(shardSizes.begin(), shardSizes.end()) - shardSizes.begin();
+        shards[shard].push_back(replay);
+        shardSizes[shard] += size;
+    }
+
+    // Every worker is a separate headless process, the game state is global so replays can not share one.
+    const auto executable = Platform::GetCurrentExecutablePath();
+    const auto tempDirectory = fs::temp_directory_path().u8string();
+    const auto runId = std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+    std::vector<std::string> listPaths;
+    std::vector<std::string> reportPaths;
+    std::vector<std::thread> workers;
+    for (uint32_t i = 0; i < jobCount; i++)
+    {
+        auto listPath = Path::Combine(tempDirectory, String::StdFormat("openrct2-verify-%s-%u.txt", runId.c_str(), i));
+        auto reportPath = Path::Combine(
+            tempDirectory, String::StdFormat("openrct2-verify-%s-%u-report.txt", runId.c_str(), i));
+
+        std::string list;
+        for (const auto& replay : shards[i])
+        {
+            list += replay + "\n";
+        }
+        File::WriteAllBytes(listPath, list.data(), list.size());
+
+        auto command = String::StdFormat(
+            "\"%s\" verifyreplays worker \"%s\" \"%s\"", executable.c_str(), listPath.c_str(), reportPath.c_str());
+        listPaths.push_back(listPath);
+        reportPaths.push_back(reportPath);
+        workers.emplace_back([command]() {
+            std::string output;
+            Platform::Execute(command, &output);
+        });
+    }
+
+    Console::WriteLine("Verifying %zu replays with %u workers...", replays.size(), jobCount);
+
+    const auto startTime = Clock::now();
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    const double totalSeconds = std::chrono::duration<double>(Clock::now() - startTime).count();
+
+    // Replays without a result were never finished, most likely because their worker crashed.
+    std::vector<ReplayVerifyResult> results;
+    for (uint32_t i = 0; i < jobCount; i++)
+    {
+        std::vector<std::string> lines;
+        if (File::Exists(reportPaths[i]))
+        {
+            lines = SplitLines(File::ReadAllText(reportPaths[i]));
+        }
+        for (size_t j = 0; j < shards[i].size(); j++)
+        {
+            ReplayVerifyResult result;
+            if (j >= lines.size() || !ParseResult(lines[j], result))
+            {
+                result = {};
+                result.Path = shards[i][j];
+            }
+            results.push_back(result);
+        }
+        File::Delete(listPaths[i]);
+        File::Delete(reportPaths[i]);
+    }
+    std::sort(results.begin(), results.end(), [](const ReplayVerifyResult& a, const ReplayVerifyResult& b) {
+        return a.Path < b.Path;
+    });
+
+    size_t passedCount = 0;
+    uint64_t ticksTotal = 0;
+    Console::WriteLine("%-8s %-10s %-12s %s", "status", "ticks", "ticks/s", "replay");
+    for (const auto& result : results)
+    {
+        Console::WriteLine(
+            "%-8s %-10u %-12.0f %s", result.Status.c_str(), result.Ticks, GetTicksPerSecond(result), result.Path.c_str());
+        if (result.Status == "desync")
+        {
+            Console::WriteLine("         checksum mismatch at tick %u", result.MismatchTick);
+        }
+        passedCount += result.Status == "passed" ? 1 : 0;
+        ticksTotal += result.Ticks;
+    }
+
+    Console::WriteLine();
+    Console::WriteLine("Replays passed:  %zu / %zu", passedCount, results.size());
+    Console::WriteLine("Total time:      %.1f s, %.0f ticks/s", totalSeconds, totalSeconds > 0 ? ticksTotal / totalSeconds : 0);
+
+    if (_jsonReport != nullptr)
+    {
+        WriteJsonReport(_jsonReport, results);
+    }
+    if (_junitReport != nullptr)
+    {
+        WriteJUnitReport(_junitReport, results);
+    }
+
+    return passedCount == results.size() ? EXITCODE_OK : EXITCODE_FAIL;
+}
+
+#else
+
+#    include "../core/Console.hpp"
+
+static exitcode_t HandleVerifyReplays(CommandLineArgEnumerator* argEnumerator)
+{
+#    if defined(_WIN32)
+    Console::Error::WriteLine("Replay verification is not supported on this platform.");
+#    else
+    Console::Error::WriteLine("Replay verification is not available in builds without network support.");
+#    endif
+    return EXITCODE_FAIL;
+}
+
+const CommandLineCommand CommandLine::VerifyReplayCommands[]{
+    DefineCommand("", "*** SORRY NOT ENABLED IN THIS BUILD ***", nullptr, HandleVerifyReplays), CommandTableEnd
+};
+
+#endif // !defined(DISABLE_NETWORK) && !defined(_WIN32)
@@ -196,6 +196,7 @@ namespace Config
             model->WindowScale = reader->GetFloat("window_scale", Platform::GetDefaultScale());
             model->ShowFPS = reader->GetBoolean("show_fps", false);
             model->MultiThreading = reader->GetBoolean("multi_threading", false);
+            model->StaticPaintCache = reader->GetBoolean("static_paint_cache", false);
             model->TrapCursor = reader->GetBoolean("trap_cursor", false);
             model->AutoOpenShops = reader->GetBoolean("auto_open_shops", false);
             model->ScenarioSelectMode = reader->GetInt32("scenario_select_mode", SCENARIO_SELECT_MODE_ORIGIN);
@@ -215,6 +216,7 @@ namespace Config
             model->AllowEarlyCompletion = reader->GetBoolean("allow_early_completion", false);
             model->AssetPackOrder = reader->GetString("asset_pack_order", "");
             model->EnabledAssetPacks = reader->GetString("enabled_asset_packs", "");
+            model->SharedObjectCache = reader->GetBoolean("shared_object_cache", false);
             model->TransparentScreenshot = reader->GetBoolean("transparent_screenshot", true);
             model->TransparentWater = reader->GetBoolean("transparent_water", true);
 
@@ -281,6 +283,7 @@ namespace Config
         writer->WriteFloat("window_scale", model->WindowScale);
         writer->WriteBoolean("show_fps", model->ShowFPS);
         writer->WriteBoolean("multi_threading", model->MultiThreading);
+        writer->WriteBoolean("static_paint_cache", model->StaticPaintCache);
         writer->WriteBoolean("trap_cursor", model->TrapCursor);
         writer->WriteBoolean("auto_open_shops", model->AutoOpenShops);
         writer->WriteInt32("scenario_select_mode", model->ScenarioSelectMode);
@@ -300,6 +303,7 @@ namespace Config
         writer->WriteBoolean("allow_early_completion", model->AllowEarlyCompletion);
         writer->WriteString("asset_pack_order", model->AssetPackOrder);
         writer->WriteString("enabled_asset_packs", model->EnabledAssetPacks);
+        writer->WriteBoolean("shared_object_cache", model->SharedObjectCache);
         writer->WriteEnum<VirtualFloorStyles>("virtual_floor_style", model->VirtualFloorStyle, Enum_VirtualFloorStyle);
         writer->WriteBoolean("transparent_screenshot", model->TransparentScreenshot);
         writer->WriteBoolean("transparent_water", model->TransparentWater);
@@ -427,6 +431,8 @@ namespace Config
             model->LogServerActions = reader->GetBoolean("log_server_actions", false);
             model->PauseServerIfNoClients = reader->GetBoolean("pause_server_if_no_clients", false);
             model->DesyncDebugging = reader->GetBoolean("desync_debugging", false);
+            model->CompressStream = reader->GetBoolean("compress_stream", true);
+            model->ChecksumInterval = std::max(1, reader->GetInt32("checksum_interval", 40));
         }
     }
 
@@ -454,6 +460,8 @@ namespace Config
         writer->WriteBoolean("log_server_actions", model->LogServerActions);
         writer->WriteBoolean("pause_server_if_no_clients", model->PauseServerIfNoClients);
         writer->WriteBoolean("desync_debugging", model->DesyncDebugging);
+        writer->WriteBoolean("compress_stream", model->CompressStream);
+        writer->WriteInt32("checksum_interval", model->ChecksumInterval);
     }
 
     static void ReadNotifications(IIniReader* reader)
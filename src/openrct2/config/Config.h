@@ -43,6 +43,7 @@ struct GeneralConfiguration
     bool UseVSync;
     bool ShowFPS;
     bool MultiThreading;
+    bool StaticPaintCache;
     bool MinimizeFullscreenFocusLoss;
     bool DisableScreensaver;
 
@@ -106,6 +107,7 @@ struct GeneralConfiguration
     bool AllowEarlyCompletion;
     u8string AssetPackOrder;
     u8string EnabledAssetPacks;
+    bool SharedObjectCache;
 
     // Loading and saving
     bool ConfirmationPrompt;
@@ -172,6 +174,8 @@ struct NetworkConfiguration
     bool LogServerActions;
     bool PauseServerIfNoClients;
     bool DesyncDebugging;
+    bool CompressStream;
+    int32_t ChecksumInterval;
 };
 
 struct NotificationConfiguration
@@ -25,21 +25,35 @@ namespace OpenRCT2
 
     void ChecksumStream::Write(const void* buffer, uint64_t length)
     {
-        uint64_t* hash = reinterpret_cast<uint64_t*>(_checksum.data());
         for (size_t i = 0; i < length; i += sizeof(uint64_t))
         {
             const auto maxLen = std::min<size_t>(sizeof(uint64_t), length - i);
 
             uint64_t temp{};
             std::memcpy(&temp, reinterpret_cast<const std::byte*>(buffer) + i, maxLen);
+            Hash(temp);
+        }
+    }
 
-            // Always use value as little endian, most common systems are little.
-#    if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
-            temp = ByteSwapBE(temp);
-#    endif
-
-            *hash ^= temp;
-            *hash *= Prime;
+    void ChecksumStream::WriteElements(const void* buffer, size_t elementSize, size_t count)
+    {
+        auto src = reinterpret_cast<const std::byte*>(buffer);
+        if (elementSize <= sizeof(uint64_t))
+        {
+            // Each element is a single step of the hash, identical to writing them separately
+            for (size_t i = 0; i < count; i++)
+            {
+                uint64_t temp{};
+                std::memcpy(&temp, src + (i * elementSize), elementSize);
+                Hash(temp);
+            }
+        }
+        else
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                Write(src + (i * elementSize), elementSize);
+            }
         }
     }
 
@@ -10,9 +10,11 @@
 #pragma once
 
 #include "../common.h"
+#include "Endianness.h"
 #include "IStream.hpp"
 
 #include <array>
+#include <cstring>
 
 namespace OpenRCT2
 {
@@ -98,15 +100,42 @@ namespace OpenRCT2
             Write<16>(buffer);
         }
 
+        void WriteElements(const void* buffer, size_t elementSize, size_t count) override;
+
         template<size_t N> void Write(const void* buffer)
         {
-            Write(buffer, N);
+            // Values of up to 8 bytes are a single step of the hash, avoid the generic loop for them.
+            if constexpr (N <= sizeof(uint64_t))
+            {
+                uint64_t temp{};
+                std::memcpy(&temp, buffer, N);
+                Hash(temp);
+            }
+            else
+            {
+                Write(buffer, N);
+            }
         }
 
         uint64_t TryRead(void* buffer, uint64_t length) override
         {
             return 0;
         }
+
+    private:
+        void Hash(uint64_t value)
+        {
+            // Always use value as little endian, most common systems are little.
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+            value = ByteSwapBE(value);
+#endif
+
+            uint64_t hash;
+            std::memcpy(&hash, _checksum.data(), sizeof(hash));
+            hash ^= value;
+            hash *= Prime;
+            std::memcpy(_checksum.data(), &hash, sizeof(hash));
+        }
     };
 
 } // namespace OpenRCT2
@@ -25,11 +25,14 @@
 #include "Endianness.h"
 #include "MemoryStream.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <sstream>
 #include <stdexcept>
+#include <type_traits>
 
 template<typename T> struct DataSerializerTraits_t
 {
@@ -267,6 +270,41 @@ template<> struct DataSerializerTraits_t<OpenRCT2::MemoryStream>
     }
 };
 
+/**
+ * Integral and enum values are encoded one by one as big endian, ranges of them are converted in chunks and each
+ * chunk is handed to the stream at once. The encoded data is identical to encoding every element separately.
+ */
+template<typename T>
+inline constexpr bool DataSerializerIsBulkType = (std::is_integral_v<T> || std::is_enum_v<T>) && !std::is_same_v<T, bool>;
+
+template<typename T> struct DataSerializerBulk
+{
+    static void encode(OpenRCT2::IStream* stream, const T* values, size_t count)
+    {
+        constexpr size_t ChunkSize = 64;
+        T chunk[ChunkSize];
+        while (count > 0)
+        {
+            const auto chunkCount = std::min(count, ChunkSize);
+            for (size_t i = 0; i < chunkCount; i++)
+            {
+                chunk[i] = ByteSwapBE(values[i]);
+            }
+            stream->WriteElements(chunk, sizeof(T), chunkCount);
+            values += chunkCount;
+            count -= chunkCount;
+        }
+    }
+    static void decode(OpenRCT2::IStream* stream, T* values, size_t count)
+    {
+        stream->Read(values, sizeof(T) * count);
+        for (size_t i = 0; i < count; i++)
+        {
+            values[i] = ByteSwapBE(values[i]);
+        }
+    }
+};
+
 template<typename _Ty, size_t _Size> struct DataSerializerTraitsPODArray
 {
     static void encode(OpenRCT2::IStream* stream, const _Ty (&val)[_Size])
@@ -275,10 +313,17 @@ template<typename _Ty, size_t _Size> struct DataSerializerTraitsPODArray
         uint16_t swapped = ByteSwapBE(len);
         stream->Write(&swapped);
 
-        DataSerializerTraits<_Ty> s;
-        for (auto&& sub : val)
+        if constexpr (DataSerializerIsBulkType<_Ty>)
         {
-            s.encode(stream, sub);
+            DataSerializerBulk<_Ty>::encode(stream, std::data(val), std::size(val));
+        }
+        else
+        {
+            DataSerializerTraits<_Ty> s;
+            for (auto&& sub : val)
+            {
+                s.encode(stream, sub);
+            }
         }
     }
     static void decode(OpenRCT2::IStream* stream, _Ty (&val)[_Size])
@@ -290,10 +335,17 @@ template<typename _Ty, size_t _Size> struct DataSerializerTraitsPODArray
         if (len != _Size)
             throw std::runtime_error("Invalid size, can't decode");
 
-        DataSerializerTraits<_Ty> s;
-        for (auto&& sub : val)
+        if constexpr (DataSerializerIsBulkType<_Ty>)
         {
-            s.decode(stream, sub);
+            DataSerializerBulk<_Ty>::decode(stream, std::data(val), _Size);
+        }
+        else
+        {
+            DataSerializerTraits<_Ty> s;
+            for (auto&& sub : val)
+            {
+                s.decode(stream, sub);
+            }
         }
     }
     static void log(OpenRCT2::IStream* stream, const _Ty (&val)[_Size])
@@ -343,10 +395,17 @@ template<typename _Ty, size_t _Size> struct DataSerializerTraits_t<std::array<_T
         uint16_t swapped = ByteSwapBE(len);
         stream->Write(&swapped);
 
-        DataSerializerTraits<_Ty> s;
-        for (auto&& sub : val)
+        if constexpr (DataSerializerIsBulkType<_Ty>)
         {
-            s.encode(stream, sub);
+            DataSerializerBulk<_Ty>::encode(stream, std::data(val), std::size(val));
+        }
+        else
+        {
+            DataSerializerTraits<_Ty> s;
+            for (auto&& sub : val)
+            {
+                s.encode(stream, sub);
+            }
         }
     }
     static void decode(OpenRCT2::IStream* stream, std::array<_Ty, _Size>& val)
@@ -358,10 +417,17 @@ template<typename _Ty, size_t _Size> struct DataSerializerTraits_t<std::array<_T
         if (len != _Size)
             throw std::runtime_error("Invalid size, can't decode");
 
-        DataSerializerTraits<_Ty> s;
-        for (auto&& sub : val)
+        if constexpr (DataSerializerIsBulkType<_Ty>)
         {
-            s.decode(stream, sub);
+            DataSerializerBulk<_Ty>::decode(stream, std::data(val), _Size);
+        }
+        else
+        {
+            DataSerializerTraits<_Ty> s;
+            for (auto&& sub : val)
+            {
+                s.decode(stream, sub);
+            }
         }
     }
     static void log(OpenRCT2::IStream* stream, const std::array<_Ty, _Size>& val)
@@ -385,10 +451,17 @@ template<typename _Ty> struct DataSerializerTraits_t<std::vector<_Ty>>
         uint16_t swapped = ByteSwapBE(len);
         stream->Write(&swapped);
 
-        DataSerializerTraits<_Ty> s;
-        for (auto&& sub : val)
+        if constexpr (DataSerializerIsBulkType<_Ty>)
         {
-            s.encode(stream, sub);
+            DataSerializerBulk<_Ty>::encode(stream, std::data(val), std::size(val));
+        }
+        else
+        {
+            DataSerializerTraits<_Ty> s;
+            for (auto&& sub : val)
+            {
+                s.encode(stream, sub);
+            }
         }
     }
     static void decode(OpenRCT2::IStream* stream, std::vector<_Ty>& val)
@@ -397,12 +470,21 @@ template<typename _Ty> struct DataSerializerTraits_t<std::vector<_Ty>>
         stream->Read(&len);
         len = ByteSwapBE(len);
 
-        DataSerializerTraits<_Ty> s;
-        for (auto i = 0; i < len; ++i)
+        if constexpr (DataSerializerIsBulkType<_Ty>)
         {
-            _Ty sub{};
-            s.decode(stream, sub);
-            val.push_back(std::move(sub));
+            const auto offset = val.size();
+            val.resize(offset + len);
+            DataSerializerBulk<_Ty>::decode(stream, val.data() + offset, len);
+        }
+        else
+        {
+            DataSerializerTraits<_Ty> s;
+            for (auto i = 0; i < len; ++i)
+            {
+                _Ty sub{};
+                s.decode(stream, sub);
+                val.push_back(std::move(sub));
+            }
         }
     }
     static void log(OpenRCT2::IStream* stream, const std::vector<_Ty>& val)
@@ -54,6 +54,8 @@ namespace File
 
     bool Move(u8string_view srcPath, u8string_view dstPath)
     {
+        // Replaces an existing destination atomically, std::filesystem uses MoveFileEx with MOVEFILE_REPLACE_EXISTING
+        // on Windows.
         std::error_code ec;
         fs::rename(fs::u8path(srcPath), fs::u8path(dstPath), ec);
         return ec.value() == 0;
@@ -16,13 +16,20 @@
 #include "FileScanner.h"
 #include "FileStream.h"
 #include "JobPool.h"
+#include "MemoryMappedFile.h"
+#include "MemoryStream.h"
 #include "Numerics.hpp"
 #include "Path.hpp"
+#include "String.hpp"
 
 #include <chrono>
-#include <list>
+#include <cstring>
+#include <optional>
+#include <random>
+#include <stdexcept>
 #include <string>
-#include <tuple>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 template<typename TItem> class FileIndex
@@ -36,18 +43,30 @@ private:
         uint32_t PathChecksum = 0;
     };
 
+    struct ScannedFile
+    {
+        std::string Path;
+        uint64_t Size = 0;
+        uint64_t LastModified = 0;
+    };
+
     struct ScanResult
     {
         DirectoryStats const Stats;
-        std::vector<std::string> const Files;
+        std::vector<ScannedFile> const Files;
 
-        ScanResult(DirectoryStats stats, std::vector<std::string>&& files) noexcept
+        ScanResult(DirectoryStats stats, std::vector<ScannedFile>&& files) noexcept
             : Stats(stats)
             , Files(std::move(files))
         {
         }
     };
 
+    /**
+     * The index file is laid out as the header, followed by a fixed size record for each scanned file,
+     * a table of the (non null-terminated) file paths and finally the serialised items. This allows the
+     * index to be memory mapped and the records to be queried in place.
+     */
     struct FileIndexHeader
     {
         uint32_t HeaderSize = sizeof(FileIndexHeader);
@@ -57,10 +76,33 @@ private:
         uint16_t LanguageId = 0;
         DirectoryStats Stats;
         uint32_t NumItems = 0;
+        uint32_t NumFiles = 0;
+        uint64_t StringTableOffset = 0;
+        uint64_t StringTableSize = 0;
+        uint64_t ItemsOffset = 0;
+        uint64_t ItemsSize = 0;
+    };
+
+    struct FileIndexRecord
+    {
+        uint32_t PathOffset = 0;
+        uint32_t PathLength = 0;
+        uint64_t Size = 0;
+        uint64_t LastModified = 0;
+        uint64_t ItemOffset = 0;
+        // Zero if the file did not produce an item, it will not be re-indexed until it changes.
+        uint32_t ItemLength = 0;
+        uint32_t Reserved = 0;
+    };
+
+    struct FileResult
+    {
+        bool Indexed = false;
+        std::optional<TItem> Item;
     };
 
     // Index file format version which when incremented forces a rebuild
-    static constexpr uint8_t FILE_INDEX_VERSION = 4;
+    static constexpr uint8_t FILE_INDEX_VERSION = 5;
 
     std::string const _name;
     uint32_t const _magicNumber;
@@ -96,32 +138,27 @@ public:
     virtual ~FileIndex() = default;
 
     /**
-     * Queries and directories and loads the index header. If the index is up to date,
-     * the items are loaded from the index and returned, otherwise the index is rebuilt.
+     * Queries and directories and loads the index. Items for files that have not changed since the
+     * index was written are loaded from the index, only new or modified files are indexed again.
      */
     std::vector<TItem> LoadOrBuild(int32_t language) const
     {
-        std::vector<TItem> items;
         auto scanResult = Scan();
-        auto readIndexResult = ReadIndexFile(language, scanResult.Stats);
-        if (std::get<0>(readIndexResult))
-        {
-            // Index was loaded
-            items = std::get<1>(readIndexResult);
-        }
-        else
+        std::vector<FileResult> results(scanResult.Files.size());
+        auto numLoaded = ReadIndexFile(language, scanResult, results);
+        if (numLoaded != results.size())
         {
-            // Index was not loaded
-            items = Build(language, scanResult);
+            Build(language, scanResult, results, numLoaded);
         }
-        return items;
+        return CollectItems(results);
     }
 
     std::vector<TItem> Rebuild(int32_t language) const
     {
         auto scanResult = Scan();
-        auto items = Build(language, scanResult);
-        return items;
+        std::vector<FileResult> results(scanResult.Files.size());
+        Build(language, scanResult, results, 0);
+        return CollectItems(results);
     }
 
 protected:
@@ -139,7 +176,7 @@ private:
     ScanResult Scan() const
     {
         DirectoryStats stats{};
-        std::vector<std::string> files;
+        std::vector<ScannedFile> files;
         for (const auto& directory : SearchPaths)
         {
             auto absoluteDirectory = Path::GetAbsolute(directory);
@@ -159,20 +196,20 @@ private:
                 stats.FileDateModifiedChecksum = Numerics::ror32(stats.FileDateModifiedChecksum, 5);
                 stats.PathChecksum += GetPathChecksum(path);
 
-                files.push_back(std::move(path));
+                files.push_back({ std::move(path), fileInfo->Size, fileInfo->LastModified });
             }
         }
         return ScanResult(stats, std::move(files));
     }
 
     void BuildRange(
-        int32_t language, const ScanResult& scanResult, size_t rangeStart, size_t rangeEnd, std::vector<TItem>& items,
-        std::atomic<size_t>& processed, std::mutex& printLock) const
+        int32_t language, const ScanResult& scanResult, const std::vector<size_t>& pending, size_t rangeStart,
+        size_t rangeEnd, std::vector<FileResult>& results, std::atomic<size_t>& processed, std::mutex& printLock) const
     {
-        items.reserve(rangeEnd - rangeStart);
         for (size_t i = rangeStart; i < rangeEnd; i++)
         {
-            const auto& filePath = scanResult.Files.at(i);
+            const auto fileIndex = pending[i];
+            const auto& filePath = scanResult.Files[fileIndex].Path;
 
             if (_log_levels[static_cast<uint8_t>(DiagnosticLevel::Verbose)])
             {
@@ -180,30 +217,45 @@ private:
                 log_verbose("FileIndex:Indexing '%s'", filePath.c_str());
             }
 
-            if (auto item = Create(language, filePath); item.has_value())
-            {
-                items.push_back(std::move(item.value()));
-            }
+            // Each file owns its own result slot, so no synchronisation is required here.
+            auto& result = results[fileIndex];
+            result.Item = Create(language, filePath);
+            result.Indexed = true;
 
             ++processed;
         }
     }
 
-    std::vector<TItem> Build(int32_t language, const ScanResult& scanResult) const
+    void Build(int32_t language, const ScanResult& scanResult, std::vector<FileResult>& results, size_t numLoaded) const
     {
-        std::vector<TItem> allItems;
-        Console::WriteLine("Building %s (%zu items)", _name.c_str(), scanResult.Files.size());
+        std::vector<size_t> pending;
+        pending.reserve(results.size() - numLoaded);
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            if (!results[i].Indexed)
+            {
+                pending.push_back(i);
+            }
+        }
+
+        if (numLoaded == 0)
+        {
+            Console::WriteLine("Building %s (%zu items)", _name.c_str(), pending.size());
+        }
+        else
+        {
+            Console::WriteLine(
+                "Updating %s (%zu of %zu items changed)", _name.c_str(), pending.size(), scanResult.Files.size());
+        }
 
         auto startTime = std::chrono::high_resolution_clock::now();
 
-        const size_t totalCount = scanResult.Files.size();
+        const size_t totalCount = pending.size();
         if (totalCount > 0)
         {
             JobPool jobPool;
             std::mutex printLock; // For verbose prints.
 
-            std::list<std::vector<TItem>> containers;
-
             size_t stepSize = 100; // Handpicked, seems to work well with 4/8 cores.
 
             std::atomic<size_t> processed = ATOMIC_VAR_INIT(0);
@@ -220,63 +272,120 @@ private:
                     stepSize = totalCount - rangeStart;
                 }
 
-                auto& items = containers.emplace_back();
-
                 jobPool.AddTask([&, rangeStart, stepSize]() {
-                    BuildRange(language, scanResult, rangeStart, rangeStart + stepSize, items, processed, printLock);
+                    BuildRange(
+                        language, scanResult, pending, rangeStart, rangeStart + stepSize, results, processed, printLock);
                 });
 
                 reportProgress();
             }
 
             jobPool.Join(reportProgress);
-
-            for (const auto& itr : containers)
-            {
-                allItems.insert(allItems.end(), itr.begin(), itr.end());
-            }
         }
 
-        WriteIndexFile(language, scanResult.Stats, allItems);
+        WriteIndexFile(language, scanResult, results);
 
         auto endTime = std::chrono::high_resolution_clock::now();
         auto duration = std::chrono::duration<float>(endTime - startTime);
         Console::WriteLine("Finished building %s in %.2f seconds.", _name.c_str(), duration.count());
-
-        return allItems;
     }
 
-    std::tuple<bool, std::vector<TItem>> ReadIndexFile(int32_t language, const DirectoryStats& stats) const
+    static std::vector<TItem> CollectItems(std::vector<FileResult>& results)
     {
-        bool loadedItems = false;
         std::vector<TItem> items;
+        items.reserve(results.size());
+        for (auto& result : results)
+        {
+            if (result.Item.has_value())
+            {
+                items.push_back(std::move(*result.Item));
+            }
+        }
+        return items;
+    }
+
+    /**
+     * Maps the index file and loads the items of all files that are unchanged since the index was written.
+     * @returns The number of files that no longer need to be indexed.
+     */
+    size_t ReadIndexFile(int32_t language, const ScanResult& scanResult, std::vector<FileResult>& results) const
+    {
+        size_t numLoaded = 0;
         if (File::Exists(_indexPath))
         {
             try
             {
                 log_verbose("FileIndex:Loading index: '%s'", _indexPath.c_str());
-                auto fs = OpenRCT2::FileStream(_indexPath, OpenRCT2::FILE_MODE_OPEN);
-
-                // Read header, check if we need to re-scan
-                auto header = fs.ReadValue<FileIndexHeader>();
-                if (header.HeaderSize == sizeof(FileIndexHeader) && header.MagicNumber == _magicNumber
-                    && header.VersionA == FILE_INDEX_VERSION && header.VersionB == _version && header.LanguageId == language
-                    && header.Stats.TotalFiles == stats.TotalFiles && header.Stats.TotalFileSize == stats.TotalFileSize
-                    && header.Stats.FileDateModifiedChecksum == stats.FileDateModifiedChecksum
-                    && header.Stats.PathChecksum == stats.PathChecksum)
+                OpenRCT2::MemoryMappedFile indexFile(_indexPath);
+                auto data = static_cast<const uint8_t*>(indexFile.GetData());
+                auto dataSize = indexFile.GetSize();
+
+                // Read header, check if the index is compatible
+                FileIndexHeader header;
+                if (dataSize < sizeof(FileIndexHeader))
+                {
+                    throw IOException("Index file is truncated.");
+                }
+                std::memcpy(&header, data, sizeof(FileIndexHeader));
+                if (header.HeaderSize != sizeof(FileIndexHeader) || header.MagicNumber != _magicNumber
+                    || header.VersionA != FILE_INDEX_VERSION || header.VersionB != _version || header.LanguageId != language)
+                {
+                    Console::WriteLine("%s out of date", _name.c_str());
+                    return 0;
+                }
+
+                const auto recordsSize = static_cast<uint64_t>(header.NumFiles) * sizeof(FileIndexRecord);
+                if (sizeof(FileIndexHeader) + recordsSize > header.StringTableOffset
+                    || header.StringTableOffset + header.StringTableSize > header.ItemsOffset
+                    || header.ItemsOffset + header.ItemsSize > dataSize)
+                {
+                    throw IOException("Index file is corrupt.");
+                }
+
+                auto records = data + sizeof(FileIndexHeader);
+                auto stringTable = reinterpret_cast<const char*>(data + header.StringTableOffset);
+                auto itemData = data + header.ItemsOffset;
+
+                // Look up the records by path, directly from the mapped string table
+                std::unordered_map<std::string_view, FileIndexRecord> recordMap;
+                recordMap.reserve(header.NumFiles);
+                for (uint32_t i = 0; i < header.NumFiles; i++)
+                {
+                    FileIndexRecord record;
+                    std::memcpy(&record, records + (i * sizeof(FileIndexRecord)), sizeof(FileIndexRecord));
+                    if (static_cast<uint64_t>(record.PathOffset) + record.PathLength > header.StringTableSize
+                        || record.ItemOffset + record.ItemLength > header.ItemsSize)
+                    {
+                        throw IOException("Index file is corrupt.");
+                    }
+                    recordMap.emplace(std::string_view(stringTable + record.PathOffset, record.PathLength), record);
+                }
+
+                for (size_t i = 0; i < scanResult.Files.size(); i++)
                 {
-                    items.reserve(header.NumItems);
-                    DataSerialiser ds(false, fs);
-                    // Directory is the same, just read the saved items
-                    for (uint32_t i = 0; i < header.NumItems; i++)
+                    const auto& file = scanResult.Files[i];
+                    auto it = recordMap.find(file.Path);
+                    if (it == recordMap.end())
+                        continue;
+
+                    const auto& record = it->second;
+                    if (record.Size != file.Size || record.LastModified != file.LastModified)
+                        continue;
+
+                    auto& result = results[i];
+                    if (record.ItemLength != 0)
                     {
+                        OpenRCT2::MemoryStream ms(itemData + record.ItemOffset, record.ItemLength);
+                        DataSerialiser ds(false, ms);
                         TItem item;
                         Serialise(ds, item);
-                        items.emplace_back(std::move(item));
+                        result.Item = std::move(item);
                     }
-                    loadedItems = true;
+                    result.Indexed = true;
+                    numLoaded++;
                 }
-                else
+
+                if (numLoaded != scanResult.Files.size())
                 {
                     Console::WriteLine("%s out of date", _name.c_str());
                 }
@@ -285,34 +394,78 @@ private:
             {
                 Console::Error::WriteLine("Unable to load index: '%s'.", _indexPath.c_str());
                 Console::Error::WriteLine("%s", e.what());
+
+                // Do not trust any of the items read before the failure
+                for (auto& result : results)
+                {
+                    result = {};
+                }
+                numLoaded = 0;
             }
         }
-        return std::make_tuple(loadedItems, std::move(items));
+        return numLoaded;
     }
 
-    void WriteIndexFile(int32_t language, const DirectoryStats& stats, const std::vector<TItem>& items) const
+    void WriteIndexFile(int32_t language, const ScanResult& scanResult, const std::vector<FileResult>& results) const
     {
         try
         {
             log_verbose("FileIndex:Writing index: '%s'", _indexPath.c_str());
-            Path::CreateDirectory(Path::GetDirectory(_indexPath));
-            auto fs = OpenRCT2::FileStream(_indexPath, OpenRCT2::FILE_MODE_WRITE);
 
-            // Write header
+            std::vector<FileIndexRecord> records;
+            records.reserve(results.size());
+            std::string stringTable;
+            OpenRCT2::MemoryStream itemStream;
+            DataSerialiser ds(true, itemStream);
+            uint32_t numItems = 0;
+            for (size_t i = 0; i < results.size(); i++)
+            {
+                const auto& file = scanResult.Files[i];
+                auto& record = records.emplace_back();
+                record.PathOffset = static_cast<uint32_t>(stringTable.size());
+                record.PathLength = static_cast<uint32_t>(file.Path.size());
+                record.Size = file.Size;
+                record.LastModified = file.LastModified;
+                record.ItemOffset = itemStream.GetPosition();
+                stringTable += file.Path;
+
+                const auto& result = results[i];
+                if (result.Item.has_value())
+                {
+                    Serialise(ds, *result.Item);
+                    record.ItemLength = static_cast<uint32_t>(itemStream.GetPosition() - record.ItemOffset);
+                    numItems++;
+                }
+            }
+
             FileIndexHeader header;
             header.MagicNumber = _magicNumber;
             header.VersionA = FILE_INDEX_VERSION;
             header.VersionB = _version;
             header.LanguageId = language;
-            header.Stats = stats;
-            header.NumItems = static_cast<uint32_t>(items.size());
-            fs.WriteValue(header);
-
-            DataSerialiser ds(true, fs);
-            // Write items
-            for (const auto& item : items)
+            header.Stats = scanResult.Stats;
+            header.NumItems = numItems;
+            header.NumFiles = static_cast<uint32_t>(records.size());
+            header.StringTableOffset = sizeof(FileIndexHeader) + (records.size() * sizeof(FileIndexRecord));
+            header.StringTableSize = stringTable.size();
+            header.ItemsOffset = header.StringTableOffset + header.StringTableSize;
+            header.ItemsSize = itemStream.GetLength();
+
+            // Other processes sharing the user directory may have the index mapped, truncating it under them would
+            // fault their reads. Write to a temporary file first and then replace the index with it.
+            Path::CreateDirectory(Path::GetDirectory(_indexPath));
+            auto tempPath = String::StdFormat("%s.%08x.tmp", _indexPath.c_str(), std::random_device{}());
+            {
+                auto fs = OpenRCT2::FileStream(tempPath, OpenRCT2::FILE_MODE_WRITE);
+                fs.WriteValue(header);
+                fs.Write(records.data(), records.size() * sizeof(FileIndexRecord));
+                fs.Write(stringTable.data(), stringTable.size());
+                fs.Write(itemStream.GetData(), itemStream.GetLength());
+            }
+            if (!File::Move(tempPath, _indexPath))
             {
-                Serialise(ds, item);
+                File::Delete(tempPath);
+                throw std::runtime_error("Unable to replace the index file.");
             }
         }
         catch (const std::exception& e)
@@ -108,6 +108,19 @@ namespace OpenRCT2
             Write(buffer, 16);
         }
 
+        /**
+         * Writes count elements of elementSize bytes each. The result must be identical to writing each
+         * element separately, streams can override this to process the whole range at once.
+         */
+        virtual void WriteElements(const void* buffer, size_t elementSize, size_t count)
+        {
+            auto src = static_cast<const uint8_t*>(buffer);
+            for (size_t i = 0; i < count; i++)
+            {
+                Write(src + (i * elementSize), elementSize);
+            }
+        }
+
         ///////////////////////////////////////////////////////////////////////////
         // Helper methods
         ///////////////////////////////////////////////////////////////////////////
@@ -251,3 +264,64 @@ public:
     {
     }
 };
+
+/**
+ * Adapts an IStream for use as a std::istream. Streams that expose their data (e.g. memory streams or
+ * stored zip entries) are read in place, all other streams are read through a small buffer.
+ * @note Reading in place does not advance the position of the underlying stream.
+ */
+class istream_adapter : public std::istream
+{
+private:
+    class stream_streambuf : public std::basic_streambuf<char, std::char_traits<char>>
+    {
+    private:
+        OpenRCT2::IStream& _stream;
+        bool _inPlace{};
+        char _buffer[4096];
+
+    public:
+        explicit stream_streambuf(OpenRCT2::IStream& stream)
+            : _stream(stream)
+        {
+            auto data = static_cast<const char*>(stream.GetData());
+            if (data != nullptr)
+            {
+                auto begin = const_cast<char*>(data);
+                this->setg(
+                    begin, begin + static_cast<size_t>(stream.GetPosition()), begin + static_cast<size_t>(stream.GetLength()));
+                _inPlace = true;
+            }
+        }
+
+    protected:
+        int_type underflow() override
+        {
+            if (this->gptr() < this->egptr())
+            {
+                return traits_type::to_int_type(*this->gptr());
+            }
+            if (_inPlace)
+            {
+                return traits_type::eof();
+            }
+
+            auto readBytes = static_cast<size_t>(_stream.TryRead(_buffer, sizeof(_buffer)));
+            if (readBytes == 0)
+            {
+                return traits_type::eof();
+            }
+            this->setg(_buffer, _buffer, _buffer + readBytes);
+            return traits_type::to_int_type(*this->gptr());
+        }
+    };
+
+    stream_streambuf _streambuf;
+
+public:
+    explicit istream_adapter(OpenRCT2::IStream& stream)
+        : std::istream(&_streambuf)
+        , _streambuf(stream)
+    {
+    }
+};
@@ -13,6 +13,7 @@
 
 #include "../Version.h"
 #include "../drawing/Drawing.h"
+#include "File.h"
 #include "FileSystem.hpp"
 #include "Guard.hpp"
 #include "IStream.hpp"
@@ -324,6 +325,12 @@ namespace Imaging
         return ReadFromStream(istream, format);
     }
 
+    Image ReadFromStream(OpenRCT2::IStream& stream, IMAGE_FORMAT format)
+    {
+        istream_adapter istream(stream);
+        return ReadFromStream(static_cast<std::istream&>(istream), format);
+    }
+
     void WriteToFile(std::string_view path, const Image& image, IMAGE_FORMAT format)
     {
         switch (format)
@@ -341,4 +348,142 @@ namespace Imaging
                 throw std::runtime_error(EXCEPTION_IMAGE_FORMAT_UNKNOWN);
         }
     }
+
+    struct PngRowWriter::Impl
+    {
+        std::ofstream Stream;
+        std::string Path;
+        std::string TempPath;
+        png_structp PngPtr{};
+        png_infop InfoPtr{};
+        uint32_t Width{};
+        uint32_t Height{};
+        uint32_t RowsWritten{};
+        bool Finished{};
+
+        ~Impl()
+        {
+            if (PngPtr != nullptr)
+            {
+                png_destroy_write_struct(&PngPtr, &InfoPtr);
+            }
+            if (!Finished && !TempPath.empty())
+            {
+                Stream.close();
+                File::Delete(TempPath);
+            }
+        }
+    };
+
+    PngRowWriter::PngRowWriter(std::string_view path, uint32_t width, uint32_t height, const GamePalette& palette)
+        : _impl(std::make_unique<Impl>())
+    {
+        _impl->Width = width;
+        _impl->Height = height;
+
+        // The image is written to a temporary file and only moved to its path once it is complete, so a failed write
+        // does not leave a truncated PNG behind.
+        _impl->Path = std::string(path);
+        const auto tempPath = _impl->Path + ".tmp";
+        _impl->Stream.open(fs::u8path(tempPath), std::ios::binary);
+        if (!_impl->Stream.is_open())
+        {
+            throw std::runtime_error("Unable to open " + tempPath + " for writing.");
+        }
+        _impl->TempPath = tempPath;
+
+        auto png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, PngError, PngWarning);
+        if (png_ptr == nullptr)
+        {
+            throw std::runtime_error("png_create_write_struct failed.");
+        }
+        _impl->PngPtr = png_ptr;
+
+        auto info_ptr = png_create_info_struct(png_ptr);
+        if (info_ptr == nullptr)
+        {
+            throw std::runtime_error("png_create_info_struct failed.");
+        }
+        _impl->InfoPtr = info_ptr;
+
+        png_color png_palette[PNG_MAX_PALETTE_LENGTH];
+        for (size_t i = 0; i < PNG_MAX_PALETTE_LENGTH; i++)
+        {
+            const auto& entry = palette[static_cast<uint16_t>(i)];
+            png_palette[i].blue = entry.Blue;
+            png_palette[i].green = entry.Green;
+            png_palette[i].red = entry.Red;
+        }
+
+        png_text text_ptr[1];
+        text_ptr[0].key = const_cast<char*>("Software");
+        text_ptr[0].text = const_cast<char*>(gVersionInfoFull);
+        text_ptr[0].compression = PNG_TEXT_COMPRESSION_zTXt;
+
+        png_set_write_fn(png_ptr, &_impl->Stream, PngWriteData, PngFlush);
+
+        // Set error handler
+        if (setjmp(png_jmpbuf(png_ptr)))
+        {
+            throw std::runtime_error("PNG ERROR");
+        }
+
+        png_byte transparentIndex = 0;
+        png_set_PLTE(png_ptr, info_ptr, png_palette, PNG_MAX_PALETTE_LENGTH);
+        png_set_tRNS(png_ptr, info_ptr, &transparentIndex, 1, nullptr);
+        png_set_text(png_ptr, info_ptr, text_ptr, 1);
+        png_set_IHDR(
+            png_ptr, info_ptr, width, height, 8, PNG_COLOR_TYPE_PALETTE, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT,
+            PNG_FILTER_TYPE_DEFAULT);
+        png_write_info(png_ptr, info_ptr);
+    }
+
+    PngRowWriter::~PngRowWriter() = default;
+
+    void PngRowWriter::WriteRows(const uint8_t* pixels, uint32_t stride, uint32_t count)
+    {
+        Guard::Assert(_impl->RowsWritten + count <= _impl->Height, "Too many rows written to PNG");
+
+        auto png_ptr = _impl->PngPtr;
+        if (setjmp(png_jmpbuf(png_ptr)))
+        {
+            throw std::runtime_error("PNG ERROR");
+        }
+
+        for (uint32_t y = 0; y < count; y++)
+        {
+            png_write_row(png_ptr, const_cast<png_byte*>(pixels));
+            pixels += stride;
+        }
+        _impl->RowsWritten += count;
+    }
+
+    void PngRowWriter::Finish()
+    {
+        if (_impl->RowsWritten != _impl->Height)
+        {
+            throw std::runtime_error("PNG is missing rows.");
+        }
+
+        auto png_ptr = _impl->PngPtr;
+        if (setjmp(png_jmpbuf(png_ptr)))
+        {
+            throw std::runtime_error("PNG ERROR");
+        }
+
+        png_write_end(png_ptr, nullptr);
+        png_destroy_write_struct(&_impl->PngPtr, &_impl->InfoPtr);
+        _impl->Stream.close();
+        if (_impl->Stream.fail())
+        {
+            throw std::runtime_error("Unable to write " + _impl->TempPath + ".");
+        }
+
+        // Rename over the old file in one step, deleting it first would leave no file behind if the rename failed.
+        if (!File::Move(_impl->TempPath, _impl->Path))
+        {
+            throw std::runtime_error("Unable to move " + _impl->TempPath + " to " + _impl->Path + ".");
+        }
+        _impl->Finished = true;
+    }
 } // namespace Imaging
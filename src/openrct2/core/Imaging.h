@@ -19,6 +19,10 @@
 #include <vector>
 
 struct rct_drawpixelinfo;
+namespace OpenRCT2
+{
+    struct IStream;
+}
 
 enum class IMAGE_FORMAT
 {
@@ -49,7 +53,26 @@ namespace Imaging
     IMAGE_FORMAT GetImageFormatFromPath(std::string_view path);
     Image ReadFromFile(std::string_view path, IMAGE_FORMAT format = IMAGE_FORMAT::AUTOMATIC);
     Image ReadFromBuffer(const std::vector<uint8_t>& buffer, IMAGE_FORMAT format = IMAGE_FORMAT::AUTOMATIC);
+    Image ReadFromStream(OpenRCT2::IStream& stream, IMAGE_FORMAT format = IMAGE_FORMAT::AUTOMATIC);
     void WriteToFile(std::string_view path, const Image& image, IMAGE_FORMAT format = IMAGE_FORMAT::AUTOMATIC);
 
     void SetReader(IMAGE_FORMAT format, ImageReaderFunc impl);
+
+    /**
+     * Writes an 8-bit paletted PNG a few rows at a time, for images that are too large to be held in memory at once.
+     * The file only appears at its path once Finish succeeded, an unfinished image is deleted by the destructor.
+     */
+    class PngRowWriter
+    {
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> _impl;
+
+    public:
+        PngRowWriter(std::string_view path, uint32_t width, uint32_t height, const GamePalette& palette);
+        ~PngRowWriter();
+
+        void WriteRows(const uint8_t* pixels, uint32_t stride, uint32_t count);
+        void Finish();
+    };
 } // namespace Imaging
@@ -85,6 +85,23 @@ namespace Json
         return json;
     }
 
+    json_t FromStream(OpenRCT2::IStream& stream)
+    {
+        json_t json;
+
+        try
+        {
+            istream_adapter istream(stream);
+            json = json_t::parse(istream);
+        }
+        catch (const json_t::exception& e)
+        {
+            log_error("Unable to parse JSON stream\n\t%s", e.what());
+        }
+
+        return json;
+    }
+
     std::string GetString(const json_t& jsonObj, const std::string& defaultValue)
     {
         return jsonObj.is_string() ? jsonObj.get<std::string>() : defaultValue;
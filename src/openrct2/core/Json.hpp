@@ -22,6 +22,11 @@
 
 using json_t = nlohmann::json;
 
+namespace OpenRCT2
+{
+    struct IStream;
+}
+
 namespace Json
 {
     // Don't try to load JSON files that exceed 64 MiB
@@ -60,6 +65,14 @@ namespace Json
      */
     json_t FromVector(const std::vector<uint8_t>& vec);
 
+    /**
+     * Parse JSON from the remainder of a stream, without copying it into a buffer first
+     * @param stream Stream containing JSON
+     * @return A JSON representation of the stream, or a null value if the JSON cannot be parsed
+     * @note Parse errors are logged rather than thrown, errors reading the stream itself are still thrown
+     */
+    json_t FromStream(OpenRCT2::IStream& stream);
+
     /**
      * Explicit type conversion between a JSON object and a compatible number value
      * @param T Destination numeric type
@@ -0,0 +1,141 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2022 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "MemoryMappedFile.h"
+
+#include "IStream.hpp"
+#include "String.hpp"
+
+#ifdef _WIN32
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+namespace OpenRCT2
+{
+#ifdef _WIN32
+    MemoryMappedFile::MemoryMappedFile(std::string_view path)
+    {
+        auto pathW = String::ToWideChar(path);
+        // Allow the file to be replaced by renaming a new one over it while it is mapped, as on other platforms. The
+        // mapping keeps the old contents alive until it is closed.
+        auto hFile = CreateFileW(
+            pathW.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+            nullptr);
+        if (hFile == INVALID_HANDLE_VALUE)
+        {
+            throw IOException("Unable to open '" + std::string(path) + "'");
+        }
+        _fileHandle = hFile;
+
+        LARGE_INTEGER fileSize{};
+        if (!GetFileSizeEx(hFile, &fileSize))
+        {
+            Close();
+            throw IOException("Unable to query size of '" + std::string(path) + "'");
+        }
+        _size = static_cast<size_t>(fileSize.QuadPart);
+        if (_size == 0)
+        {
+            return;
+        }
+
+        auto hMapping = CreateFileMappingW(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (hMapping == nullptr)
+        {
+            Close();
+            throw IOException("Unable to map '" + std::string(path) + "'");
+        }
+        _mappingHandle = hMapping;
+
+        _data = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+        if (_data == nullptr)
+        {
+            Close();
+            throw IOException("Unable to map '" + std::string(path) + "'");
+        }
+    }
+
+    void MemoryMappedFile::Close()
+    {
+        if (_data != nullptr)
+        {
+            UnmapViewOfFile(_data);
+            _data = nullptr;
+        }
+        if (_mappingHandle != nullptr)
+        {
+            CloseHandle(_mappingHandle);
+            _mappingHandle = nullptr;
+        }
+        if (_fileHandle != nullptr)
+        {
+            CloseHandle(_fileHandle);
+            _fileHandle = nullptr;
+        }
+        _size = 0;
+    }
+#else
+    MemoryMappedFile::MemoryMappedFile(std::string_view path)
+    {
+        _fd = open(std::string(path).c_str(), O_RDONLY);
+        if (_fd == -1)
+        {
+            throw IOException("Unable to open '" + std::string(path) + "'");
+        }
+
+        struct stat statInfo
+        {
+        };
+        if (fstat(_fd, &statInfo) != 0)
+        {
+            Close();
+            throw IOException("Unable to query size of '" + std::string(path) + "'");
+        }
+        _size = static_cast<size_t>(statInfo.st_size);
+        if (_size == 0)
+        {
+            return;
+        }
+
+        auto data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, _fd, 0);
+        if (data == MAP_FAILED)
+        {
+            Close();
+            throw IOException("Unable to map '" + std::string(path) + "'");
+        }
+        _data = data;
+    }
+
+    void MemoryMappedFile::Close()
+    {
+        if (_data != nullptr)
+        {
+            munmap(const_cast<void*>(_data), _size);
+            _data = nullptr;
+        }
+        if (_fd != -1)
+        {
+            close(_fd);
+            _fd = -1;
+        }
+        _size = 0;
+    }
+#endif
+
+    MemoryMappedFile::~MemoryMappedFile()
+    {
+        Close();
+    }
+
+} // namespace OpenRCT2
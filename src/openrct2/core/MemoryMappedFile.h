@@ -0,0 +1,54 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2022 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+
+#include <string_view>
+
+namespace OpenRCT2
+{
+    /**
+     * A read-only view of a file mapped into memory. The contents can be queried in place without
+     * reading the file into a separate buffer first.
+     */
+    class MemoryMappedFile final
+    {
+    private:
+        const void* _data = nullptr;
+        size_t _size = 0;
+#ifdef _WIN32
+        void* _fileHandle = nullptr;
+        void* _mappingHandle = nullptr;
+#else
+        int32_t _fd = -1;
+#endif
+
+    public:
+        explicit MemoryMappedFile(std::string_view path);
+        MemoryMappedFile(const MemoryMappedFile&) = delete;
+        MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+        ~MemoryMappedFile();
+
+        const void* GetData() const
+        {
+            return _data;
+        }
+
+        size_t GetSize() const
+        {
+            return _size;
+        }
+
+    private:
+        void Close();
+    };
+
+} // namespace OpenRCT2
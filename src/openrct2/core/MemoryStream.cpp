@@ -262,6 +262,11 @@ namespace OpenRCT2
         Write<16>(buffer);
     }
 
+    void MemoryStream::WriteElements(const void* buffer, size_t elementSize, size_t count)
+    {
+        Write(buffer, elementSize * count);
+    }
+
     void MemoryStream::Clear()
     {
         _dataSize = 0;
@@ -87,6 +87,7 @@ namespace OpenRCT2
         void Write4(const void* buffer) override;
         void Write8(const void* buffer) override;
         void Write16(const void* buffer) override;
+        void WriteElements(const void* buffer, size_t elementSize, size_t count) override;
 
         template<size_t N> void Write(const void* buffer)
         {
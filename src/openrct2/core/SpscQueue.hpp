@@ -0,0 +1,128 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2022 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+/**
+ * Unbounded lock-free queue for exactly one producer thread and one consumer thread.
+ * Elements are stored in fixed size blocks chained together, the consumer hands each block it drained back to the
+ * producer, so once the queue reached its usual length pushing no longer allocates.
+ */
+template<typename TType, size_t TBlockSize = 64> class SpscQueue
+{
+    static_assert(TBlockSize > 0);
+
+    struct Block
+    {
+        std::array<TType, TBlockSize> Slots{};
+        // Amount of slots the producer filled.
+        std::atomic<size_t> Count{};
+        std::atomic<Block*> Next{};
+    };
+
+    // Only touched by the consumer.
+    alignas(64) Block* _head;
+    size_t _headIndex{};
+    // Only touched by the producer.
+    alignas(64) Block* _tail;
+    // A drained block waiting to be reused by the producer.
+    alignas(64) std::atomic<Block*> _spare{};
+
+public:
+    using value_type = TType;
+
+    SpscQueue()
+        : _head(new Block())
+        , _tail(_head)
+    {
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    ~SpscQueue()
+    {
+        while (_head != nullptr)
+        {
+            auto* next = _head->Next.load(std::memory_order_relaxed);
+            delete _head;
+            _head = next;
+        }
+        delete _spare.load(std::memory_order_relaxed);
+    }
+
+    // Producer only.
+    void push(TType value)
+    {
+        auto count = _tail->Count.load(std::memory_order_relaxed);
+        if (count == TBlockSize)
+        {
+            auto* block = _spare.exchange(nullptr, std::memory_order_acquire);
+            if (block == nullptr)
+            {
+                block = new Block();
+            }
+            _tail->Next.store(block, std::memory_order_release);
+            _tail = block;
+            count = 0;
+        }
+        _tail->Slots[count] = std::move(value);
+        _tail->Count.store(count + 1, std::memory_order_release);
+    }
+
+    // Consumer only, returns false when the queue is empty.
+    bool pop(TType& value)
+    {
+        if (_headIndex == TBlockSize)
+        {
+            auto* next = _head->Next.load(std::memory_order_acquire);
+            if (next == nullptr)
+            {
+                return false;
+            }
+            Recycle(_head);
+            _head = next;
+            _headIndex = 0;
+        }
+        if (_headIndex == _head->Count.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        auto& slot = _head->Slots[_headIndex++];
+        value = std::move(slot);
+        // Release whatever the moved from value still holds rather than keeping it until the slot is reused.
+        slot = TType();
+        return true;
+    }
+
+    // Consumer only.
+    bool empty() const
+    {
+        if (_headIndex == TBlockSize)
+        {
+            const auto* next = _head->Next.load(std::memory_order_acquire);
+            return next == nullptr || next->Count.load(std::memory_order_acquire) == 0;
+        }
+        return _headIndex == _head->Count.load(std::memory_order_acquire);
+    }
+
+private:
+    // Consumer only, the producer moved on from the block before linking the next one.
+    void Recycle(Block* block)
+    {
+        block->Count.store(0, std::memory_order_relaxed);
+        block->Next.store(nullptr, std::memory_order_relaxed);
+        delete _spare.exchange(block, std::memory_order_release);
+    }
+};
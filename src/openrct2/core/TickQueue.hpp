@@ -0,0 +1,152 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2022 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * Queue of items ordered by tick and then by insertion order, used for actions scheduled for a specific tick.
+ * Every tick in the window between the oldest and newest queued tick has a bucket in a power of two sized ring, the
+ * buckets keep their capacity after being drained so a steady stream of items does not allocate.
+ */
+template<typename TType> class TickQueue
+{
+    // Items are only ever queued a few ticks apart, ticks outside of this window (e.g. sent by a misbehaving peer) are
+    // clamped to its edge rather than growing the ring without limit.
+    static constexpr uint32_t MaxSpan = 4096;
+
+    struct Bucket
+    {
+        std::vector<TType> Items;
+        size_t Front{};
+    };
+
+    std::vector<Bucket> _buckets;
+    uint32_t _headTick{};
+    uint32_t _endTick{};
+    size_t _size{};
+
+public:
+    using value_type = TType;
+
+    TickQueue()
+        : _buckets(16)
+    {
+    }
+
+    bool empty() const
+    {
+        return _size == 0;
+    }
+
+    size_t size() const
+    {
+        return _size;
+    }
+
+    TType& front()
+    {
+        auto& bucket = GetBucket(_headTick);
+        return bucket.Items[bucket.Front];
+    }
+
+    void push(uint32_t tick, TType&& value)
+    {
+        if (_size == 0)
+        {
+            _headTick = tick;
+            _endTick = tick + 1;
+        }
+        else if (tick < _headTick)
+        {
+            if (_endTick - tick > MaxSpan)
+                tick = _endTick - MaxSpan;
+            Reserve(_endTick - tick);
+            _headTick = tick;
+        }
+        else if (tick >= _endTick)
+        {
+            if (tick - _headTick >= MaxSpan)
+                tick = _headTick + MaxSpan - 1;
+            Reserve(tick + 1 - _headTick);
+            _endTick = tick + 1;
+        }
+
+        GetBucket(tick).Items.push_back(std::move(value));
+        _size++;
+    }
+
+    // Removes and returns the front item, items pushed while it is being processed are never moved.
+    TType pop()
+    {
+        auto& bucket = GetBucket(_headTick);
+        TType value = std::move(bucket.Items[bucket.Front]);
+        bucket.Front++;
+        _size--;
+
+        if (bucket.Front == bucket.Items.size())
+        {
+            bucket.Items.clear();
+            bucket.Front = 0;
+            AdvanceHead();
+        }
+        return value;
+    }
+
+    void clear()
+    {
+        for (auto& bucket : _buckets)
+        {
+            bucket.Items.clear();
+            bucket.Front = 0;
+        }
+        _size = 0;
+    }
+
+private:
+    Bucket& GetBucket(uint32_t tick)
+    {
+        return _buckets[tick & (_buckets.size() - 1)];
+    }
+
+    void AdvanceHead()
+    {
+        if (_size == 0)
+            return;
+
+        while (GetBucket(_headTick).Items.empty())
+        {
+            _headTick++;
+        }
+    }
+
+    // Makes sure the ring covers the given number of consecutive ticks starting anywhere.
+    void Reserve(size_t span)
+    {
+        if (span <= _buckets.size())
+            return;
+
+        size_t capacity = _buckets.size();
+        while (capacity < span)
+        {
+            capacity *= 2;
+        }
+
+        std::vector<Bucket> buckets(capacity);
+        for (uint32_t tick = _headTick; tick != _endTick; tick++)
+        {
+            buckets[tick & (capacity - 1)] = std::move(GetBucket(tick));
+        }
+        _buckets = std::move(buckets);
+    }
+};
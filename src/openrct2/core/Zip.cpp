@@ -10,8 +10,11 @@
 #include "Zip.h"
 
 #include "IStream.hpp"
+#include "MemoryMappedFile.h"
+#include "MemoryStream.h"
 
 #include <algorithm>
+#include <unordered_map>
 #ifndef __ANDROID__
 #    include <zip.h>
 #endif
@@ -74,8 +77,16 @@ private:
     ZIP_ACCESS _access;
     std::vector<std::vector<uint8_t>> _writeBuffers;
 
+    // Read only archives are memory mapped on demand so that stored (uncompressed) entries can be
+    // accessed in place.
+    std::string _path;
+    mutable std::unique_ptr<MemoryMappedFile> _mappedFile;
+    mutable std::unordered_map<std::string, uint64_t> _localHeaderOffsets;
+    mutable bool _mappingAttempted{};
+
 public:
     ZipArchive(std::string_view path, ZIP_ACCESS access)
+        : _path(path)
     {
         auto zipOpenMode = ZIP_RDONLY;
         if (access == ZIP_ACCESS::WRITE)
@@ -131,6 +142,13 @@ public:
         auto index = GetIndexFromPath(path);
         if (index.has_value())
         {
+            uint64_t storedSize{};
+            auto storedData = GetStoredFileData(index.value(), storedSize);
+            if (storedData != nullptr)
+            {
+                return std::vector<uint8_t>(storedData, storedData + storedSize);
+            }
+
             auto dataSize = GetFileSize(index.value());
             if (dataSize > 0 && dataSize < SIZE_MAX)
             {
@@ -155,6 +173,12 @@ public:
         auto index = GetIndexFromPath(path);
         if (index.has_value())
         {
+            uint64_t storedSize{};
+            auto storedData = GetStoredFileData(index.value(), storedSize);
+            if (storedData != nullptr)
+            {
+                return std::make_unique<MemoryStream>(storedData, static_cast<size_t>(storedSize));
+            }
             return std::make_unique<ZipItemStream>(_zip, index.value());
         }
         return {};
@@ -206,6 +230,122 @@ public:
     }
 
 private:
+    static uint16_t ReadUInt16(const uint8_t* data)
+    {
+        return static_cast<uint16_t>(data[0] | (data[1] << 8));
+    }
+
+    static uint32_t ReadUInt32(const uint8_t* data)
+    {
+        return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8)
+            | (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+    }
+
+    /**
+     * Maps the archive and reads the local header offsets of all stored entries from the central directory.
+     * ZIP64 archives are not supported and will always be read through libzip.
+     */
+    void MapArchive() const
+    {
+        _mappingAttempted = true;
+        try
+        {
+            auto mappedFile = std::make_unique<MemoryMappedFile>(_path);
+            auto data = static_cast<const uint8_t*>(mappedFile->GetData());
+            auto size = mappedFile->GetSize();
+
+            // Find the end of central directory record, it may be followed by a comment of up to 64 KiB
+            constexpr size_t EocdSize = 22;
+            if (size < EocdSize)
+                return;
+            size_t eocdOffset = size - EocdSize;
+            size_t searchEnd = size > EocdSize + 0xFFFF ? size - EocdSize - 0xFFFF : 0;
+            while (ReadUInt32(data + eocdOffset) != 0x06054B50)
+            {
+                if (eocdOffset == searchEnd)
+                    return;
+                eocdOffset--;
+            }
+
+            auto numEntries = ReadUInt16(data + eocdOffset + 10);
+            uint64_t cdOffset = ReadUInt32(data + eocdOffset + 16);
+            for (uint16_t i = 0; i < numEntries; i++)
+            {
+                if (cdOffset + 46 > size || ReadUInt32(data + cdOffset) != 0x02014B50)
+                    return;
+
+                auto entry = data + cdOffset;
+                auto method = ReadUInt16(entry + 10);
+                auto nameLength = ReadUInt16(entry + 28);
+                auto extraLength = ReadUInt16(entry + 30);
+                auto commentLength = ReadUInt16(entry + 32);
+                auto localHeaderOffset = ReadUInt32(entry + 42);
+                if (cdOffset + 46 + nameLength > size)
+                    return;
+
+                if (method == ZIP_CM_STORE && localHeaderOffset != 0xFFFFFFFF)
+                {
+                    auto name = std::string(reinterpret_cast<const char*>(entry + 46), nameLength);
+                    _localHeaderOffsets.emplace(std::move(name), localHeaderOffset);
+                }
+                cdOffset += 46 + nameLength + extraLength + commentLength;
+            }
+
+            _mappedFile = std::move(mappedFile);
+        }
+        catch (const std::exception& e)
+        {
+            log_verbose("Unable to map zip archive '%s': %s", _path.c_str(), e.what());
+            _localHeaderOffsets.clear();
+        }
+    }
+
+    /**
+     * Gets a pointer to the data of the given entry within the mapped archive if it is stored without
+     * compression or encryption, otherwise nullptr.
+     */
+    const uint8_t* GetStoredFileData(size_t index, uint64_t& size) const
+    {
+        if (_access != ZIP_ACCESS::READ)
+            return nullptr;
+
+        zip_stat_t zipFileStat{};
+        if (zip_stat_index(_zip, index, 0, &zipFileStat) != ZIP_ER_OK)
+            return nullptr;
+        if (!(zipFileStat.valid & ZIP_STAT_COMP_METHOD) || zipFileStat.comp_method != ZIP_CM_STORE)
+            return nullptr;
+        if ((zipFileStat.valid & ZIP_STAT_ENCRYPTION_METHOD) && zipFileStat.encryption_method != ZIP_EM_NONE)
+            return nullptr;
+
+        if (!_mappingAttempted)
+        {
+            MapArchive();
+        }
+        if (_mappedFile == nullptr)
+            return nullptr;
+
+        auto name = zip_get_name(_zip, index, ZIP_FL_ENC_RAW);
+        if (name == nullptr)
+            return nullptr;
+        auto it = _localHeaderOffsets.find(name);
+        if (it == _localHeaderOffsets.end())
+            return nullptr;
+
+        auto data = static_cast<const uint8_t*>(_mappedFile->GetData());
+        auto mappedSize = _mappedFile->GetSize();
+        auto localHeaderOffset = it->second;
+        if (localHeaderOffset + 30 > mappedSize || ReadUInt32(data + localHeaderOffset) != 0x04034B50)
+            return nullptr;
+
+        auto dataOffset = localHeaderOffset + 30 + ReadUInt16(data + localHeaderOffset + 26)
+            + ReadUInt16(data + localHeaderOffset + 28);
+        if (dataOffset + zipFileStat.size > mappedSize)
+            return nullptr;
+
+        size = zipFileStat.size;
+        return data + dataOffset;
+    }
+
     class ZipItemStream final : public IStream
     {
     private:
@@ -42,6 +42,90 @@ void mask_avx2(
     }
 }
 
+struct RemapTableAVX2
+{
+    // The 256 entries split into 16 registers, the high nibble of an index selects the register and the low nibble the
+    // entry within it. The tables are repeated in both 128-bit lanes as the shuffle does not cross them.
+    __m256i Parts[16];
+
+    RemapTableAVX2(const uint8_t* table)
+    {
+        for (int32_t i = 0; i < 16; i++)
+        {
+            Parts[i] = _mm256_broadcastsi128_si256(_mm_lddqu_si128(reinterpret_cast<const __m128i*>(table + (i * 16))));
+        }
+    }
+
+    __m256i Lookup(__m256i index) const
+    {
+        const __m256i nibbleMask = _mm256_set1_epi8(0x0F);
+        const __m256i low = _mm256_and_si256(index, nibbleMask);
+        const __m256i high = _mm256_and_si256(_mm256_srli_epi16(index, 4), nibbleMask);
+        __m256i result = _mm256_setzero_si256();
+        for (int32_t i = 0; i < 16; i++)
+        {
+            const __m256i select = _mm256_cmpeq_epi8(high, _mm256_set1_epi8(static_cast<char>(i)));
+            result = _mm256_or_si256(result, _mm256_and_si256(_mm256_shuffle_epi8(Parts[i], low), select));
+        }
+        return result;
+    }
+};
+
+void blit_run_transparent_avx2(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    int32_t i = 0;
+    for (; i + 32 <= count; i += 32)
+    {
+        const __m256i colour = _mm256_lddqu_si256(reinterpret_cast<const __m256i*>(src + i));
+        const __m256i dest = _mm256_lddqu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        const __m256i transparent = _mm256_cmpeq_epi8(colour, zero);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_blendv_epi8(colour, dest, transparent));
+    }
+    blit_run_transparent_scalar(src + i, dst + i, count - i);
+}
+
+void blit_run_remap_avx2(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const uint8_t* RESTRICT table)
+{
+    int32_t i = 0;
+    if (count >= 32)
+    {
+        const RemapTableAVX2 remap(table);
+        const __m256i zero = _mm256_setzero_si256();
+        for (; i + 32 <= count; i += 32)
+        {
+            const __m256i colour = _mm256_lddqu_si256(reinterpret_cast<const __m256i*>(src + i));
+            const __m256i dest = _mm256_lddqu_si256(reinterpret_cast<const __m256i*>(dst + i));
+            const __m256i remapped = remap.Lookup(colour);
+            // Transparent pixels and pixels remapped to 0 keep the destination.
+            const __m256i keep = _mm256_or_si256(_mm256_cmpeq_epi8(colour, zero), _mm256_cmpeq_epi8(remapped, zero));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_blendv_epi8(remapped, dest, keep));
+        }
+    }
+    blit_run_remap_scalar(src + i, dst + i, count - i, table);
+}
+
+void blit_run_remap_dst_avx2(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const uint8_t* RESTRICT table)
+{
+    int32_t i = 0;
+    if (count >= 32)
+    {
+        const RemapTableAVX2 remap(table);
+        const __m256i zero = _mm256_setzero_si256();
+        for (; i + 32 <= count; i += 32)
+        {
+            const __m256i colour = _mm256_lddqu_si256(reinterpret_cast<const __m256i*>(src + i));
+            const __m256i dest = _mm256_lddqu_si256(reinterpret_cast<const __m256i*>(dst + i));
+            const __m256i remapped = remap.Lookup(dest);
+            // Transparent pixels and pixels remapped to 0 keep the destination.
+            const __m256i keep = _mm256_or_si256(_mm256_cmpeq_epi8(colour, zero), _mm256_cmpeq_epi8(remapped, zero));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_blendv_epi8(remapped, dest, keep));
+        }
+    }
+    blit_run_remap_dst_scalar(src + i, dst + i, count - i, table);
+}
+
 #else
 
 #    ifdef OPENRCT2_X86
@@ -55,4 +139,20 @@ void mask_avx2(
     openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
 }
 
+void blit_run_transparent_avx2(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count)
+{
+    openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
+}
+
+void blit_run_remap_avx2(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const uint8_t* RESTRICT table)
+{
+    openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
+}
+
+void blit_run_remap_dst_avx2(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const uint8_t* RESTRICT table)
+{
+    openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
+}
+
 #endif // __AVX2__
@@ -51,9 +51,19 @@ template<DrawBlendOp TBlendOp> static void FASTCALL DrawBMPSpriteMinify(rct_draw
     {
         auto nextSrc = src + srcLineWidth;
         auto nextDst = dst + dstLineWidth;
-        for (int32_t widthRemaining = width; widthRemaining > 0; widthRemaining -= zoom, src += zoom, dst++)
+        if (zoom == 1)
         {
-            BlitPixel<TBlendOp>(src, dst, paletteMap);
+            if (width > 0)
+            {
+                BlitRun<TBlendOp>(src, dst, paletteMap, width);
+            }
+        }
+        else
+        {
+            for (int32_t widthRemaining = width; widthRemaining > 0; widthRemaining -= zoom, src += zoom, dst++)
+            {
+                BlitPixel<TBlendOp>(src, dst, paletteMap);
+            }
         }
         src = nextSrc;
         dst = nextDst;
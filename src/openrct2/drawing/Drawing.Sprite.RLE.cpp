@@ -163,6 +163,13 @@ static void FASTCALL DrawRLESpriteMinify(rct_drawpixelinfo& dpi, const DrawSprit
                     std::memcpy(dst, src, numPixels);
                 }
             }
+            else if constexpr (TZoom == 0)
+            {
+                if (numPixels > 0)
+                {
+                    BlitRun<TBlendOp>(src, dst, args.PalMap, numPixels);
+                }
+            }
             else
             {
                 auto& paletteMap = args.PalMap;
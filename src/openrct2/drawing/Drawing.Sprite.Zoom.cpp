@@ -0,0 +1,225 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2022 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "Drawing.h"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+// Sprites are drawn from several threads, the cache is split up so they rarely wait on each other.
+static constexpr size_t ZoomedSpriteCacheShards = 16;
+// Once a shard holds more than this many bytes of sprite data it is emptied and filled again by the sprites in view.
+static constexpr size_t ZoomedSpriteCacheShardBudget = (32 * 1024 * 1024) / ZoomedSpriteCacheShards;
+
+struct ZoomedSpriteCacheShard
+{
+    std::mutex Mutex;
+    std::unordered_map<uint32_t, std::shared_ptr<const ZoomedSprite>> Sprites;
+    size_t Size{};
+};
+
+static std::array<ZoomedSpriteCacheShard, ZoomedSpriteCacheShards> _zoomedSpriteCache;
+
+static uint32_t GetZoomedSpriteKey(ImageIndex imageIndex, int32_t levels)
+{
+    return (static_cast<uint32_t>(imageIndex) << 2) | static_cast<uint32_t>(levels);
+}
+
+static ZoomedSpriteCacheShard& GetZoomedSpriteCacheShard(ImageIndex imageIndex)
+{
+    // Keep all levels of an image in the same shard so it can be invalidated with one lock.
+    return _zoomedSpriteCache[imageIndex % ZoomedSpriteCacheShards];
+}
+
+static bool IsSameSprite(const rct_g1_element& a, const rct_g1_element& b)
+{
+    return a.offset == b.offset && a.width == b.width && a.height == b.height && a.x_offset == b.x_offset
+        && a.y_offset == b.y_offset && a.flags == b.flags;
+}
+
+static std::vector<uint8_t> DecodeRLESprite(const rct_g1_element& g1)
+{
+    std::vector<uint8_t> pixels(static_cast<size_t>(g1.width) * g1.height);
+    for (int32_t y = 0; y < g1.height; y++)
+    {
+        uint16_t lineOffset = g1.offset[y * 2] | (g1.offset[y * 2 + 1] << 8);
+        auto nextRun = g1.offset + lineOffset;
+        bool isEndOfLine = false;
+        while (!isEndOfLine)
+        {
+            auto src = nextRun;
+            auto dataSize = *src++;
+            auto firstPixelX = *src++;
+            isEndOfLine = (dataSize & 0x80) != 0;
+            dataSize &= 0x7F;
+            nextRun = src + dataSize;
+
+            auto numPixels = std::min<int32_t>(dataSize, g1.width - firstPixelX);
+            if (numPixels > 0)
+            {
+                std::copy_n(src, numPixels, pixels.begin() + (static_cast<size_t>(y) * g1.width) + firstPixelX);
+            }
+        }
+    }
+    return pixels;
+}
+
+static void EncodeRLELine(std::vector<uint8_t>& data, const uint8_t* line, int32_t width)
+{
+    std::optional<size_t> lastRun;
+    int32_t x = 0;
+    while (x < width)
+    {
+        if (line[x] == 0)
+        {
+            x++;
+            continue;
+        }
+
+        // Runs are limited to 127 pixels by the length byte, its top bit marks the last run of the line.
+        int32_t runStart = x;
+        while (x < width && line[x] != 0 && x - runStart < 0x7F)
+        {
+            x++;
+        }
+        lastRun = data.size();
+        data.push_back(static_cast<uint8_t>(x - runStart));
+        data.push_back(static_cast<uint8_t>(runStart));
+        data.insert(data.end(), line + runStart, line + x);
+    }
+
+    if (lastRun.has_value())
+    {
+        data[*lastRun] |= 0x80;
+    }
+    else
+    {
+        // An empty run marks an empty line.
+        data.push_back(0x80);
+        data.push_back(0);
+    }
+}
+
+static std::shared_ptr<const ZoomedSprite> CreateZoomedSprite(const rct_g1_element& g1, int32_t levels)
+{
+    const int32_t scale = 1 << levels;
+
+    // Pick the offsets of the zoomed sprite so its pixels line up with the zoomed out screen pixels of a sprite drawn at a
+    // multiple of the scale, the source pixels to sample start at these remainders.
+    const int32_t xOffset = (g1.x_offset + scale - 1) >> levels;
+    const int32_t yOffset = (g1.y_offset + scale - 1) >> levels;
+    const int32_t xStart = (xOffset << levels) - g1.x_offset;
+    const int32_t yStart = (yOffset << levels) - g1.y_offset;
+    const int32_t width = g1.width > xStart ? (g1.width - xStart + scale - 1) >> levels : 0;
+    const int32_t height = g1.height > yStart ? (g1.height - yStart + scale - 1) >> levels : 0;
+    if (width > std::numeric_limits<uint8_t>::max() + 1)
+        return nullptr;
+
+    auto pixels = DecodeRLESprite(g1);
+
+    auto sprite = std::make_shared<ZoomedSprite>();
+    sprite->Source = g1;
+    auto& data = sprite->Data;
+    data.resize(static_cast<size_t>(height) * 2);
+    std::vector<uint8_t> line(width);
+    for (int32_t y = 0; y < height; y++)
+    {
+        const auto lineOffset = data.size();
+        if (lineOffset > std::numeric_limits<uint16_t>::max())
+            return nullptr;
+        data[y * 2] = static_cast<uint8_t>(lineOffset & 0xFF);
+        data[y * 2 + 1] = static_cast<uint8_t>(lineOffset >> 8);
+
+        const auto* src = pixels.data() + (static_cast<size_t>(yStart + (y << levels)) * g1.width) + xStart;
+        for (int32_t x = 0; x < width; x++)
+        {
+            line[x] = src[x << levels];
+        }
+        EncodeRLELine(data, line.data(), width);
+    }
+
+    sprite->Element.offset = data.data();
+    sprite->Element.width = width;
+    sprite->Element.height = height;
+    sprite->Element.x_offset = xOffset;
+    sprite->Element.y_offset = yOffset;
+    sprite->Element.flags = G1_FLAG_RLE_COMPRESSION;
+    return sprite;
+}
+
+std::shared_ptr<const ZoomedSprite> gfx_get_zoomed_sprite(ImageIndex imageIndex, const rct_g1_element& g1, ZoomLevel zoom)
+{
+    const auto levels = static_cast<int8_t>(zoom);
+    if (levels <= 0 || levels > static_cast<int8_t>(ZoomLevel::max()) || !(g1.flags & G1_FLAG_RLE_COMPRESSION))
+        return nullptr;
+
+    const auto key = GetZoomedSpriteKey(imageIndex, levels);
+    auto& shard = GetZoomedSpriteCacheShard(imageIndex);
+    {
+        std::lock_guard<std::mutex> lock(shard.Mutex);
+        auto it = shard.Sprites.find(key);
+        if (it != shard.Sprites.end() && IsSameSprite(it->second->Source, g1))
+        {
+            return it->second;
+        }
+    }
+
+    // Built without holding the lock, if another thread got there first its copy is kept.
+    auto sprite = CreateZoomedSprite(g1, levels);
+    if (sprite == nullptr)
+        return nullptr;
+
+    std::lock_guard<std::mutex> lock(shard.Mutex);
+    if (shard.Size + sprite->Data.size() > ZoomedSpriteCacheShardBudget)
+    {
+        shard.Sprites.clear();
+        shard.Size = 0;
+    }
+    auto& entry = shard.Sprites[key];
+    if (entry == nullptr || !IsSameSprite(entry->Source, g1))
+    {
+        if (entry != nullptr)
+            shard.Size -= entry->Data.size();
+        entry = sprite;
+        shard.Size += sprite->Data.size();
+    }
+    return entry;
+}
+
+void gfx_invalidate_zoomed_sprites(ImageIndex imageIndex)
+{
+    auto& shard = GetZoomedSpriteCacheShard(imageIndex);
+    std::lock_guard<std::mutex> lock(shard.Mutex);
+    if (shard.Sprites.empty())
+        return;
+
+    for (int32_t levels = 1; levels <= static_cast<int8_t>(ZoomLevel::max()); levels++)
+    {
+        auto it = shard.Sprites.find(GetZoomedSpriteKey(imageIndex, levels));
+        if (it != shard.Sprites.end())
+        {
+            shard.Size -= it->second->Data.size();
+            shard.Sprites.erase(it);
+        }
+    }
+}
+
+void gfx_clear_zoomed_sprites()
+{
+    for (auto& shard : _zoomedSpriteCache)
+    {
+        std::lock_guard<std::mutex> lock(shard.Mutex);
+        shard.Sprites.clear();
+        shard.Size = 0;
+    }
+}
@@ -180,6 +180,48 @@ void mask_scalar(
     }
 }
 
+void blit_run_transparent_scalar(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count)
+{
+    for (int32_t i = 0; i < count; i++)
+    {
+        if (src[i] != 0)
+        {
+            dst[i] = src[i];
+        }
+    }
+}
+
+void blit_run_remap_scalar(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const uint8_t* RESTRICT table)
+{
+    for (int32_t i = 0; i < count; i++)
+    {
+        if (src[i] != 0)
+        {
+            uint8_t colour = table[src[i]];
+            if (colour != 0)
+            {
+                dst[i] = colour;
+            }
+        }
+    }
+}
+
+void blit_run_remap_dst_scalar(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const uint8_t* RESTRICT table)
+{
+    for (int32_t i = 0; i < count; i++)
+    {
+        if (src[i] != 0)
+        {
+            uint8_t colour = table[dst[i]];
+            if (colour != 0)
+            {
+                dst[i] = colour;
+            }
+        }
+    }
+}
+
 static rct_gx _g1 = {};
 static rct_gx _g2 = {};
 static rct_gx _csg = {};
@@ -243,6 +285,7 @@ bool gfx_load_g1(const IPlatformEnvironment& env)
 
 void gfx_unload_g1()
 {
+    gfx_clear_zoomed_sprites();
     _g1.data.reset();
     _g1.elements.clear();
     _g1.elements.shrink_to_fit();
@@ -250,6 +293,7 @@ void gfx_unload_g1()
 
 void gfx_unload_g2()
 {
+    gfx_clear_zoomed_sprites();
     _g2.data.reset();
     _g2.elements.clear();
     _g2.elements.shrink_to_fit();
@@ -257,6 +301,7 @@ void gfx_unload_g2()
 
 void gfx_unload_csg()
 {
+    gfx_clear_zoomed_sprites();
     _csg.data.reset();
     _csg.elements.clear();
     _csg.elements.shrink_to_fit();
@@ -457,6 +502,10 @@ void FASTCALL gfx_draw_sprite_software(rct_drawpixelinfo* dpi, const ImageId& im
     }
 }
 
+static void FASTCALL gfx_draw_sprite_element_software(
+    rct_drawpixelinfo* dpi, const ImageId& imageId, const rct_g1_element& g1Element, const ScreenCoordsXY& coords,
+    const PaletteMap& paletteMap);
+
 /*
  * rct: 0x0067A46E
  * image_id (ebx) and also (0x00EDF81C)
@@ -500,6 +549,37 @@ void FASTCALL gfx_draw_sprite_palette_set_software(
         return;
     }
 
+    if (dpi->zoom_level > ZoomLevel{ 0 } && (g1->flags & G1_FLAG_RLE_COMPRESSION))
+    {
+        // Like a zoom sprite, but downsampled on demand.
+        auto zoomedSprite = gfx_get_zoomed_sprite(imageId.GetIndex(), *g1, dpi->zoom_level);
+        if (zoomedSprite != nullptr)
+        {
+            const auto levels = static_cast<int8_t>(dpi->zoom_level);
+            rct_drawpixelinfo zoomed_dpi = *dpi;
+            zoomed_dpi.x = dpi->x >> levels;
+            zoomed_dpi.y = dpi->y >> levels;
+            zoomed_dpi.height = dpi->height >> levels;
+            zoomed_dpi.width = dpi->width >> levels;
+            zoomed_dpi.zoom_level = ZoomLevel{ 0 };
+
+            const auto spriteCoords = ScreenCoordsXY{ x >> levels, y >> levels };
+            gfx_draw_sprite_element_software(&zoomed_dpi, imageId, zoomedSprite->Element, spriteCoords, paletteMap);
+            return;
+        }
+    }
+
+    gfx_draw_sprite_element_software(dpi, imageId, *g1, coords, paletteMap);
+}
+
+static void FASTCALL gfx_draw_sprite_element_software(
+    rct_drawpixelinfo* dpi, const ImageId& imageId, const rct_g1_element& g1Element, const ScreenCoordsXY& coords,
+    const PaletteMap& paletteMap)
+{
+    const auto* g1 = &g1Element;
+    int32_t x = coords.x;
+    int32_t y = coords.y;
+
     // Its used super often so we will define it to a separate variable.
     const auto zoom_level = dpi->zoom_level;
     const int32_t zoom_mask = zoom_level > ZoomLevel{ 0 } ? zoom_level.ApplyTo(0xFFFFFFFF) : 0xFFFFFFFF;
@@ -775,6 +855,7 @@ void gfx_set_g1_element(ImageIndex imageId, const rct_g1_element* g1)
 
     if (g1 != nullptr)
     {
+        gfx_invalidate_zoomed_sprites(imageId);
         if (isTemp)
         {
             _g1Temp = *g1;
@@ -30,17 +30,16 @@ GamePalette gPalette;
 
 const PaletteMap& PaletteMap::GetDefault()
 {
-    static bool initialised = false;
+    // Sprites are drawn from several threads, so the map is set up by the initialiser of a local static which only
+    // ever runs once.
     static uint8_t data[256];
-    static PaletteMap defaultMap(data);
-    if (!initialised)
-    {
+    static const PaletteMap defaultMap = [] {
         for (size_t i = 0; i < sizeof(data); i++)
         {
             data[i] = static_cast<uint8_t>(i);
         }
-        initialised = true;
-    }
+        return PaletteMap(data);
+    }();
     return defaultMap;
 }
 
@@ -80,6 +79,11 @@ uint8_t PaletteMap::Blend(uint8_t src, uint8_t dst) const
     return (*this)[idx];
 }
 
+const uint8_t* PaletteMap::GetTable() const
+{
+    return _dataLength >= 256 ? _data : nullptr;
+}
+
 void PaletteMap::Copy(size_t dstIndex, const PaletteMap& src, size_t srcIndex, size_t length)
 {
     auto maxLength = std::min(_mapLength - srcIndex, _mapLength - dstIndex);
@@ -141,7 +145,7 @@ thread_local uint8_t gOtherPalette[256] = {
 };
 
 // Originally 0x9ABE04
-uint8_t gTextPalette[0x8] = {
+thread_local uint8_t gTextPalette[0x8] = {
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
@@ -578,6 +582,38 @@ void mask_init()
     }
 }
 
+void (*blit_run_transparent_fn)(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count) = nullptr;
+void (*blit_run_remap_fn)(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const uint8_t* RESTRICT table)
+    = nullptr;
+void (*blit_run_remap_dst_fn)(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const uint8_t* RESTRICT table)
+    = nullptr;
+
+void blit_run_init()
+{
+    if (avx2_available())
+    {
+        log_verbose("registering AVX2 run blitters");
+        blit_run_transparent_fn = blit_run_transparent_avx2;
+        blit_run_remap_fn = blit_run_remap_avx2;
+        blit_run_remap_dst_fn = blit_run_remap_dst_avx2;
+    }
+    else if (sse41_available())
+    {
+        log_verbose("registering SSE4.1 run blitters");
+        blit_run_transparent_fn = blit_run_transparent_sse4_1;
+        blit_run_remap_fn = blit_run_remap_sse4_1;
+        blit_run_remap_dst_fn = blit_run_remap_dst_sse4_1;
+    }
+    else
+    {
+        log_verbose("registering scalar run blitters");
+        blit_run_transparent_fn = blit_run_transparent_scalar;
+        blit_run_remap_fn = blit_run_remap_scalar;
+        blit_run_remap_dst_fn = blit_run_remap_dst_scalar;
+    }
+}
+
 void gfx_filter_pixel(rct_drawpixelinfo* dpi, const ScreenCoordsXY& coords, FilterPaletteID palette)
 {
     gfx_filter_rect(dpi, { coords, coords }, palette);
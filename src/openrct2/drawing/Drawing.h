@@ -18,6 +18,7 @@
 #include "ImageId.hpp"
 #include "Text.h"
 
+#include <cstring>
 #include <memory>
 #include <optional>
 #include <vector>
@@ -360,6 +361,13 @@ public:
     uint8_t& operator[](size_t index);
     uint8_t operator[](size_t index) const;
     uint8_t Blend(uint8_t src, uint8_t dst) const;
+
+    /**
+     * Returns the first map as a plain table of 256 entries for the run blitters, or nullptr if it is shorter than
+     * that and out of range indices have to go through operator[].
+     */
+    const uint8_t* GetTable() const;
+
     void Copy(size_t dstIndex, const PaletteMap& src, size_t srcIndex, size_t length);
 };
 
@@ -461,6 +469,71 @@ void FASTCALL BlitPixels(const uint8_t* src, uint8_t* dst, const PaletteMap& pal
     }
 }
 
+void blit_run_transparent_scalar(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count);
+void blit_run_transparent_sse4_1(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count);
+void blit_run_transparent_avx2(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count);
+void blit_run_remap_scalar(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const uint8_t* RESTRICT table);
+void blit_run_remap_sse4_1(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const uint8_t* RESTRICT table);
+void blit_run_remap_avx2(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const uint8_t* RESTRICT table);
+void blit_run_remap_dst_scalar(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const uint8_t* RESTRICT table);
+void blit_run_remap_dst_sse4_1(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const uint8_t* RESTRICT table);
+void blit_run_remap_dst_avx2(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const uint8_t* RESTRICT table);
+void blit_run_init();
+
+// Copies the non-transparent pixels of a run.
+extern void (*blit_run_transparent_fn)(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count);
+// Copies the non-transparent pixels of a run re-coloured through the table, pixels that map to 0 are skipped.
+extern void (*blit_run_remap_fn)(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const uint8_t* RESTRICT table);
+// Re-colours the destination through the table under the non-transparent pixels of a run, e.g. for glass.
+extern void (*blit_run_remap_dst_fn)(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const uint8_t* RESTRICT table);
+
+/**
+ * Draws a run of consecutive source pixels to consecutive destination pixels, the same as calling BlitPixel for each of
+ * them. Uses the vectorised run blitters where there is one for the blend op and palette map.
+ */
+template<DrawBlendOp TBlendOp>
+void FASTCALL BlitRun(const uint8_t* src, uint8_t* dst, const PaletteMap& paletteMap, int32_t count)
+{
+    if constexpr (TBlendOp == BLEND_NONE)
+    {
+        std::memcpy(dst, src, count);
+        return;
+    }
+    else if constexpr (TBlendOp == BLEND_TRANSPARENT)
+    {
+        blit_run_transparent_fn(src, dst, count);
+        return;
+    }
+    else if constexpr (TBlendOp == (BLEND_TRANSPARENT | BLEND_SRC))
+    {
+        if (auto table = paletteMap.GetTable(); table != nullptr)
+        {
+            blit_run_remap_fn(src, dst, count, table);
+            return;
+        }
+    }
+    else if constexpr (TBlendOp == (BLEND_TRANSPARENT | BLEND_DST))
+    {
+        if (auto table = paletteMap.GetTable(); table != nullptr)
+        {
+            blit_run_remap_dst_fn(src, dst, count, table);
+            return;
+        }
+    }
+
+    // Blending source and destination picks one of many maps per pixel, which has no vectorised form. Maps shorter than
+    // a full table need the range checks of operator[].
+    for (int32_t i = 0; i < count; i++)
+    {
+        BlitPixel<TBlendOp>(src + i, dst + i, paletteMap);
+    }
+}
+
 #define PALETTE_TO_G1_OFFSET_COUNT 144
 
 #define INSET_RECT_F_30 (INSET_RECT_FLAG_BORDER_INSET | INSET_RECT_FLAG_FILL_NONE)
@@ -475,7 +548,7 @@ extern uint32_t gPaletteEffectFrame;
 extern const FilterPaletteID GlassPaletteIds[COLOUR_COUNT];
 extern thread_local uint8_t gPeepPalette[256];
 extern thread_local uint8_t gOtherPalette[256];
-extern uint8_t gTextPalette[];
+extern thread_local uint8_t gTextPalette[];
 extern const translucent_window_palette TranslucentWindowPalettes[COLOUR_COUNT];
 
 extern ImageId gPickupPeepImage;
@@ -520,6 +593,21 @@ void gfx_unload_csg();
 const rct_g1_element* gfx_get_g1_element(const ImageId& imageId);
 const rct_g1_element* gfx_get_g1_element(ImageIndex image_id);
 void gfx_set_g1_element(ImageIndex imageId, const rct_g1_element* g1);
+
+/**
+ * A copy of an RLE sprite downsampled for a zoom level it has no zoomed image for, so it can be drawn at 1:1 rather than
+ * skipping over most of the pixels of the full size sprite.
+ */
+struct ZoomedSprite
+{
+    rct_g1_element Element;
+    std::vector<uint8_t> Data;
+    rct_g1_element Source;
+};
+
+std::shared_ptr<const ZoomedSprite> gfx_get_zoomed_sprite(ImageIndex imageIndex, const rct_g1_element& g1, ZoomLevel zoom);
+void gfx_invalidate_zoomed_sprites(ImageIndex imageIndex);
+void gfx_clear_zoomed_sprites();
 std::optional<rct_gx> GfxLoadGx(const std::vector<uint8_t>& buffer);
 bool is_csg_loaded();
 void FASTCALL gfx_sprite_to_buffer(rct_drawpixelinfo& dpi, const DrawSpriteArgs& args);
@@ -28,6 +28,7 @@
 #include <algorithm>
 #include <cmath>
 #include <cstring>
+#include <mutex>
 
 static uint8_t _bakedLightTexture_lantern_0[32 * 32];
 static uint8_t _bakedLightTexture_lantern_1[64 * 64];
@@ -73,6 +74,9 @@ static LightListEntry* _LightListFront;
 static uint32_t LightListCurrentCountBack;
 static uint32_t LightListCurrentCountFront;
 
+// Lights are added while the columns of a viewport are painted on several threads.
+static std::mutex _lightListBackMutex;
+
 static int16_t _current_view_x_front = 0;
 static int16_t _current_view_y_front = 0;
 static uint8_t _current_view_rotation_front = 0;
@@ -629,6 +633,8 @@ static void LightfxAdd3DLight(
     const uint32_t lightHash, const LightFXQualifier qualifier, const uint8_t id, const CoordsXYZ& loc,
     const LightType lightType)
 {
+    std::lock_guard<std::mutex> lock(_lightListBackMutex);
+
     if (LightListCurrentCountBack == 15999)
     {
         return;
@@ -56,6 +56,90 @@ void mask_sse4_1(
     }
 }
 
+struct RemapTableSSE41
+{
+    // The 256 entries split into 16 registers, the high nibble of an index selects the register and the low nibble the
+    // entry within it.
+    __m128i Parts[16];
+
+    RemapTableSSE41(const uint8_t* table)
+    {
+        for (int32_t i = 0; i < 16; i++)
+        {
+            Parts[i] = _mm_lddqu_si128(reinterpret_cast<const __m128i*>(table + (i * 16)));
+        }
+    }
+
+    __m128i Lookup(__m128i index) const
+    {
+        const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+        const __m128i low = _mm_and_si128(index, nibbleMask);
+        const __m128i high = _mm_and_si128(_mm_srli_epi16(index, 4), nibbleMask);
+        __m128i result = _mm_setzero_si128();
+        for (int32_t i = 0; i < 16; i++)
+        {
+            const __m128i select = _mm_cmpeq_epi8(high, _mm_set1_epi8(static_cast<char>(i)));
+            result = _mm_or_si128(result, _mm_and_si128(_mm_shuffle_epi8(Parts[i], low), select));
+        }
+        return result;
+    }
+};
+
+void blit_run_transparent_sse4_1(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count)
+{
+    const __m128i zero = _mm_setzero_si128();
+    int32_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m128i colour = _mm_lddqu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i dest = _mm_lddqu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        const __m128i transparent = _mm_cmpeq_epi8(colour, zero);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_blendv_epi8(colour, dest, transparent));
+    }
+    blit_run_transparent_scalar(src + i, dst + i, count - i);
+}
+
+void blit_run_remap_sse4_1(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const uint8_t* RESTRICT table)
+{
+    int32_t i = 0;
+    if (count >= 16)
+    {
+        const RemapTableSSE41 remap(table);
+        const __m128i zero = _mm_setzero_si128();
+        for (; i + 16 <= count; i += 16)
+        {
+            const __m128i colour = _mm_lddqu_si128(reinterpret_cast<const __m128i*>(src + i));
+            const __m128i dest = _mm_lddqu_si128(reinterpret_cast<const __m128i*>(dst + i));
+            const __m128i remapped = remap.Lookup(colour);
+            // Transparent pixels and pixels remapped to 0 keep the destination.
+            const __m128i keep = _mm_or_si128(_mm_cmpeq_epi8(colour, zero), _mm_cmpeq_epi8(remapped, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_blendv_epi8(remapped, dest, keep));
+        }
+    }
+    blit_run_remap_scalar(src + i, dst + i, count - i, table);
+}
+
+void blit_run_remap_dst_sse4_1(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const uint8_t* RESTRICT table)
+{
+    int32_t i = 0;
+    if (count >= 16)
+    {
+        const RemapTableSSE41 remap(table);
+        const __m128i zero = _mm_setzero_si128();
+        for (; i + 16 <= count; i += 16)
+        {
+            const __m128i colour = _mm_lddqu_si128(reinterpret_cast<const __m128i*>(src + i));
+            const __m128i dest = _mm_lddqu_si128(reinterpret_cast<const __m128i*>(dst + i));
+            const __m128i remapped = remap.Lookup(dest);
+            // Transparent pixels and pixels remapped to 0 keep the destination.
+            const __m128i keep = _mm_or_si128(_mm_cmpeq_epi8(colour, zero), _mm_cmpeq_epi8(remapped, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_blendv_epi8(remapped, dest, keep));
+        }
+    }
+    blit_run_remap_dst_scalar(src + i, dst + i, count - i, table);
+}
+
 #else
 
 #    ifdef OPENRCT2_X86
@@ -69,4 +153,20 @@ void mask_sse4_1(
     openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
 }
 
+void blit_run_transparent_sse4_1(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+}
+
+void blit_run_remap_sse4_1(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const uint8_t* RESTRICT table)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+}
+
+void blit_run_remap_dst_sse4_1(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const uint8_t* RESTRICT table)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+}
+
 #endif // __SSE4_1__
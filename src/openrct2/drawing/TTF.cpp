@@ -33,7 +33,8 @@ static bool _ttfInitialised = false;
 
 struct ttf_cache_entry
 {
-    TTFSurface* surface;
+    // Shared with the threads still drawing it, so evicting an entry never frees a surface in use.
+    std::shared_ptr<const TTFSurface> surface;
     TTF_Font* font;
     utf8* text;
     uint32_t lastUseTick;
@@ -196,7 +197,6 @@ static void ttf_surface_cache_dispose(ttf_cache_entry* entry)
 {
     if (entry->surface != nullptr)
     {
-        ttf_free_surface(entry->surface);
         free(entry->text);
 
         entry->surface = nullptr;
@@ -220,7 +220,7 @@ void ttf_toggle_hinting()
     ttf_toggle_hinting(true);
 }
 
-TTFSurface* ttf_surface_cache_get_or_add(TTF_Font* font, std::string_view text)
+std::shared_ptr<const TTFSurface> ttf_surface_cache_get_or_add(TTF_Font* font, std::string_view text)
 {
     ttf_cache_entry* entry;
 
@@ -268,7 +268,9 @@ TTFSurface* ttf_surface_cache_get_or_add(TTF_Font* font, std::string_view text)
     // printf("CACHE HITS: %d   MISSES: %d)\n", _ttfSurfaceCacheHitCount, _ttfSurfaceCacheMissCount);
 
     _ttfSurfaceCacheCount++;
-    entry->surface = surface;
+    entry->surface = std::shared_ptr<const TTFSurface>(surface, [](const TTFSurface* freed) {
+        ttf_free_surface(const_cast<TTFSurface*>(freed));
+    });
     entry->font = font;
     entry->text = strndup(text.data(), text.size());
     entry->lastUseTick = gCurrentDrawCount;
@@ -11,6 +11,7 @@
 
 #include "Font.h"
 
+#include <memory>
 #include <string_view>
 
 bool ttf_initialise();
@@ -28,7 +29,8 @@ struct TTFSurface
 
 TTFFontDescriptor* ttf_get_font_from_sprite_base(FontStyle fontStyle);
 void ttf_toggle_hinting();
-TTFSurface* ttf_surface_cache_get_or_add(TTF_Font* font, std::string_view text);
+// The surface stays valid while it is held, even if another thread evicts it from the cache in the meantime.
+std::shared_ptr<const TTFSurface> ttf_surface_cache_get_or_add(TTF_Font* font, std::string_view text);
 uint32_t ttf_getwidth_cache_get_or_add(TTF_Font* font, std::string_view text);
 bool ttf_provides_glyph(const TTF_Font* font, codepoint_t codepoint);
 void ttf_free_surface(TTFSurface* surface);
@@ -17,6 +17,7 @@
 #include "../interface/Screenshot.h"
 #include "../interface/Viewport.h"
 #include "../interface/Window.h"
+#include "../profiling/Profiling.h"
 #include "../ui/UiContext.h"
 #include "../util/Util.h"
 #include "../world/Climate.h"
@@ -33,6 +34,66 @@ using namespace OpenRCT2;
 using namespace OpenRCT2::Drawing;
 using namespace OpenRCT2::Ui;
 
+// Each dirty rect is drawn on its own, which costs about as much as drawing this many extra pixels (mostly walking the
+// tile columns behind the viewports). Two rects are merged when that adds fewer pixels than it saves.
+static constexpr int64_t DirtyRectDrawOverhead = 128 * 64;
+
+// Beyond this many rects the next one is merged with whichever rect grows the least.
+static constexpr size_t MaxDirtyRects = 64;
+
+static Profiling::Counter _dirtyRectCount("X8DrawingEngine dirty rects");
+static Profiling::Counter _dirtyPixelCount("X8DrawingEngine repainted pixels");
+
+static int64_t GetArea(const ScreenRect& rect)
+{
+    return static_cast<int64_t>(rect.GetWidth()) * rect.GetHeight();
+}
+
+static ScreenRect GetUnion(const ScreenRect& a, const ScreenRect& b)
+{
+    return { std::min(a.GetLeft(), b.GetLeft()), std::min(a.GetTop(), b.GetTop()), std::max(a.GetRight(), b.GetRight()),
+             std::max(a.GetBottom(), b.GetBottom()) };
+}
+
+// Returns how many more pixels are drawn if a and b are drawn as their union rather than on their own.
+static int64_t GetMergeCost(const ScreenRect& a, const ScreenRect& b)
+{
+    const auto overlapWidth = std::min(a.GetRight(), b.GetRight()) - std::max(a.GetLeft(), b.GetLeft());
+    const auto overlapHeight = std::min(a.GetBottom(), b.GetBottom()) - std::max(a.GetTop(), b.GetTop());
+    const int64_t overlap = overlapWidth > 0 && overlapHeight > 0 ? static_cast<int64_t>(overlapWidth) * overlapHeight : 0;
+    return GetArea(GetUnion(a, b)) - (GetArea(a) + GetArea(b) - overlap) - DirtyRectDrawOverhead;
+}
+
+static void AddDirtyRect(std::vector<ScreenRect>& rects, ScreenRect rect)
+{
+    // A merged rect can be worth merging with rects it was not before, keep going until it settles.
+    for (size_t i = 0; i < rects.size();)
+    {
+        if (GetMergeCost(rects[i], rect) <= 0)
+        {
+            rect = GetUnion(rects[i], rect);
+            rects[i] = rects.back();
+            rects.pop_back();
+            i = 0;
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    if (rects.size() >= MaxDirtyRects)
+    {
+        auto cheapest = std::min_element(rects.begin(), rects.end(), [&rect](const ScreenRect& a, const ScreenRect& b) {
+            return GetMergeCost(a, rect) < GetMergeCost(b, rect);
+        });
+        rect = GetUnion(*cheapest, rect);
+        *cheapest = rects.back();
+        rects.pop_back();
+    }
+    rects.push_back(rect);
+}
+
 X8WeatherDrawer::X8WeatherDrawer()
 {
     _weatherPixels = new WeatherPixel[_weatherPixelsCapacity];
@@ -129,7 +190,6 @@ X8DrawingEngine::X8DrawingEngine([[maybe_unused]] const std::shared_ptr<Ui::IUiC
 X8DrawingEngine::~X8DrawingEngine()
 {
     delete _drawingContext;
-    delete[] _dirtyGrid.Blocks;
     delete[] _bits;
 }
 
@@ -164,24 +224,7 @@ void X8DrawingEngine::Invalidate(int32_t left, int32_t top, int32_t right, int32
     if (top >= bottom)
         return;
 
-    right--;
-    bottom--;
-
-    left >>= _dirtyGrid.BlockShiftX;
-    right >>= _dirtyGrid.BlockShiftX;
-    top >>= _dirtyGrid.BlockShiftY;
-    bottom >>= _dirtyGrid.BlockShiftY;
-
-    uint32_t dirtyBlockColumns = _dirtyGrid.BlockColumns;
-    uint8_t* screenDirtyBlocks = _dirtyGrid.Blocks;
-    for (int16_t y = top; y <= bottom; y++)
-    {
-        uint32_t yOffset = y * dirtyBlockColumns;
-        for (int16_t x = left; x <= right; x++)
-        {
-            screenDirtyBlocks[yOffset + x] = 0xFF;
-        }
-    }
+    AddDirtyRect(_dirtyRects, { left, top, right, bottom });
 }
 
 void X8DrawingEngine::BeginDraw()
@@ -207,9 +250,12 @@ void X8DrawingEngine::PaintWindows()
 
     // Redraw dirty regions before updating the viewports, otherwise
     // when viewports get panned, they copy dirty pixels
-    DrawAllDirtyBlocks();
+    DrawAllDirtyRects();
     window_update_all_viewports();
-    DrawAllDirtyBlocks();
+    DrawAllDirtyRects();
+
+    _dirtyRectCount.EndFrame();
+    _dirtyPixelCount.EndFrame();
 }
 
 void X8DrawingEngine::PaintWeather()
@@ -336,7 +382,7 @@ void X8DrawingEngine::ConfigureBits(uint32_t width, uint32_t height, uint32_t pi
     dpi->height = height;
     dpi->pitch = _pitch - width;
 
-    ConfigureDirtyGrid();
+    _dirtyRects.clear();
 
     if (lightfx_is_available())
     {
@@ -344,100 +390,38 @@ void X8DrawingEngine::ConfigureBits(uint32_t width, uint32_t height, uint32_t pi
     }
 }
 
-void X8DrawingEngine::OnDrawDirtyBlock(
-    [[maybe_unused]] uint32_t x, [[maybe_unused]] uint32_t y, [[maybe_unused]] uint32_t columns, [[maybe_unused]] uint32_t rows)
+void X8DrawingEngine::OnDrawDirtyRect([[maybe_unused]] const ScreenRect& rect)
 {
 }
 
-void X8DrawingEngine::ConfigureDirtyGrid()
+void X8DrawingEngine::DrawAllDirtyRects()
 {
-    _dirtyGrid.BlockShiftX = 7;
-    _dirtyGrid.BlockShiftY = 6;
-    _dirtyGrid.BlockWidth = 1 << _dirtyGrid.BlockShiftX;
-    _dirtyGrid.BlockHeight = 1 << _dirtyGrid.BlockShiftY;
-    _dirtyGrid.BlockColumns = (_width >> _dirtyGrid.BlockShiftX) + 1;
-    _dirtyGrid.BlockRows = (_height >> _dirtyGrid.BlockShiftY) + 1;
-
-    delete[] _dirtyGrid.Blocks;
-    _dirtyGrid.Blocks = new uint8_t[_dirtyGrid.BlockColumns * _dirtyGrid.BlockRows];
-}
-
-void X8DrawingEngine::DrawAllDirtyBlocks()
-{
-    for (uint32_t x = 0; x < _dirtyGrid.BlockColumns; x++)
+    // Drawing can invalidate more areas, those are left for the next pass.
+    auto rects = std::move(_dirtyRects);
+    _dirtyRects.clear();
+    for (const auto& rect : rects)
     {
-        for (uint32_t y = 0; y < _dirtyGrid.BlockRows; y++)
-        {
-            uint32_t yOffset = y * _dirtyGrid.BlockColumns;
-            if (_dirtyGrid.Blocks[yOffset + x] == 0)
-            {
-                continue;
-            }
-
-            // Determine columns
-            uint32_t xx;
-            for (xx = x; xx < _dirtyGrid.BlockColumns; xx++)
-            {
-                if (_dirtyGrid.Blocks[yOffset + xx] == 0)
-                {
-                    break;
-                }
-            }
-
-            // Check rows
-            uint32_t columns = xx - x;
-            auto rows = GetNumDirtyRows(x, y, columns);
-            DrawDirtyBlocks(x, y, columns, rows);
-        }
+        DrawDirtyRect(rect);
     }
 }
 
-uint32_t X8DrawingEngine::GetNumDirtyRows(const uint32_t x, const uint32_t y, const uint32_t columns)
+void X8DrawingEngine::DrawDirtyRect(const ScreenRect& rect)
 {
-    uint32_t yy = y;
-
-    for (yy = y; yy < _dirtyGrid.BlockRows; yy++)
-    {
-        uint32_t yyOffset = yy * _dirtyGrid.BlockColumns;
-        for (uint32_t xx = x; xx < x + columns; xx++)
-        {
-            if (_dirtyGrid.Blocks[yyOffset + xx] == 0)
-            {
-                return yy - y;
-            }
-        }
-    }
-    return yy - y;
-}
-
-void X8DrawingEngine::DrawDirtyBlocks(uint32_t x, uint32_t y, uint32_t columns, uint32_t rows)
-{
-    uint32_t dirtyBlockColumns = _dirtyGrid.BlockColumns;
-    uint8_t* screenDirtyBlocks = _dirtyGrid.Blocks;
-
-    // Unset dirty blocks
-    for (uint32_t top = y; top < y + rows; top++)
-    {
-        uint32_t topOffset = top * dirtyBlockColumns;
-        for (uint32_t left = x; left < x + columns; left++)
-        {
-            screenDirtyBlocks[topOffset + left] = 0;
-        }
-    }
-
-    // Determine region in pixels
-    uint32_t left = std::max<uint32_t>(0, x * _dirtyGrid.BlockWidth);
-    uint32_t top = std::max<uint32_t>(0, y * _dirtyGrid.BlockHeight);
-    uint32_t right = std::min(_width, left + (columns * _dirtyGrid.BlockWidth));
-    uint32_t bottom = std::min(_height, top + (rows * _dirtyGrid.BlockHeight));
-    if (right <= left || bottom <= top)
+    // The screen may have shrunk since the rect was added.
+    const int32_t right = std::min(rect.GetRight(), static_cast<int32_t>(_width));
+    const int32_t bottom = std::min(rect.GetBottom(), static_cast<int32_t>(_height));
+    if (right <= rect.GetLeft() || bottom <= rect.GetTop())
     {
         return;
     }
 
+    const ScreenRect clipped = { rect.GetLeft(), rect.GetTop(), right, bottom };
+    _dirtyRectCount.Add(1);
+    _dirtyPixelCount.Add(GetArea(clipped));
+
     // Draw region
-    OnDrawDirtyBlock(x, y, columns, rows);
-    window_draw_all(&_bitsDPI, left, top, right, bottom);
+    OnDrawDirtyRect(clipped);
+    window_draw_all(&_bitsDPI, clipped.GetLeft(), clipped.GetTop(), clipped.GetRight(), clipped.GetBottom());
 }
 
 #ifdef __WARN_SUGGEST_FINAL_METHODS__
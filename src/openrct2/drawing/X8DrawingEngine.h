@@ -10,10 +10,12 @@
 #pragma once
 
 #include "../common.h"
+#include "../world/Location.hpp"
 #include "IDrawingContext.h"
 #include "IDrawingEngine.h"
 
 #include <memory>
+#include <vector>
 
 namespace OpenRCT2
 {
@@ -26,17 +28,6 @@ namespace OpenRCT2
     {
         class X8DrawingContext;
 
-        struct DirtyGrid
-        {
-            uint32_t BlockShiftX;
-            uint32_t BlockShiftY;
-            uint32_t BlockWidth;
-            uint32_t BlockHeight;
-            uint32_t BlockColumns;
-            uint32_t BlockRows;
-            uint8_t* Blocks;
-        };
-
         class X8WeatherDrawer final : public IWeatherDrawer
         {
         private:
@@ -74,7 +65,8 @@ namespace OpenRCT2
             size_t _bitsSize = 0;
             uint8_t* _bits = nullptr;
 
-            DirtyGrid _dirtyGrid = {};
+            // Screen areas to redraw, overlapping and nearby ones are merged as they are added.
+            std::vector<ScreenRect> _dirtyRects;
 
             rct_drawpixelinfo _bitsDPI = {};
 
@@ -116,13 +108,11 @@ namespace OpenRCT2
 
         protected:
             void ConfigureBits(uint32_t width, uint32_t height, uint32_t pitch);
-            virtual void OnDrawDirtyBlock(uint32_t x, uint32_t y, uint32_t columns, uint32_t rows);
+            virtual void OnDrawDirtyRect(const ScreenRect& rect);
 
         private:
-            void ConfigureDirtyGrid();
-            void DrawAllDirtyBlocks();
-            uint32_t GetNumDirtyRows(const uint32_t x, const uint32_t y, const uint32_t columns);
-            void DrawDirtyBlocks(uint32_t x, uint32_t y, uint32_t columns, uint32_t rows);
+            void DrawAllDirtyRects();
+            void DrawDirtyRect(const ScreenRect& rect);
         };
 #ifdef __WARN_SUGGEST_FINAL_TYPES__
 #    pragma GCC diagnostic pop
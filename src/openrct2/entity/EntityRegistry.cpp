@@ -32,6 +32,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <iterator>
 #include <numeric>
 #include <vector>
@@ -52,12 +53,25 @@ static std::vector<EntityId> _freeIdList;
 
 static bool _entityFlashingList[MAX_ENTITIES];
 
+struct EntityChecksumState
+{
+    uint64_t Fingerprint;
+    uint64_t Contribution;
+    bool Tracked;
+};
+
+// Per entity contributions to the rolling entities checksum, see GetRollingEntitiesChecksum.
+static std::array<EntityChecksumState, MAX_ENTITIES> _entityChecksumStates;
+static std::array<uint64_t, EnumValue(EntityType::Count)> _rollingEntityTypeChecksums;
+
 constexpr const uint32_t SPATIAL_INDEX_SIZE = (MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL) + 1;
 constexpr const uint32_t SPATIAL_INDEX_LOCATION_NULL = SPATIAL_INDEX_SIZE - 1;
 
 static std::array<std::vector<EntityId>, SPATIAL_INDEX_SIZE> gEntitySpatialIndex;
 
 static void FreeEntity(EntityBase& entity);
+static void ResetEntitiesChecksum();
+static void RemoveEntityChecksum(const EntityBase& entity);
 
 static constexpr size_t GetSpatialIndexOffset(const CoordsXY& loc)
 {
@@ -202,6 +216,7 @@ void ResetAllEntities()
     ResetEntityLists();
     ResetFreeIds();
     ResetEntitySpatialIndices();
+    ResetEntitiesChecksum();
 }
 
 static void EntitySpatialInsert(EntityBase* entity, const CoordsXY& newLoc);
@@ -253,6 +268,132 @@ EntitiesChecksum GetAllEntitiesChecksum()
 
     return checksum;
 }
+
+/**
+ * Cheap hash over the raw storage of an entity, only used to find out if the entity has changed since its
+ * contribution was last computed. Everything the entity serialises lives in this storage.
+ */
+static uint64_t GetEntityFingerprint(EntityId index)
+{
+    constexpr uint64_t Prime = 0x9E3779B97F4A7C15ULL;
+    constexpr size_t NumWords = sizeof(Entity) / sizeof(uint64_t);
+    static_assert(NumWords % 4 == 0);
+
+    const auto* bytes = reinterpret_cast<const uint8_t*>(&_entities[index.ToUnderlying()]);
+    uint64_t lanes[4] = { 1, 2, 3, 4 };
+    for (size_t i = 0; i < NumWords; i += 4)
+    {
+        for (size_t lane = 0; lane < 4; lane++)
+        {
+            uint64_t word;
+            std::memcpy(&word, bytes + (i + lane) * sizeof(uint64_t), sizeof(word));
+            lanes[lane] = (lanes[lane] ^ word) * Prime;
+        }
+    }
+    return lanes[0] ^ (lanes[1] >> 7) ^ (lanes[2] << 11) ^ (lanes[3] >> 17);
+}
+
+template<typename T> static uint64_t GetEntityContribution(T& entity)
+{
+    EntitiesChecksum checksum{};
+
+    OpenRCT2::ChecksumStream ms(checksum.raw);
+    DataSerialiser ds(true, ms);
+    entity.Serialise(ds);
+
+    uint64_t contribution;
+    std::memcpy(&contribution, checksum.raw.data(), sizeof(contribution));
+    return contribution;
+}
+
+template<typename T> static uint64_t RefreshEntityChecksumType()
+{
+    auto& rollingChecksum = _rollingEntityTypeChecksums[EnumValue(T::cEntityType)];
+    for (auto* ent : EntityList<T>())
+    {
+        auto& state = _entityChecksumStates[ent->sprite_index.ToUnderlying()];
+        const auto fingerprint = GetEntityFingerprint(ent->sprite_index);
+        if (state.Tracked && state.Fingerprint == fingerprint)
+            continue;
+
+        const auto contribution = GetEntityContribution(*ent);
+        if (state.Tracked)
+        {
+            rollingChecksum ^= state.Contribution;
+        }
+        rollingChecksum ^= contribution;
+        state = { fingerprint, contribution, true };
+    }
+    return rollingChecksum;
+}
+
+template<typename... T> static uint64_t RefreshEntityChecksumTypes()
+{
+    return (RefreshEntityChecksumType<T>() ^ ...);
+}
+
+template<typename T> static uint64_t ComputeEntitiesContributionsType()
+{
+    uint64_t result = 0;
+    for (auto* ent : EntityList<T>())
+    {
+        result ^= GetEntityContribution(*ent);
+    }
+    return result;
+}
+
+template<typename... T> static uint64_t ComputeEntitiesContributions()
+{
+    return (ComputeEntitiesContributionsType<T>() ^ ...);
+}
+
+static EntitiesChecksum MakeRollingChecksum(uint64_t value)
+{
+    EntitiesChecksum checksum{};
+    std::memcpy(checksum.raw.data(), &value, sizeof(value));
+    return checksum;
+}
+
+EntitiesChecksum GetRollingEntitiesChecksum()
+{
+    PROFILED_FUNCTION();
+
+    return MakeRollingChecksum(RefreshEntityChecksumTypes<Guest, Staff, Vehicle, Litter>());
+}
+
+uint64_t GetRollingEntitiesChecksum(EntityType type)
+{
+    switch (type)
+    {
+        case EntityType::Guest:
+            return RefreshEntityChecksumType<Guest>();
+        case EntityType::Staff:
+            return RefreshEntityChecksumType<Staff>();
+        case EntityType::Vehicle:
+            return RefreshEntityChecksumType<Vehicle>();
+        case EntityType::Litter:
+            return RefreshEntityChecksumType<Litter>();
+        default:
+            return 0;
+    }
+}
+
+bool VerifyRollingEntitiesChecksum()
+{
+    const auto rolling = GetRollingEntitiesChecksum();
+    const auto expected = MakeRollingChecksum(ComputeEntitiesContributions<Guest, Staff, Vehicle, Litter>());
+    if (rolling.raw != expected.raw)
+    {
+        log_warning(
+            "Rolling entities checksum mismatch, rolling = %s, expected = %s", rolling.ToString().c_str(),
+            expected.ToString().c_str());
+
+        // Start over so the next checksum is correct again.
+        ResetEntitiesChecksum();
+        return false;
+    }
+    return true;
+}
 #else
 
 EntitiesChecksum GetAllEntitiesChecksum()
@@ -260,8 +401,39 @@ EntitiesChecksum GetAllEntitiesChecksum()
     return EntitiesChecksum{};
 }
 
+EntitiesChecksum GetRollingEntitiesChecksum()
+{
+    return EntitiesChecksum{};
+}
+
+uint64_t GetRollingEntitiesChecksum(EntityType type)
+{
+    return 0;
+}
+
+bool VerifyRollingEntitiesChecksum()
+{
+    return true;
+}
+
 #endif // DISABLE_NETWORK
 
+static void ResetEntitiesChecksum()
+{
+    std::fill(std::begin(_entityChecksumStates), std::end(_entityChecksumStates), EntityChecksumState{});
+    _rollingEntityTypeChecksums.fill(0);
+}
+
+static void RemoveEntityChecksum(const EntityBase& entity)
+{
+    auto& state = _entityChecksumStates[entity.sprite_index.ToUnderlying()];
+    if (state.Tracked)
+    {
+        _rollingEntityTypeChecksums[EnumValue(entity.Type)] ^= state.Contribution;
+        state = {};
+    }
+}
+
 static void EntityReset(EntityBase* entity)
 {
     // Need to retain how the sprite is linked in lists
@@ -515,6 +687,7 @@ void EntityRemove(EntityBase* entity)
     EntityTweener::Get().RemoveEntity(entity);
     RemoveFromEntityList(entity); // remove from existing list
     AddToFreeList(entity->sprite_index);
+    RemoveEntityChecksum(*entity);
 
     EntitySpatialRemove(entity);
     EntityReset(entity);
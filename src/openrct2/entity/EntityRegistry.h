@@ -64,5 +64,22 @@ struct EntitiesChecksum
 #pragma pack(pop)
 EntitiesChecksum GetAllEntitiesChecksum();
 
+/**
+ * Checksum of the same entities as GetAllEntitiesChecksum, but maintained incrementally: only entities that changed since
+ * the last call are serialised again. The value is not compatible with GetAllEntitiesChecksum.
+ */
+EntitiesChecksum GetRollingEntitiesChecksum();
+
+/**
+ * The part of the rolling checksum contributed by a single entity type, zero for types that are not checksummed.
+ */
+uint64_t GetRollingEntitiesChecksum(EntityType type);
+
+/**
+ * Recomputes the rolling checksum from scratch and compares it to the incrementally maintained one.
+ * Returns false on a mismatch, in which case the rolling checksum is rebuilt.
+ */
+bool VerifyRollingEntitiesChecksum();
+
 void EntitySetFlashing(EntityBase* entity, bool flashing);
 bool EntityGetFlashing(EntityBase* entity);
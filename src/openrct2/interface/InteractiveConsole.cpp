@@ -1701,6 +1701,37 @@ static int32_t cc_replay_stop(InteractiveConsole& console, const arguments_t& ar
     return 0;
 }
 
+static int32_t cc_replay_seek(InteractiveConsole& console, const arguments_t& argv)
+{
+    if (network_get_mode() != NETWORK_MODE_NONE)
+    {
+        console.WriteFormatLine("This command is currently not supported in multiplayer mode.");
+        return 0;
+    }
+
+    if (argv.size() < 1)
+    {
+        console.WriteFormatLine("Parameters required <tick>");
+        return 0;
+    }
+
+    auto* replayManager = OpenRCT2::GetContext()->GetReplayManager();
+    if (!replayManager->IsReplaying())
+    {
+        console.WriteFormatLine("Replay currently not playing");
+        return 0;
+    }
+
+    uint32_t tick = static_cast<uint32_t>(atol(argv[0].c_str()));
+    if (replayManager->SeekPlayback(tick))
+    {
+        console.WriteFormatLine("Replay moved to tick %u", tick);
+        return 1;
+    }
+
+    return 0;
+}
+
 static int32_t cc_replay_normalise(InteractiveConsole& console, const arguments_t& argv)
 {
     if (network_get_mode() != NETWORK_MODE_NONE)
@@ -2018,6 +2049,7 @@ static constexpr const console_command console_command_table[] = {
     { "replay_stoprecord", cc_replay_stoprecord, "Stops recording a new replay.", "replay_stoprecord" },
     { "replay_start", cc_replay_start, "Starts a replay", "replay_start <name>" },
     { "replay_stop", cc_replay_stop, "Stops the replay", "replay_stop" },
+    { "replay_seek", cc_replay_seek, "Moves the replay to a tick after its start", "replay_seek <tick>" },
     { "replay_normalise", cc_replay_normalise, "Normalises the replay to remove all gaps",
       "replay_normalise <input file> <output file>" },
     { "mp_desync", cc_mp_desync, "Forces a multiplayer desync",
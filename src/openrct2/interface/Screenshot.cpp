@@ -25,6 +25,8 @@
 #include "../drawing/X8DrawingEngine.h"
 #include "../localisation/Formatter.h"
 #include "../localisation/Localisation.h"
+#include "../paint/Paint.StaticCache.h"
+#include "../paint/Painter.h"
 #include "../platform/Platform.h"
 #include "../util/Util.h"
 #include "../world/Climate.h"
@@ -37,9 +39,14 @@
 #include <cctype>
 #include <chrono>
 #include <cstdlib>
+#include <cstring>
+#include <future>
+#include <iostream>
 #include <memory>
 #include <optional>
+#include <sstream>
 #include <string>
+#include <vector>
 
 using namespace std::literals::string_literals;
 using namespace OpenRCT2;
@@ -324,7 +331,9 @@ static rct_viewport GetGiantViewport(int32_t rotation, ZoomLevel zoom)
     return viewport;
 }
 
-static void RenderViewport(IDrawingEngine* drawingEngine, const rct_viewport& viewport, rct_drawpixelinfo& dpi)
+static void RenderViewport(
+    IDrawingEngine* drawingEngine, const rct_viewport& viewport, rct_drawpixelinfo& dpi,
+    std::optional<bool> multiThreading = std::nullopt)
 {
     // Ensure sprites appear regardless of rotation
     reset_all_sprite_quadrant_placements();
@@ -336,12 +345,79 @@ static void RenderViewport(IDrawingEngine* drawingEngine, const rct_viewport& vi
         drawingEngine = tempDrawingEngine.get();
     }
     dpi.DrawingEngine = drawingEngine;
-    viewport_render(&dpi, &viewport, { { 0, 0 }, { viewport.width, viewport.height } });
+    viewport_render(&dpi, &viewport, { { 0, 0 }, { viewport.width, viewport.height } }, nullptr, multiThreading);
+}
+
+/**
+ * Renders the viewport in horizontal bands and streams each band into the PNG while the next one is being painted, so
+ * memory use only depends on the width of the image rather than on its area. Every band is split into columns that are
+ * painted on the paint job pool.
+ */
+static void WriteViewportToFileTiled(
+    std::string_view path, const rct_viewport& viewport, const GamePalette& palette, X8DrawingEngine& drawingEngine)
+{
+    constexpr int32_t BandHeight = 256;
+
+    const auto width = viewport.width;
+    const auto height = viewport.height;
+    if (width <= 0 || height <= 0)
+    {
+        throw std::runtime_error("Screenshot failed, the image is empty.");
+    }
+
+    std::vector<uint8_t> bands[2];
+    for (auto& band : bands)
+    {
+        band.resize(static_cast<size_t>(width) * std::min(BandHeight, height));
+    }
+
+    Imaging::PngRowWriter writer(path, width, height, palette);
+
+    std::future<void> pendingWrite;
+    try
+    {
+        for (int32_t top = 0, bandIndex = 0; top < height; top += BandHeight, bandIndex ^= 1)
+        {
+            rct_viewport bandViewport = viewport;
+            bandViewport.height = std::min(BandHeight, height - top);
+            bandViewport.view_height = viewport.zoom.ApplyTo(bandViewport.height);
+            bandViewport.viewPos.y = viewport.viewPos.y + viewport.zoom.ApplyTo(top);
+
+            // The other buffer may still be being written out, this one was finished with two bands ago.
+            auto& band = bands[bandIndex];
+            std::fill(band.begin(), band.end(), PALETTE_INDEX_0);
+
+            rct_drawpixelinfo dpi{};
+            dpi.bits = band.data();
+            dpi.width = width;
+            dpi.height = bandViewport.height;
+            // The bands are not shown on screen, so always paint them on all available threads.
+            RenderViewport(&drawingEngine, bandViewport, dpi, true);
+
+            if (pendingWrite.valid())
+            {
+                pendingWrite.get();
+            }
+            pendingWrite = std::async(std::launch::async, [&writer, &pixels = band, width, rows = bandViewport.height] {
+                writer.WriteRows(pixels.data(), width, rows);
+            });
+        }
+        pendingWrite.get();
+    }
+    catch (const std::exception&)
+    {
+        if (pendingWrite.valid())
+        {
+            pendingWrite.wait();
+        }
+        throw;
+    }
+
+    writer.Finish();
 }
 
 void screenshot_giant()
 {
-    rct_drawpixelinfo dpi{};
     try
     {
         auto path = screenshot_get_next_path();
@@ -369,10 +445,8 @@ void screenshot_giant()
             viewport.flags |= VIEWPORT_FLAG_TRANSPARENT_BACKGROUND;
         }
 
-        dpi = CreateDPI(viewport);
-
-        RenderViewport(nullptr, viewport, dpi);
-        WriteDpiToFile(path.value(), &dpi, gPalette);
+        X8DrawingEngine drawingEngine(GetContext()->GetUiContext());
+        WriteViewportToFileTiled(path.value(), viewport, gPalette, drawingEngine);
 
         // Show user that screenshot saved successfully
         const auto filename = Path::GetFileName(path.value());
@@ -386,8 +460,6 @@ void screenshot_giant()
         log_error("%s", e.what());
         context_show_error(STR_SCREENSHOT_FAILED, STR_NONE, {});
     }
-
-    ReleaseDPI(dpi);
 }
 
 // TODO: Move this at some point into a more appropriate place.
@@ -422,8 +494,8 @@ static void benchgfx_render_screenshots(const char* inputPath, std::unique_ptr<I
         int32_t zoomIndex{ static_cast<int8_t>(zoom) };
         for (int32_t rotation = 0; rotation < NUM_ROTATIONS; rotation++)
         {
-            auto& viewport = viewports[zoomIndex * NUM_ZOOM_LEVELS + rotation];
-            auto& dpi = dpis[zoomIndex * NUM_ZOOM_LEVELS + rotation];
+            auto& viewport = viewports[zoomIndex * NUM_ROTATIONS + rotation];
+            auto& dpi = dpis[zoomIndex * NUM_ROTATIONS + rotation];
             viewport = GetGiantViewport(rotation, zoom);
             dpi = CreateDPI(viewport);
         }
@@ -431,6 +503,10 @@ static void benchgfx_render_screenshots(const char* inputPath, std::unique_ptr<I
 
     const uint32_t totalRenderCount = iterationCount * NUM_ROTATIONS * NUM_ZOOM_LEVELS;
 
+    const auto& paintEntryPool = context->GetPainter()->GetPaintEntryPool();
+    const auto nodeCountBefore = paintEntryPool.GetNodeCount();
+    const auto rentCountBefore = paintEntryPool.GetRentCount();
+
     try
     {
         double totalTime = 0.0;
@@ -448,8 +524,8 @@ static void benchgfx_render_screenshots(const char* inputPath, std::unique_ptr<I
                 // N iterations.
                 for (uint32_t i = 0; i < iterationCount; i++)
                 {
-                    auto& dpi = dpis[zoom * NUM_ZOOM_LEVELS + rotation];
-                    auto& viewport = viewports[zoom * NUM_ZOOM_LEVELS + rotation];
+                    auto& dpi = dpis[zoom * NUM_ROTATIONS + rotation];
+                    auto& viewport = viewports[zoom * NUM_ROTATIONS + rotation];
                     double elapsed = MeasureFunctionTime([&viewport, &dpi]() { RenderViewport(nullptr, viewport, dpi); });
                     totalTime += elapsed;
                     zoomLevelTime += elapsed;
@@ -472,6 +548,47 @@ static void benchgfx_render_screenshots(const char* inputPath, std::unique_ptr<I
         }
         std::printf("Total average: %.06fs, %.f FPS\n", average, 1.0 / average);
         std::printf("Time: %.05fs\n", totalTime);
+
+        // Paint sessions keep their entries between renders, so after warming up rents should be rare.
+        const auto nodeCount = paintEntryPool.GetNodeCount() - nodeCountBefore;
+        const auto rentCount = paintEntryPool.GetRentCount() - rentCountBefore;
+        std::printf("Paint entry nodes allocated: %zu\n", nodeCount);
+        std::printf(
+            "Paint entry node rents: %zu, %.02f per render\n", rentCount,
+            static_cast<double>(rentCount) / static_cast<double>(totalRenderCount));
+
+        // Render every view once more painting all tiles from scratch and once replaying the static paint cache, the
+        // output has to be the same. Views the cache was evicted for are recorded by an untimed render first.
+        const bool staticPaintCacheEnabled = gPaintStaticCacheEnabled;
+        double uncachedTime = 0.0;
+        double cachedTime = 0.0;
+        size_t numMismatches = 0;
+        for (size_t i = 0; i < dpis.size(); i++)
+        {
+            auto& dpi = dpis[i];
+            auto& viewport = viewports[i];
+            const auto size = static_cast<size_t>(dpi.width) * dpi.height;
+
+            gPaintStaticCacheEnabled = false;
+            std::memset(dpi.bits, PALETTE_INDEX_0, size);
+            uncachedTime += MeasureFunctionTime([&viewport, &dpi]() { RenderViewport(nullptr, viewport, dpi); });
+            const std::vector<uint8_t> uncachedBits(dpi.bits, dpi.bits + size);
+
+            gPaintStaticCacheEnabled = true;
+            RenderViewport(nullptr, viewport, dpi);
+            std::memset(dpi.bits, PALETTE_INDEX_0, size);
+            cachedTime += MeasureFunctionTime([&viewport, &dpi]() { RenderViewport(nullptr, viewport, dpi); });
+            if (!std::equal(uncachedBits.begin(), uncachedBits.end(), dpi.bits))
+            {
+                numMismatches++;
+            }
+        }
+        gPaintStaticCacheEnabled = staticPaintCacheEnabled;
+
+        const auto numViews = static_cast<double>(dpis.size());
+        std::printf("Uncached average: %.06fs, %.f FPS\n", uncachedTime / numViews, numViews / uncachedTime);
+        std::printf("Cached average: %.06fs, %.f FPS\n", cachedTime / numViews, numViews / cachedTime);
+        std::printf("Views differing from uncached: %zu of %zu\n", numMismatches, dpis.size());
     }
     catch (const std::exception& e)
     {
@@ -514,23 +631,13 @@ int32_t cmdline_for_gfxbench(const char** argv, int32_t argc)
     return 1;
 }
 
-static void ApplyOptions(const ScreenshotOptions* options, rct_viewport& viewport)
+static void ApplyParkOptions(const ScreenshotOptions* options)
 {
     if (options->weather != WeatherType::Sunny && options->weather != WeatherType::Count)
     {
         ClimateForceWeather(WeatherType{ static_cast<uint8_t>(EnumValue(options->weather) - 1) });
     }
 
-    if (options->hide_guests)
-    {
-        viewport.flags |= VIEWPORT_FLAG_HIDE_GUESTS | VIEWPORT_FLAG_HIDE_STAFF;
-    }
-
-    if (options->hide_sprites)
-    {
-        viewport.flags |= VIEWPORT_FLAG_HIDE_ENTITIES;
-    }
-
     if (options->mowed_grass)
     {
         CheatsSet(CheatType::SetGrassLength, GRASS_LENGTH_MOWED);
@@ -555,6 +662,19 @@ static void ApplyOptions(const ScreenshotOptions* options, rct_viewport& viewpor
     {
         CheatsSet(CheatType::RemoveLitter);
     }
+}
+
+static void ApplyViewportOptions(const ScreenshotOptions* options, rct_viewport& viewport)
+{
+    if (options->hide_guests)
+    {
+        viewport.flags |= VIEWPORT_FLAG_HIDE_GUESTS | VIEWPORT_FLAG_HIDE_STAFF;
+    }
+
+    if (options->hide_sprites)
+    {
+        viewport.flags |= VIEWPORT_FLAG_HIDE_ENTITIES;
+    }
 
     if (options->transparent || gConfigGeneral.TransparentScreenshot)
     {
@@ -562,7 +682,7 @@ static void ApplyOptions(const ScreenshotOptions* options, rct_viewport& viewpor
     }
 }
 
-int32_t cmdline_for_screenshot(const char** argv, int32_t argc, ScreenshotOptions* options)
+static int32_t GetScreenshotArgumentCount(const char* const* argv, int32_t argc)
 {
     // Don't include options in the count (they have been handled by CommandLine::ParseOptions already)
     for (int32_t i = 0; i < argc; i++)
@@ -570,13 +690,122 @@ int32_t cmdline_for_screenshot(const char** argv, int32_t argc, ScreenshotOption
         if (argv[i][0] == '-')
         {
             // Setting argc to i works, because options can only be at the end of the command
-            argc = i;
-            break;
+            return i;
         }
     }
+    return argc;
+}
+
+static bool IsGiantScreenshot(const char* const* argv, int32_t argc)
+{
+    return (argc == 5) && _stricmp(argv[2], "giant") == 0;
+}
+
+static bool IsValidScreenshotArguments(const char* const* argv, int32_t argc)
+{
+    return argc == 4 || argc == 8 || IsGiantScreenshot(argv, argc);
+}
+
+/**
+ * Creates the viewport described by the arguments of a screenshot command for the loaded park and sets the current
+ * rotation to match it.
+ */
+static rct_viewport GetScreenshotViewport(const char* const* argv, int32_t argc)
+{
+    rct_viewport viewport{};
+    if (IsGiantScreenshot(argv, argc))
+    {
+        auto customZoom = static_cast<int8_t>(std::atoi(argv[3]));
+        auto zoom = ZoomLevel{ customZoom };
+        auto rotation = std::atoi(argv[4]) & 3;
+        viewport = GetGiantViewport(rotation, zoom);
+        gCurrentRotation = rotation;
+        return viewport;
+    }
+
+    bool customLocation = false;
+    bool centreMapX = false;
+    bool centreMapY = false;
+    int32_t resolutionWidth = std::atoi(argv[2]);
+    int32_t resolutionHeight = std::atoi(argv[3]);
+    int32_t customX = 0;
+    int32_t customY = 0;
+    int32_t customZoom = 0;
+    int32_t customRotation = 0;
+    if (argc == 8)
+    {
+        customLocation = true;
+        if (argv[4][0] == 'c')
+            centreMapX = true;
+        else
+            customX = std::atoi(argv[4]);
+
+        if (argv[5][0] == 'c')
+            centreMapY = true;
+        else
+            customY = std::atoi(argv[5]);
+
+        customZoom = std::atoi(argv[6]);
+        customRotation = std::atoi(argv[7]) & 3;
+    }
+
+    const auto& mapSize = gMapSize;
+    if (resolutionWidth == 0 || resolutionHeight == 0)
+    {
+        resolutionWidth = (mapSize.x * COORDS_XY_STEP * 2) >> customZoom;
+        resolutionHeight = (mapSize.y * COORDS_XY_STEP * 1) >> customZoom;
+
+        resolutionWidth += 8;
+        resolutionHeight += 128;
+    }
+
+    viewport.width = resolutionWidth;
+    viewport.height = resolutionHeight;
+    viewport.view_width = viewport.width;
+    viewport.view_height = viewport.height;
+    if (customLocation)
+    {
+        if (centreMapX)
+            customX = (mapSize.x / 2) * 32 + 16;
+        if (centreMapY)
+            customY = (mapSize.y / 2) * 32 + 16;
+
+        int32_t z = TileElementHeight({ customX, customY });
+        CoordsXYZ coords3d = { customX, customY, z };
+
+        auto coords2d = Translate3DTo2DWithZ(customRotation, coords3d);
+
+        viewport.viewPos = { coords2d.x - ((viewport.view_width << customZoom) / 2),
+                             coords2d.y - ((viewport.view_height << customZoom) / 2) };
+        viewport.zoom = ZoomLevel{ static_cast<int8_t>(customZoom) };
+        gCurrentRotation = customRotation;
+    }
+    else
+    {
+        viewport.viewPos = { gSavedView - ScreenCoordsXY{ (viewport.view_width / 2), (viewport.view_height / 2) } };
+        viewport.zoom = gSavedViewZoom;
+        gCurrentRotation = gSavedViewRotation;
+    }
+    return viewport;
+}
+
+static void LoadParkForScreenshot(IContext& context, const char* inputPath, const ScreenshotOptions* options)
+{
+    if (!context.LoadParkFromFile(inputPath))
+    {
+        throw std::runtime_error("Failed to load park.");
+    }
+
+    gIntroState = IntroState::None;
+    gScreenFlags = SCREEN_FLAGS_PLAYING;
+
+    ApplyParkOptions(options);
+}
 
-    bool giantScreenshot = (argc == 5) && _stricmp(argv[2], "giant") == 0;
-    if (argc != 4 && argc != 8 && !giantScreenshot)
+int32_t cmdline_for_screenshot(const char** argv, int32_t argc, ScreenshotOptions* options)
+{
+    argc = GetScreenshotArgumentCount(argv, argc);
+    if (!IsValidScreenshotArguments(argv, argc))
     {
         std::printf("Usage: openrct2 screenshot <file> <output_image> <width> <height> [<x> <y> <zoom> <rotation>]\n");
         std::printf("Usage: openrct2 screenshot <file> <output_image> giant <zoom> <rotation>\n");
@@ -584,13 +813,9 @@ int32_t cmdline_for_screenshot(const char** argv, int32_t argc, ScreenshotOption
     }
 
     int32_t exitCode = 1;
-    rct_drawpixelinfo dpi;
     try
     {
         Platform::CoreInit();
-        bool customLocation = false;
-        bool centreMapX = false;
-        bool centreMapY = false;
 
         const char* inputPath = argv[0];
         const char* outputPath = argv[1];
@@ -604,104 +829,160 @@ int32_t cmdline_for_screenshot(const char** argv, int32_t argc, ScreenshotOption
 
         drawing_engine_init();
 
-        if (!context->LoadParkFromFile(inputPath))
+        LoadParkForScreenshot(*context, inputPath, options);
+
+        auto viewport = GetScreenshotViewport(argv, argc);
+        ApplyViewportOptions(options, viewport);
+
+        X8DrawingEngine drawingEngine(context->GetUiContext());
+        WriteViewportToFileTiled(outputPath, viewport, gPalette, drawingEngine);
+    }
+    catch (const std::exception& e)
+    {
+        std::printf("%s\n", e.what());
+        exitCode = -1;
+    }
+
+    drawing_engine_dispose();
+
+    return exitCode;
+}
+
+/**
+ * Splits a job line into its arguments. Arguments are separated by whitespace, double quotes allow paths with spaces.
+ */
+static std::vector<std::string> SplitScreenshotJob(std::string_view line)
+{
+    std::vector<std::string> arguments;
+    size_t i = 0;
+    while (i < line.size())
+    {
+        if (std::isspace(static_cast<unsigned char>(line[i])))
         {
-            throw std::runtime_error("Failed to load park.");
+            i++;
+            continue;
         }
 
-        gIntroState = IntroState::None;
-        gScreenFlags = SCREEN_FLAGS_PLAYING;
-
-        rct_viewport viewport{};
-        if (giantScreenshot)
+        std::string argument;
+        if (line[i] == '"')
         {
-            auto customZoom = static_cast<int8_t>(std::atoi(argv[3]));
-            auto zoom = ZoomLevel{ customZoom };
-            auto rotation = std::atoi(argv[4]) & 3;
-            viewport = GetGiantViewport(rotation, zoom);
-            gCurrentRotation = rotation;
+            auto end = line.find('"', i + 1);
+            if (end == std::string_view::npos)
+                end = line.size();
+            argument = line.substr(i + 1, end - i - 1);
+            i = end + 1;
         }
         else
         {
-            int32_t resolutionWidth = std::atoi(argv[2]);
-            int32_t resolutionHeight = std::atoi(argv[3]);
-            int32_t customX = 0;
-            int32_t customY = 0;
-            int32_t customZoom = 0;
-            int32_t customRotation = 0;
-            if (argc == 8)
-            {
-                customLocation = true;
-                if (argv[4][0] == 'c')
-                    centreMapX = true;
-                else
-                    customX = std::atoi(argv[4]);
-
-                if (argv[5][0] == 'c')
-                    centreMapY = true;
-                else
-                    customY = std::atoi(argv[5]);
-
-                customZoom = std::atoi(argv[6]);
-                customRotation = std::atoi(argv[7]) & 3;
-            }
+            auto start = i;
+            while (i < line.size() && !std::isspace(static_cast<unsigned char>(line[i])))
+                i++;
+            argument = line.substr(start, i - start);
+        }
+        arguments.push_back(std::move(argument));
+    }
+    return arguments;
+}
 
-            const auto& mapSize = gMapSize;
-            if (resolutionWidth == 0 || resolutionHeight == 0)
-            {
-                resolutionWidth = (mapSize.x * COORDS_XY_STEP * 2) >> customZoom;
-                resolutionHeight = (mapSize.y * COORDS_XY_STEP * 1) >> customZoom;
+int32_t cmdline_for_screenshot_batch(const char** argv, int32_t argc, ScreenshotOptions* options)
+{
+    argc = GetScreenshotArgumentCount(argv, argc);
+    if (argc > 1)
+    {
+        std::printf("Usage: openrct2 screenshot batch [<job_file>]\n");
+        return -1;
+    }
 
-                resolutionWidth += 8;
-                resolutionHeight += 128;
-            }
+    // Jobs are read from stdin unless a job file is given, so a single process can serve a queue fed through a pipe.
+    std::istringstream jobFile;
+    const bool readJobFile = argc == 1 && std::strcmp(argv[0], "-") != 0;
+    if (readJobFile)
+    {
+        try
+        {
+            jobFile.str(File::ReadAllText(argv[0]));
+        }
+        catch (const std::exception& e)
+        {
+            std::printf("Unable to read job file: %s\n", e.what());
+            return -1;
+        }
+    }
+    std::istream& jobs = readJobFile ? static_cast<std::istream&>(jobFile) : std::cin;
 
-            viewport.width = resolutionWidth;
-            viewport.height = resolutionHeight;
-            viewport.view_width = viewport.width;
-            viewport.view_height = viewport.height;
-            if (customLocation)
-            {
-                if (centreMapX)
-                    customX = (mapSize.x / 2) * 32 + 16;
-                if (centreMapY)
-                    customY = (mapSize.y / 2) * 32 + 16;
+    Platform::CoreInit();
+    gOpenRCT2Headless = true;
+    auto context = CreateContext();
+    if (!context->Initialise())
+    {
+        std::printf("Failed to initialize context.\n");
+        return -1;
+    }
 
-                int32_t z = TileElementHeight({ customX, customY });
-                CoordsXYZ coords3d = { customX, customY, z };
+    drawing_engine_init();
 
-                auto coords2d = Translate3DTo2DWithZ(customRotation, coords3d);
+    // Objects, sprites and paint sessions stay loaded between jobs, consecutive jobs for the same park only load it once
+    // unless the file has been written to since.
+    X8DrawingEngine drawingEngine(context->GetUiContext());
+    std::string loadedParkPath;
+    fs::file_time_type loadedParkTime;
+    std::string line;
+    int32_t numFailedJobs = 0;
+    while (std::getline(jobs, line))
+    {
+        auto arguments = SplitScreenshotJob(line);
+        if (arguments.empty() || arguments[0][0] == '#')
+            continue;
 
-                viewport.viewPos = { coords2d.x - ((viewport.view_width << customZoom) / 2),
-                                     coords2d.y - ((viewport.view_height << customZoom) / 2) };
-                viewport.zoom = ZoomLevel{ static_cast<int8_t>(customZoom) };
-                gCurrentRotation = customRotation;
+        std::vector<const char*> jobArgv;
+        for (const auto& argument : arguments)
+        {
+            jobArgv.push_back(argument.c_str());
+        }
+        const auto jobArgc = static_cast<int32_t>(jobArgv.size());
+
+        try
+        {
+            if (!IsValidScreenshotArguments(jobArgv.data(), jobArgc))
+            {
+                throw std::runtime_error("Invalid job, expected the arguments of the screenshot command.");
             }
-            else
+
+            std::error_code ec;
+            const auto parkTime = fs::last_write_time(fs::u8path(arguments[0]), ec);
+            if (loadedParkPath != arguments[0] || parkTime != loadedParkTime)
             {
-                viewport.viewPos = { gSavedView - ScreenCoordsXY{ (viewport.view_width / 2), (viewport.view_height / 2) } };
-                viewport.zoom = gSavedViewZoom;
-                gCurrentRotation = gSavedViewRotation;
+                loadedParkPath.clear();
+                LoadParkForScreenshot(*context, jobArgv[0], options);
+                loadedParkPath = arguments[0];
+                loadedParkTime = parkTime;
             }
-        }
 
-        ApplyOptions(options, viewport);
+            auto viewport = GetScreenshotViewport(jobArgv.data(), jobArgc);
+            ApplyViewportOptions(options, viewport);
 
-        dpi = CreateDPI(viewport);
+            WriteViewportToFileTiled(jobArgv[1], viewport, gPalette, drawingEngine);
+            std::printf("ok %s\n", jobArgv[1]);
+        }
+        catch (const std::exception& e)
+        {
+            std::printf("error %s: %s\n", line.c_str(), e.what());
+            numFailedJobs++;
+        }
 
-        RenderViewport(nullptr, viewport, dpi);
-        WriteDpiToFile(outputPath, &dpi, gPalette);
+        // The caller waits for the result of each job before sending the next one when reading from a pipe.
+        std::fflush(stdout);
     }
-    catch (const std::exception& e)
-    {
-        std::printf("%s\n", e.what());
-        exitCode = -1;
-    }
-    ReleaseDPI(dpi);
 
     drawing_engine_dispose();
 
-    return exitCode;
+    // Every job is attempted, but the exit code reports whether all of them succeeded.
+    if (numFailedJobs != 0)
+    {
+        std::printf("%d job(s) failed\n", numFailedJobs);
+        return -1;
+    }
+    return 1;
 }
 
 static bool IsPathChildOf(fs::path x, const fs::path& parent)
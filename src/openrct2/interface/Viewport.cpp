@@ -71,6 +71,8 @@ InteractionInfo::InteractionInfo(const PaintStruct* ps)
 {
 }
 static void viewport_paint_weather_gloom(rct_drawpixelinfo* dpi);
+static InteractionInfo set_interaction_info_from_paint_structs(
+    PaintStruct* ps, rct_drawpixelinfo* dpi, uint32_t viewFlags, uint16_t filter);
 
 /**
  * This is not a viewport function. It is used to setup many variables for
@@ -802,7 +804,7 @@ void viewport_update_smart_vehicle_follow(rct_window* window)
  */
 void viewport_render(
     rct_drawpixelinfo* dpi, const rct_viewport* viewport, const ScreenRect& screenRect,
-    std::vector<RecordedPaintSession>* sessions)
+    std::vector<RecordedPaintSession>* sessions, std::optional<bool> multiThreading)
 {
     auto [topLeft, bottomRight] = screenRect;
 
@@ -832,7 +834,7 @@ void viewport_render(
         viewport->zoom.ApplyTo(std::min(bottomRight.y, viewport->height)),
     } + viewport->viewPos;
 
-    viewport_paint(viewport, dpi, { topLeft, bottomRight }, sessions);
+    viewport_paint(viewport, dpi, { topLeft, bottomRight }, sessions, multiThreading);
 
 #ifdef DEBUG_SHOW_DIRTY_BOX
     // FIXME g_viewport_list doesn't exist anymore
@@ -853,51 +855,35 @@ static void record_session(
     recordedSession.Entries.resize(session.PaintEntryChain.GetCount());
 
     // Mind the offset needs to be calculated against the original `session`, not `session_copy`
-    std::unordered_map<PaintStruct*, PaintStruct*> entryRemap;
+    std::unordered_map<const PaintStruct*, PaintStruct*> entryRemap;
 
-    // Copy all entries
-    auto paintIndex = 0;
+    // Copy all entries. Don't use AsBasic() to get at the structs here, it would reset them.
+    size_t paintIndex = 0;
     auto chain = session.PaintEntryChain.Head;
     while (chain != nullptr)
     {
         for (size_t i = 0; i < chain->Count; i++)
         {
             auto& src = chain->PaintStructs[i];
-            auto& dst = recordedSession.Entries[paintIndex++];
-            dst = src;
-            entryRemap[src.AsBasic()] = reinterpret_cast<PaintStruct*>(i * sizeof(PaintEntry));
+            recordedSession.Entries[paintIndex] = src;
+            entryRemap[reinterpret_cast<const PaintStruct*>(&src)] = reinterpret_cast<PaintStruct*>(
+                paintIndex * sizeof(PaintEntry));
+            paintIndex++;
         }
         chain = chain->Next;
     }
     entryRemap[nullptr] = reinterpret_cast<PaintStruct*>(-1);
 
-    // Remap all entries
-    for (auto& ps : recordedSession.Entries)
-    {
-        auto& ptr = ps.AsBasic()->next_quadrant_ps;
-        auto it = entryRemap.find(ptr);
-        if (it == entryRemap.end())
-        {
-            assert(false);
-            ptr = nullptr;
-        }
-        else
-        {
-            ptr = it->second;
-        }
-    }
+    // Remap the quadrant lists, other entries (e.g. attached or string structs) have no list to remap.
     for (auto& ptr : recordedSession.Session.Quadrants)
     {
-        auto it = entryRemap.find(ptr);
-        if (it == entryRemap.end())
+        for (const PaintStruct* ps = ptr; ps != nullptr; ps = ps->next_quadrant_ps)
         {
-            assert(false);
-            ptr = nullptr;
-        }
-        else
-        {
-            ptr = it->second;
+            auto index = reinterpret_cast<size_t>(entryRemap[ps]) / sizeof(PaintEntry);
+            auto* dst = reinterpret_cast<PaintStruct*>(&recordedSession.Entries[index]);
+            dst->next_quadrant_ps = entryRemap[ps->next_quadrant_ps];
         }
+        ptr = entryRemap[ptr];
     }
 }
 
@@ -957,7 +943,7 @@ static void viewport_paint_column(PaintSession& session)
  */
 void viewport_paint(
     const rct_viewport* viewport, rct_drawpixelinfo* dpi, const ScreenRect& screenRect,
-    std::vector<RecordedPaintSession>* recorded_sessions)
+    std::vector<RecordedPaintSession>* recorded_sessions, std::optional<bool> multiThreading)
 {
     PROFILED_FUNCTION();
 
@@ -999,7 +985,7 @@ void viewport_paint(
 
     _paintColumns.clear();
 
-    bool useMultithreading = gConfigGeneral.MultiThreading;
+    bool useMultithreading = multiThreading.value_or(gConfigGeneral.MultiThreading);
     if (useMultithreading && _paintJobs == nullptr)
     {
         _paintJobs = std::make_unique<JobPool>();
@@ -1805,11 +1791,15 @@ static bool is_sprite_interacted_with(rct_drawpixelinfo* dpi, ImageId imageId, c
  *  rct2: 0x0068862C
  */
 InteractionInfo set_interaction_info_from_paint_session(PaintSession* session, uint32_t viewFlags, uint16_t filter)
+{
+    return set_interaction_info_from_paint_structs(&session->PaintHead, &session->DPI, viewFlags, filter);
+}
+
+static InteractionInfo set_interaction_info_from_paint_structs(
+    PaintStruct* ps, rct_drawpixelinfo* dpi, uint32_t viewFlags, uint16_t filter)
 {
     PROFILED_FUNCTION();
 
-    PaintStruct* ps = &session->PaintHead;
-    rct_drawpixelinfo* dpi = &session->DPI;
     InteractionInfo info{};
 
     while ((ps = ps->next_quadrant_ps) != nullptr)
@@ -1868,10 +1858,9 @@ InteractionInfo get_map_coordinates_from_pos(const ScreenCoordsXY& screenCoords,
 
 InteractionInfo get_map_coordinates_from_pos_window(rct_window* window, const ScreenCoordsXY& screenCoords, int32_t flags)
 {
-    InteractionInfo info{};
     if (window == nullptr || window->viewport == nullptr)
     {
-        return info;
+        return {};
     }
 
     rct_viewport* myviewport = window->viewport;
@@ -1880,27 +1869,45 @@ InteractionInfo get_map_coordinates_from_pos_window(rct_window* window, const Sc
     if (viewLoc.x >= 0 && viewLoc.x < static_cast<int32_t>(myviewport->width) && viewLoc.y >= 0
         && viewLoc.y < static_cast<int32_t>(myviewport->height))
     {
-        viewLoc.x = myviewport->zoom.ApplyTo(viewLoc.x);
-        viewLoc.y = myviewport->zoom.ApplyTo(viewLoc.y);
-        viewLoc += myviewport->viewPos;
-        if (myviewport->zoom > ZoomLevel{ 0 })
-        {
-            viewLoc.x &= myviewport->zoom.ApplyTo(0xFFFFFFFF) & 0xFFFFFFFF;
-            viewLoc.y &= myviewport->zoom.ApplyTo(0xFFFFFFFF) & 0xFFFFFFFF;
-        }
-        rct_drawpixelinfo dpi;
-        dpi.x = viewLoc.x;
-        dpi.y = viewLoc.y;
-        dpi.height = 1;
-        dpi.zoom_level = myviewport->zoom;
-        dpi.width = 1;
-
-        PaintSession* session = PaintSessionAlloc(&dpi, myviewport->flags);
-        PaintSessionGenerate(*session);
-        PaintSessionArrange(*session);
-        info = set_interaction_info_from_paint_session(session, myviewport->flags, flags & 0xFFFF);
-        PaintSessionFree(session);
+        return get_map_coordinates_from_pos_viewport(*myviewport, viewLoc, flags);
+    }
+    return {};
+}
+
+InteractionInfo get_map_coordinates_from_pos_viewport(
+    const rct_viewport& viewport, const ScreenCoordsXY& viewportCoords, int32_t flags, bool usePaintCache)
+{
+    auto viewLoc = viewportCoords;
+    viewLoc.x = viewport.zoom.ApplyTo(viewLoc.x);
+    viewLoc.y = viewport.zoom.ApplyTo(viewLoc.y);
+    viewLoc += viewport.viewPos;
+    if (viewport.zoom > ZoomLevel{ 0 })
+    {
+        viewLoc.x &= viewport.zoom.ApplyTo(0xFFFFFFFF) & 0xFFFFFFFF;
+        viewLoc.y &= viewport.zoom.ApplyTo(0xFFFFFFFF) & 0xFFFFFFFF;
+    }
+    rct_drawpixelinfo dpi;
+    dpi.x = viewLoc.x;
+    dpi.y = viewLoc.y;
+    dpi.height = 1;
+    dpi.zoom_level = viewport.zoom;
+    dpi.width = 1;
+
+    // Picking from the paint output cached for static tiles avoids painting the whole column under the cursor.
+    if (usePaintCache)
+    {
+        auto* pickHead = PaintSessionPick(dpi, viewport.flags);
+        if (pickHead != nullptr)
+        {
+            return set_interaction_info_from_paint_structs(pickHead, &dpi, viewport.flags, flags & 0xFFFF);
+        }
     }
+
+    PaintSession* session = PaintSessionAlloc(&dpi, viewport.flags);
+    PaintSessionGenerate(*session);
+    PaintSessionArrange(*session);
+    auto info = set_interaction_info_from_paint_session(session, viewport.flags, flags & 0xFFFF);
+    PaintSessionFree(session);
     return info;
 }
 
@@ -1942,6 +1949,12 @@ void viewport_invalidate(const rct_viewport* viewport, const ScreenRect& screenR
 
         bottomRight = { std::min(bottomRight.x, viewportRight), std::min(bottomRight.y, viewportBottom) };
         bottomRight -= viewport->viewPos;
+        // Round outwards when zoomed out, dirty rects are no longer padded to whole blocks to cover partial pixels.
+        if (viewport->zoom > ZoomLevel{ 0 })
+        {
+            const auto roundUp = viewport->zoom.ApplyTo(1) - 1;
+            bottomRight += ScreenCoordsXY{ roundUp, roundUp };
+        }
         bottomRight = { viewport->zoom.ApplyInversedTo(bottomRight.x), viewport->zoom.ApplyInversedTo(bottomRight.y) };
         bottomRight += viewport->pos;
 
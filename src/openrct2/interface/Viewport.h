@@ -131,12 +131,13 @@ void viewport_update_smart_sprite_follow(rct_window* window);
 void viewport_update_smart_guest_follow(rct_window* window, const Guest* peep);
 void viewport_update_smart_staff_follow(rct_window* window, const Staff* peep);
 void viewport_update_smart_vehicle_follow(rct_window* window);
+// Without a threading choice the multithreading setting decides whether columns are painted on the paint job pool.
 void viewport_render(
     rct_drawpixelinfo* dpi, const rct_viewport* viewport, const ScreenRect& screenRect,
-    std::vector<RecordedPaintSession>* sessions = nullptr);
+    std::vector<RecordedPaintSession>* sessions = nullptr, std::optional<bool> multiThreading = std::nullopt);
 void viewport_paint(
     const rct_viewport* viewport, rct_drawpixelinfo* dpi, const ScreenRect& screenRect,
-    std::vector<RecordedPaintSession>* sessions = nullptr);
+    std::vector<RecordedPaintSession>* sessions = nullptr, std::optional<bool> multiThreading = std::nullopt);
 
 CoordsXYZ viewport_adjust_for_map_height(const ScreenCoordsXY& startCoords);
 
@@ -153,6 +154,9 @@ void viewport_set_visibility(uint8_t mode);
 
 InteractionInfo get_map_coordinates_from_pos(const ScreenCoordsXY& screenCoords, int32_t flags);
 InteractionInfo get_map_coordinates_from_pos_window(rct_window* window, const ScreenCoordsXY& screenCoords, int32_t flags);
+// Looks up what is drawn at a pixel of the viewport, without the paint cache the pixel is always painted from scratch.
+InteractionInfo get_map_coordinates_from_pos_viewport(
+    const rct_viewport& viewport, const ScreenCoordsXY& viewportCoords, int32_t flags, bool usePaintCache = true);
 
 InteractionInfo set_interaction_info_from_paint_session(PaintSession* session, uint32_t viewFlags, uint16_t filter);
 InteractionInfo ViewportInteractionGetItemLeft(const ScreenCoordsXY& screenCoords);
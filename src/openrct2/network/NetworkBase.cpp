@@ -14,6 +14,7 @@
 #include "../GameStateSnapshots.h"
 #include "../OpenRCT2.h"
 #include "../PlatformEnvironment.h"
+#include "../actions/BatchAction.h"
 #include "../actions/LoadOrQuitAction.h"
 #include "../actions/NetworkModifyGroupAction.h"
 #include "../actions/PeepPickupAction.h"
@@ -43,7 +44,7 @@
 // It is used for making sure only compatible builds get connected, even within
 // single OpenRCT2 version.
 
-#define NETWORK_STREAM_VERSION "4"
+#define NETWORK_STREAM_VERSION "8"
 
 #define NETWORK_STREAM_ID OPENRCT2_VERSION "-" NETWORK_STREAM_VERSION
 
@@ -136,6 +137,7 @@ NetworkBase::NetworkBase(OpenRCT2::IContext& context)
     client_command_handlers[NetworkCommand::ObjectsList] = &NetworkBase::Client_Handle_OBJECTS_LIST;
     client_command_handlers[NetworkCommand::Scripts] = &NetworkBase::Client_Handle_SCRIPTS;
     client_command_handlers[NetworkCommand::GameState] = &NetworkBase::Client_Handle_GAMESTATE;
+    client_command_handlers[NetworkCommand::CompressStream] = &NetworkBase::Client_Handle_COMPRESS_STREAM;
 
     server_command_handlers[NetworkCommand::Auth] = &NetworkBase::Server_Handle_AUTH;
     server_command_handlers[NetworkCommand::Chat] = &NetworkBase::Server_Handle_CHAT;
@@ -147,6 +149,13 @@ NetworkBase::NetworkBase(OpenRCT2::IContext& context)
     server_command_handlers[NetworkCommand::RequestGameState] = &NetworkBase::Server_Handle_REQUEST_GAMESTATE;
     server_command_handlers[NetworkCommand::Heartbeat] = &NetworkBase::Server_Handle_HEARTBEAT;
 
+    // Spectators are read-only, game actions, chat and game state requests are dropped by the relay.
+    relay_command_handlers[NetworkCommand::Auth] = &NetworkBase::Relay_Handle_AUTH;
+    relay_command_handlers[NetworkCommand::GameInfo] = &NetworkBase::Server_Handle_GAMEINFO;
+    relay_command_handlers[NetworkCommand::Token] = &NetworkBase::Server_Handle_TOKEN;
+    relay_command_handlers[NetworkCommand::MapRequest] = &NetworkBase::Relay_Handle_MAPREQUEST;
+    relay_command_handlers[NetworkCommand::Heartbeat] = &NetworkBase::Server_Handle_HEARTBEAT;
+
     _chat_log_fs << std::unitbuf;
     _server_log_fs << std::unitbuf;
 }
@@ -191,8 +200,12 @@ void NetworkBase::Close()
             return;
         }
 
+        // Stop servicing the sockets before the connections go away.
+        _ioThread.reset();
+
         CloseChatLog();
         CloseServerLog();
+        CloseRelay();
         CloseConnection();
 
         client_connection_list.clear();
@@ -259,6 +272,7 @@ bool NetworkBase::BeginClient(const std::string& host, uint16_t port)
         return false;
 
     mode = NETWORK_MODE_CLIENT;
+    _ioThread = std::make_unique<NetworkIoThread>();
 
     log_info("Connecting to %s:%u", host.c_str(), port);
     _host = host;
@@ -348,6 +362,29 @@ bool NetworkBase::BeginClient(const std::string& host, uint16_t port)
     return true;
 }
 
+bool NetworkBase::BeginRelay(const std::string& host, uint16_t port, uint16_t listenPort, const std::string& listenAddress)
+{
+    if (!BeginClient(host, port))
+    {
+        return false;
+    }
+
+    _relayListenSocket = CreateTcpSocket();
+    try
+    {
+        _relayListenSocket->Listen(listenAddress, listenPort);
+    }
+    catch (const std::exception& ex)
+    {
+        Console::Error::WriteLine(ex.what());
+        Close();
+        return false;
+    }
+
+    log_info("Relaying %s:%u to spectators on port %u", host.c_str(), port, listenPort);
+    return true;
+}
+
 bool NetworkBase::BeginServer(uint16_t port, const std::string& address)
 {
     Close();
@@ -355,6 +392,7 @@ bool NetworkBase::BeginServer(uint16_t port, const std::string& address)
         return false;
 
     mode = NETWORK_MODE_SERVER;
+    _ioThread = std::make_unique<NetworkIoThread>();
 
     _userManager.Load();
 
@@ -478,6 +516,10 @@ void NetworkBase::Update()
             break;
         case NETWORK_MODE_CLIENT:
             UpdateClient();
+            if (IsRelay())
+            {
+                UpdateRelay();
+            }
             break;
     }
 
@@ -495,16 +537,10 @@ void NetworkBase::Update()
 
 void NetworkBase::Flush()
 {
-    if (GetMode() == NETWORK_MODE_CLIENT)
+    // Packets are sent by the I/O thread, make it pick up everything queued this tick right away.
+    if (_ioThread != nullptr)
     {
-        _serverConnection->SendQueuedPackets();
-    }
-    else
-    {
-        for (auto& it : client_connection_list)
-        {
-            it->SendQueuedPackets();
-        }
+        _ioThread->Notify();
     }
 }
 
@@ -591,6 +627,7 @@ void NetworkBase::UpdateClient()
                 {
                     status = NETWORK_STATUS_CONNECTED;
                     _serverConnection->ResetLastPacketTime();
+                    _ioThread->Add(*_serverConnection);
                     Client_Send_TOKEN();
                     char str_authenticating[256];
                     format_string(str_authenticating, 256, STR_MULTIPLAYER_AUTHENTICATING, nullptr);
@@ -725,6 +762,8 @@ const char* NetworkBase::FormatChat(NetworkPlayer* fromplayer, const char* text)
 
 void NetworkBase::SendPacketToClients(const NetworkPacket& packet, bool front, bool gameCmd) const
 {
+    // Serialise the packet once, all connections share the same buffer.
+    NetworkWirePacketPtr wire;
     for (auto& client_connection : client_connection_list)
     {
         if (gameCmd)
@@ -738,7 +777,11 @@ void NetworkBase::SendPacketToClients(const NetworkPacket& packet, bool front, b
                 continue;
             }
         }
-        client_connection->QueuePacket(packet, front);
+        if (wire == nullptr)
+        {
+            wire = packet.ToWire();
+        }
+        client_connection->QueuePacket(wire, front);
     }
 }
 
@@ -758,16 +801,28 @@ bool NetworkBase::CheckSRAND(uint32_t tick, uint32_t srand0)
     if (storedTick.srand0 != srand0)
     {
         log_info("Srand0 mismatch, client = %08X, server = %08X", srand0, storedTick.srand0);
+        _serverState.desyncSections = 0;
         return false;
     }
 
-    if (!storedTick.spriteHash.empty())
+    if (storedTick.checksum.has_value())
     {
-        EntitiesChecksum checksum = GetAllEntitiesChecksum();
-        std::string clientSpriteHash = checksum.ToString();
-        if (clientSpriteHash != storedTick.spriteHash)
+        const auto checksum = GetGameStateChecksum();
+        const auto mismatch = checksum.Compare(*storedTick.checksum);
+        if (mismatch != 0)
         {
-            log_info("Sprite hash mismatch, client = %s, server = %s", clientSpriteHash.c_str(), storedTick.spriteHash.c_str());
+            for (size_t i = 0; i < checksum.Sections.size(); i++)
+            {
+                if (mismatch & (1u << i))
+                {
+                    log_info(
+                        "Checksum mismatch for %s, client = %016llx, server = %016llx",
+                        GetGameStateChecksumSectionName(static_cast<GameStateChecksumSection>(i)),
+                        static_cast<unsigned long long>(checksum.Sections[i]),
+                        static_cast<unsigned long long>(storedTick.checksum->Sections[i]));
+                }
+            }
+            _serverState.desyncSections = mismatch;
             return false;
         }
     }
@@ -780,6 +835,11 @@ bool NetworkBase::IsDesynchronised() const noexcept
     return _serverState.state == NetworkServerState::Desynced;
 }
 
+bool NetworkBase::IsClientMapLoaded() const noexcept
+{
+    return _clientMapLoaded;
+}
+
 bool NetworkBase::CheckDesynchronizaton()
 {
     // Check synchronisation
@@ -1187,7 +1247,7 @@ void NetworkBase::Client_Send_RequestGameState(uint32_t tick)
     log_verbose("Requesting gamestate from server for tick %u", tick);
 
     NetworkPacket packet(NetworkCommand::RequestGameState);
-    packet << tick;
+    packet << tick << _serverState.desyncSections;
     _serverConnection->QueuePacket(std::move(packet));
 }
 
@@ -1210,6 +1270,7 @@ void NetworkBase::Client_Send_AUTH(
     assert(signature.size() <= static_cast<size_t>(UINT32_MAX));
     packet << static_cast<uint32_t>(signature.size());
     packet.Write(signature.data(), signature.size());
+    packet << static_cast<uint8_t>(gConfigNetwork.CompressStream ? 1 : 0);
     _serverConnection->AuthStatus = NetworkAuth::Requested;
     _serverConnection->QueuePacket(std::move(packet));
 }
@@ -1322,6 +1383,14 @@ void NetworkBase::Server_Send_SCRIPTS(NetworkConnection& connection)
     connection.QueuePacket(std::move(packet));
 }
 
+void NetworkBase::Send_COMPRESS_STREAM(NetworkConnection& connection) const
+{
+    log_verbose("Enabling stream compression");
+
+    NetworkPacket packet(NetworkCommand::CompressStream);
+    connection.QueuePacket(std::move(packet));
+}
+
 void NetworkBase::Client_Send_HEARTBEAT(NetworkConnection& connection) const
 {
     log_verbose("Sending heartbeat");
@@ -1335,16 +1404,17 @@ NetworkStats_t NetworkBase::GetStats() const
     NetworkStats_t stats = {};
     if (mode == NETWORK_MODE_CLIENT)
     {
-        stats = _serverConnection->Stats;
+        stats = _serverConnection->GetStats();
     }
     else
     {
         for (auto& connection : client_connection_list)
         {
+            const auto connectionStats = connection->GetStats();
             for (size_t n = 0; n < EnumValue(NetworkStatisticsGroup::Max); n++)
             {
-                stats.bytesReceived[n] += connection->Stats.bytesReceived[n];
-                stats.bytesSent[n] += connection->Stats.bytesSent[n];
+                stats.bytesReceived[n] += connectionStats.bytesReceived[n];
+                stats.bytesSent[n] += connectionStats.bytesSent[n];
             }
         }
     }
@@ -1450,12 +1520,13 @@ void NetworkBase::Server_Send_CHAT(const char* text, const std::vector<uint8_t>&
     }
     else
     {
+        auto wire = packet.ToWire();
         for (auto playerId : playerIds)
         {
             auto conn = GetPlayerConnection(playerId);
             if (conn != nullptr)
             {
-                conn->QueuePacket(packet);
+                conn->QueuePacket(wire);
             }
         }
     }
@@ -1499,12 +1570,12 @@ void NetworkBase::Server_Send_TICK()
     NetworkPacket packet(NetworkCommand::Tick);
     packet << gCurrentTicks << scenario_rand_state().s0;
     uint32_t flags = 0;
-    // Simple counter which limits how often a sprite checksum gets sent.
-    // This can get somewhat expensive, so we don't want to push it every tick in release,
-    // but debug version can check more often.
+    // Simple counter which limits how often a checksum gets sent, configured by the server.
+    // The entity part only rehashes entities that changed, but most guests move every tick
+    // and the tile elements are hashed from scratch.
     static int32_t checksum_counter = 0;
     checksum_counter++;
-    if (checksum_counter >= 100)
+    if (checksum_counter >= gConfigNetwork.ChecksumInterval)
     {
         checksum_counter = 0;
         flags |= NETWORK_TICK_FLAG_CHECKSUMS;
@@ -1514,8 +1585,12 @@ void NetworkBase::Server_Send_TICK()
     packet << flags;
     if (flags & NETWORK_TICK_FLAG_CHECKSUMS)
     {
-        EntitiesChecksum checksum = GetAllEntitiesChecksum();
-        packet.WriteString(checksum.ToString());
+        const auto checksum = GetGameStateChecksum();
+        packet << static_cast<uint8_t>(checksum.Sections.size());
+        for (auto section : checksum.Sections)
+        {
+            packet << section;
+        }
     }
 
     SendPacketToClients(packet);
@@ -1651,38 +1726,31 @@ void NetworkBase::Server_Send_EVENT_PLAYER_DISCONNECTED(const char* playerName,
 
 bool NetworkBase::ProcessConnection(NetworkConnection& connection)
 {
-    NetworkReadPacket packetStatus;
-
+    // Packets have already been read and framed by the I/O thread, only apply them here.
+    // The disconnect flag is set after the last packet was queued, so check it before draining the queue.
+    const bool ioDisconnected = connection.IsIoDisconnected();
+    NetworkPacket packet;
     uint32_t countProcessed = 0;
-    do
+    while (countProcessed < MaxPacketsPerUpdate && connection.PopInboundPacket(packet))
     {
         countProcessed++;
-        packetStatus = connection.ReadPacket();
-        switch (packetStatus)
+        ProcessPacket(connection, packet);
+        if (!connection.IsValid())
         {
-            case NetworkReadPacket::Disconnected:
-                // closed connection or network error
-                if (!connection.GetLastDisconnectReason())
-                {
-                    connection.SetLastDisconnectReason(STR_MULTIPLAYER_CONNECTION_CLOSED);
-                }
-                return false;
-            case NetworkReadPacket::Success:
-                // done reading in packet
-                ProcessPacket(connection, connection.InboundPacket);
-                if (!connection.IsValid())
-                {
-                    return false;
-                }
-                break;
-            case NetworkReadPacket::MoreData:
-                // more data required to be read
-                break;
-            case NetworkReadPacket::NoData:
-                // could not read anything from socket
-                break;
+            return false;
+        }
+    }
+
+    // Only report the disconnect once everything received before it has been processed.
+    if (ioDisconnected && countProcessed < MaxPacketsPerUpdate)
+    {
+        // closed connection or network error
+        if (!connection.GetLastDisconnectReason())
+        {
+            connection.SetLastDisconnectReason(STR_MULTIPLAYER_CONNECTION_CLOSED);
         }
-    } while (packetStatus == NetworkReadPacket::Success && countProcessed < MaxPacketsPerUpdate);
+        return false;
+    }
 
     if (!connection.ReceivedPacketRecently())
     {
@@ -1698,7 +1766,15 @@ bool NetworkBase::ProcessConnection(NetworkConnection& connection)
 
 void NetworkBase::ProcessPacket(NetworkConnection& connection, NetworkPacket& packet)
 {
-    const auto& handlerList = GetMode() == NETWORK_MODE_SERVER ? server_command_handlers : client_command_handlers;
+    const bool isSpectator = IsRelay() && &connection != _serverConnection.get();
+    if (IsRelay() && !isSpectator && connection.AuthStatus == NetworkAuth::Ok)
+    {
+        RelayPacket(packet);
+    }
+
+    const auto& handlerList = GetMode() == NETWORK_MODE_SERVER
+        ? server_command_handlers
+        : (isSpectator ? relay_command_handlers : client_command_handlers);
 
     auto it = handlerList.find(packet.GetCommand());
     if (it != handlerList.end())
@@ -1929,7 +2005,9 @@ void NetworkBase::ProcessDisconnectedClients()
             continue;
         }
 
-        // Make sure to send all remaining packets out before disconnecting.
+        // Make sure to send all remaining packets out before disconnecting, the I/O thread has to let go of
+        // the connection first.
+        _ioThread->Remove(*connection);
         connection->SendQueuedPackets();
         connection->Socket->Disconnect();
 
@@ -1950,10 +2028,259 @@ void NetworkBase::AddClient(std::unique_ptr<ITcpSocket>&& socket)
     // Store connection
     auto connection = std::make_unique<NetworkConnection>();
     connection->Socket = std::move(socket);
+    _ioThread->Add(*connection);
 
     client_connection_list.push_back(std::move(connection));
 }
 
+bool NetworkBase::IsRelay() const noexcept
+{
+    return _relayListenSocket != nullptr;
+}
+
+void NetworkBase::UpdateRelay()
+{
+    // The map sent to new spectators already contains everything before the current tick.
+    if (_clientMapLoaded)
+    {
+        _relayBacklog.erase(
+            std::remove_if(
+                _relayBacklog.begin(), _relayBacklog.end(),
+                [](const RelayBacklogEntry& entry) { return entry.Tick < gCurrentTicks; }),
+            _relayBacklog.end());
+    }
+
+    for (auto it = _relaySpectators.begin(); it != _relaySpectators.end();)
+    {
+        auto& connection = *it->Connection;
+        if (connection.IsValid() && !ProcessConnection(connection))
+        {
+            connection.Disconnect();
+        }
+
+        if (connection.IsValid())
+        {
+            it++;
+            continue;
+        }
+
+        // Make sure to send all remaining packets out before disconnecting, the I/O thread has to let go of
+        // the connection first.
+        _ioThread->Remove(connection);
+        connection.SendQueuedPackets();
+        connection.Socket->Disconnect();
+        log_info("Spectator %s left", connection.Socket->GetHostName());
+        it = _relaySpectators.erase(it);
+    }
+
+    std::unique_ptr<ITcpSocket> tcpSocket = _relayListenSocket->Accept();
+    if (tcpSocket != nullptr)
+    {
+        auto& spectator = _relaySpectators.emplace_back();
+        spectator.Connection = std::make_unique<NetworkConnection>();
+        spectator.Connection->Socket = std::move(tcpSocket);
+        _ioThread->Add(*spectator.Connection);
+    }
+}
+
+void NetworkBase::CloseRelay()
+{
+    for (auto& spectator : _relaySpectators)
+    {
+        spectator.Connection->Socket->Disconnect();
+    }
+    _relaySpectators.clear();
+    _relayBacklog.clear();
+    _relayListenSocket.reset();
+}
+
+void NetworkBase::RelayPacket(NetworkPacket& packet)
+{
+    bool hasTick = false;
+    switch (packet.GetCommand())
+    {
+        case NetworkCommand::Tick:
+        case NetworkCommand::GameAction:
+        case NetworkCommand::PlayerList:
+        case NetworkCommand::PlayerInfo:
+            hasTick = true;
+            break;
+        case NetworkCommand::Chat:
+        case NetworkCommand::GroupList:
+        case NetworkCommand::Event:
+        case NetworkCommand::PingList:
+            break;
+        default:
+            return;
+    }
+
+    // Serialised once, the same buffer is queued on every spectator.
+    auto wire = packet.ToWire();
+    if (hasTick)
+    {
+        uint32_t tick;
+        packet >> tick;
+        packet.BytesRead = 0;
+        _relayBacklog.push_back({ tick, wire });
+    }
+
+    for (auto& spectator : _relaySpectators)
+    {
+        if (spectator.Streaming)
+        {
+            spectator.Connection->QueuePacket(wire);
+        }
+    }
+}
+
+void NetworkBase::Relay_BeginMapChange()
+{
+    // Spectators get the new map once the relay has loaded it, nothing of the old stream applies anymore.
+    _relayBacklog.clear();
+
+    auto& objManager = GetContext().GetObjectManager();
+    for (auto& spectator : _relaySpectators)
+    {
+        if (spectator.Streaming)
+        {
+            spectator.Streaming = false;
+            spectator.MapRequested = true;
+            spectator.Connection->RequestedObjects = objManager.GetPackableObjects();
+        }
+    }
+}
+
+void NetworkBase::Relay_EndMapChange()
+{
+    _relayBacklog.erase(
+        std::remove_if(
+            _relayBacklog.begin(), _relayBacklog.end(),
+            [](const RelayBacklogEntry& entry) { return entry.Tick < gCurrentTicks; }),
+        _relayBacklog.end());
+
+    for (auto& spectator : _relaySpectators)
+    {
+        if (spectator.MapRequested)
+        {
+            Relay_Send_MAP(*spectator.Connection);
+            spectator.MapRequested = false;
+            spectator.Streaming = true;
+        }
+    }
+}
+
+void NetworkBase::Relay_Send_AUTH(NetworkConnection& connection)
+{
+    // Spectators see the game through the relay's own player.
+    NetworkPacket packet(NetworkCommand::Auth);
+    packet << static_cast<uint32_t>(connection.AuthStatus) << player_id;
+    if (connection.AuthStatus == NetworkAuth::BadVersion)
+    {
+        packet.WriteString(network_get_version());
+    }
+    connection.QueuePacket(std::move(packet));
+    if (connection.AuthStatus != NetworkAuth::Ok)
+    {
+        connection.Disconnect();
+    }
+}
+
+void NetworkBase::Relay_Send_MAP(NetworkConnection& connection)
+{
+    Server_Send_MAP(&connection);
+    Server_Send_GROUPLIST(connection);
+    Relay_Send_PLAYERLIST(connection);
+
+    // Everything the relay received for ticks it has not simulated yet is not part of the map.
+    for (const auto& entry : _relayBacklog)
+    {
+        connection.QueuePacket(entry.Packet);
+    }
+}
+
+void NetworkBase::Relay_Send_PLAYERLIST(NetworkConnection& connection)
+{
+    NetworkPacket packet(NetworkCommand::PlayerList);
+    packet << gCurrentTicks << static_cast<uint8_t>(player_list.size());
+    for (auto& player : player_list)
+    {
+        player->Write(packet);
+    }
+    connection.QueuePacket(std::move(packet));
+}
+
+void NetworkBase::Relay_Handle_AUTH(NetworkConnection& connection, NetworkPacket& packet)
+{
+    if (connection.AuthStatus == NetworkAuth::Ok)
+    {
+        return;
+    }
+
+    // Spectators join anonymously, only the version has to match. Name, password and key are skipped.
+    auto* hostName = connection.Socket->GetHostName();
+    auto gameversion = packet.ReadString();
+    packet.ReadString();
+    packet.ReadString();
+    packet.ReadString();
+    uint32_t sigsize;
+    packet >> sigsize;
+    packet.Read(sigsize);
+    uint8_t compressStream = 0;
+    packet >> compressStream;
+    connection.CompressStreamRequested = compressStream != 0;
+
+    const auto spectatorCount = std::count_if(_relaySpectators.begin(), _relaySpectators.end(), [](const auto& spectator) {
+        return spectator.Connection->AuthStatus == NetworkAuth::Ok;
+    });
+    if (gameversion != network_get_version())
+    {
+        connection.AuthStatus = NetworkAuth::BadVersion;
+        log_info("Spectator %s: Bad version.", hostName);
+    }
+    else if (spectatorCount >= gConfigNetwork.Maxplayers)
+    {
+        connection.AuthStatus = NetworkAuth::Full;
+        log_info("Spectator %s: Relay is full.", hostName);
+    }
+    else
+    {
+        connection.AuthStatus = NetworkAuth::Ok;
+        if (connection.CompressStreamRequested && gConfigNetwork.CompressStream)
+        {
+            Send_COMPRESS_STREAM(connection);
+        }
+        auto& objManager = GetContext().GetObjectManager();
+        Server_Send_OBJECTS_LIST(connection, objManager.GetPackableObjects());
+        Server_Send_SCRIPTS(connection);
+        log_info("Spectator %s joined", hostName);
+    }
+
+    Relay_Send_AUTH(connection);
+}
+
+void NetworkBase::Relay_Handle_MAPREQUEST(NetworkConnection& connection, NetworkPacket& packet)
+{
+    ReadRequestedObjects(connection, packet);
+
+    auto it = std::find_if(_relaySpectators.begin(), _relaySpectators.end(), [&connection](const auto& spectator) {
+        return spectator.Connection.get() == &connection;
+    });
+    if (it == _relaySpectators.end())
+    {
+        return;
+    }
+
+    if (_clientMapLoaded)
+    {
+        Relay_Send_MAP(connection);
+        it->Streaming = true;
+    }
+    else
+    {
+        it->MapRequested = true;
+    }
+}
+
 void NetworkBase::ServerClientDisconnected(std::unique_ptr<NetworkConnection>& connection)
 {
     NetworkPlayer* connection_player = connection->Player;
@@ -2165,10 +2492,30 @@ void NetworkBase::Client_Handle_TOKEN(NetworkConnection& connection, NetworkPack
     Client_Send_AUTH(gConfigNetwork.PlayerName, gCustomPassword, pubkey, signature);
 }
 
+// Entity types covered by the diverging sections, nullopt if it is not known which sections diverged so all entities
+// are needed, an empty list if only sections that are not about entities diverged.
+static std::optional<std::vector<EntityType>> GetDesyncEntityTypes(GameStateChecksumSectionMask sections)
+{
+    if (sections == 0)
+        return std::nullopt;
+
+    std::vector<EntityType> entityTypes;
+    for (size_t i = 0; i < EnumValue(GameStateChecksumSection::Count); i++)
+    {
+        auto entityType = GetGameStateChecksumSectionEntityType(static_cast<GameStateChecksumSection>(i));
+        if ((sections & (1u << i)) && entityType.has_value())
+        {
+            entityTypes.push_back(*entityType);
+        }
+    }
+    return entityTypes;
+}
+
 void NetworkBase::Server_Handle_REQUEST_GAMESTATE(NetworkConnection& connection, NetworkPacket& packet)
 {
     uint32_t tick;
-    packet >> tick;
+    GameStateChecksumSectionMask sections;
+    packet >> tick >> sections;
 
     if (_serverState.gamestateSnapshotsEnabled == false)
     {
@@ -2184,7 +2531,8 @@ void NetworkBase::Server_Handle_REQUEST_GAMESTATE(NetworkConnection& connection,
         MemoryStream snapshotMemory;
         DataSerialiser ds(true, snapshotMemory);
 
-        snapshots->SerialiseSnapshot(const_cast<GameStateSnapshot_t&>(*snapshot), ds);
+        // Only send the entities of the sections the client found to be different, if any.
+        snapshots->SerialiseSnapshot(const_cast<GameStateSnapshot_t&>(*snapshot), ds, GetDesyncEntityTypes(sections));
 
         uint32_t bytesSent = 0;
         uint32_t length = static_cast<uint32_t>(snapshotMemory.GetLength());
@@ -2213,6 +2561,12 @@ void NetworkBase::Server_Handle_HEARTBEAT(NetworkConnection& connection, Network
     connection.ResetLastPacketTime();
 }
 
+void NetworkBase::Client_Handle_COMPRESS_STREAM(NetworkConnection& connection, [[maybe_unused]] NetworkPacket& packet)
+{
+    // The server compresses everything after this packet, do the same for the other direction.
+    Send_COMPRESS_STREAM(connection);
+}
+
 void NetworkBase::Client_Handle_AUTH(NetworkConnection& connection, NetworkPacket& packet)
 {
     uint32_t auth_status;
@@ -2437,7 +2791,8 @@ void NetworkBase::Client_Handle_GAMESTATE(NetworkConnection& connection, Network
         const GameStateSnapshot_t* desyncSnapshot = snapshots->GetLinkedSnapshot(tick);
         if (desyncSnapshot != nullptr)
         {
-            GameStateCompareData_t cmpData = snapshots->Compare(serverSnapshot, *desyncSnapshot);
+            GameStateCompareData_t cmpData = snapshots->Compare(
+                serverSnapshot, *desyncSnapshot, GetDesyncEntityTypes(_serverState.desyncSections));
 
             std::string outputPath = GetContext().GetPlatformEnvironment()->GetDirectoryPath(DIRBASE::USER, DIRID::LOG_DESYNCS);
 
@@ -2465,10 +2820,23 @@ void NetworkBase::Client_Handle_GAMESTATE(NetworkConnection& connection, Network
                 context_open_intent(&intent);
             }
         }
+
+        // The sections belong to this desync only, a later request must not narrow its report down to them.
+        _serverState.desyncSections = 0;
     }
 }
 
 void NetworkBase::Server_Handle_MAPREQUEST(NetworkConnection& connection, NetworkPacket& packet)
+{
+    ReadRequestedObjects(connection, packet);
+
+    auto player_name = connection.Player->Name.c_str();
+    Server_Send_MAP(&connection);
+    Server_Send_EVENT_PLAYER_JOINED(player_name);
+    Server_Send_GROUPLIST(connection);
+}
+
+void NetworkBase::ReadRequestedObjects(NetworkConnection& connection, NetworkPacket& packet)
 {
     uint32_t size;
     packet >> size;
@@ -2504,11 +2872,6 @@ void NetworkBase::Server_Handle_MAPREQUEST(NetworkConnection& connection, Networ
             connection.RequestedObjects.push_back(item);
         }
     }
-
-    auto player_name = connection.Player->Name.c_str();
-    Server_Send_MAP(&connection);
-    Server_Send_EVENT_PLAYER_JOINED(player_name);
-    Server_Send_GROUPLIST(connection);
 }
 
 void NetworkBase::Server_Handle_AUTH(NetworkConnection& connection, NetworkPacket& packet)
@@ -2582,6 +2945,10 @@ void NetworkBase::Server_Handle_AUTH(NetworkConnection& connection, NetworkPacke
                 connection.AuthStatus = NetworkAuth::VerificationFailure;
                 log_verbose("Connection %s: Signature verification failed, invalid data!", hostName);
             }
+
+            uint8_t compressStream = 0;
+            packet >> compressStream;
+            connection.CompressStreamRequested = compressStream != 0;
         }
 
         bool passwordless = false;
@@ -2625,6 +2992,11 @@ void NetworkBase::Server_Handle_AUTH(NetworkConnection& connection, NetworkPacke
             if (ProcessPlayerAuthenticatePluginHooks(connection, name, hash))
             {
                 connection.AuthStatus = NetworkAuth::Ok;
+                if (connection.CompressStreamRequested && gConfigNetwork.CompressStream)
+                {
+                    // Sent before the objects list and scripts so these already benefit from it.
+                    Send_COMPRESS_STREAM(connection);
+                }
                 Server_Client_Joined(name, hash, connection);
             }
             else
@@ -2656,6 +3028,11 @@ void NetworkBase::Client_Handle_MAP([[maybe_unused]] NetworkConnection& connecti
 
         _serverTickData.clear();
         _clientMapLoaded = false;
+
+        if (IsRelay())
+        {
+            Relay_BeginMapChange();
+        }
     }
     if (size > chunk_buffer.size())
     {
@@ -2708,6 +3085,11 @@ void NetworkBase::Client_Handle_MAP([[maybe_unused]] NetworkConnection& connecti
             // Given that during map load game actions are buffered we have to process the
             // player list first to have valid players for the queued game actions.
             ProcessPlayerList();
+
+            if (IsRelay())
+            {
+                Relay_EndMapChange();
+            }
         }
         else
         {
@@ -2895,7 +3277,8 @@ void NetworkBase::Server_Handle_GAME_ACTION(NetworkConnection& connection, Netwo
         return;
     }
 
-    if (actionType != GameCommand::Custom)
+    // Batches are checked by the actions they contain once they are read.
+    if (actionType != GameCommand::Custom && actionType != GameCommand::Batch)
     {
         // Check if player's group permission allows command to run
         NetworkGroup* group = GetGroupByID(connection.Player->Group);
@@ -2916,34 +3299,66 @@ void NetworkBase::Server_Handle_GAME_ACTION(NetworkConnection& connection, Netwo
         return;
     }
 
-    // Player who is hosting is not affected by cooldowns.
-    if ((player->Flags & NETWORK_PLAYER_FLAG_ISSERVER) == 0)
+    DataSerialiser stream(false);
+    const size_t size = packet.Header.Size - packet.BytesRead;
+    stream.GetStream().WriteArray(packet.Read(size), size);
+    stream.GetStream().SetPosition(0);
+
+    ga->Serialise(stream);
+    // Set player to sender, should be 0 if sent from client.
+    ga->SetPlayer(NetworkPlayerId_t{ connection.Player->Id });
+
+    if (actionType == GameCommand::Batch)
     {
-        auto cooldownIt = player->CooldownTime.find(actionType);
-        if (cooldownIt != std::end(player->CooldownTime))
+        NetworkGroup* group = GetGroupByID(connection.Player->Group);
+        for (const auto& action : static_cast<const BatchAction&>(*ga).GetActions())
         {
-            if (cooldownIt->second > 0)
+            auto batchedType = action->GetType();
+            if (batchedType == GameCommand::TogglePause || batchedType == GameCommand::LoadOrQuit)
             {
-                Server_Send_SHOWERROR(connection, STR_CANT_DO_THIS, STR_NETWORK_ACTION_RATE_LIMIT_MESSAGE);
+                return;
+            }
+            if (batchedType != GameCommand::Custom && (group == nullptr || !group->CanPerformCommand(batchedType)))
+            {
+                Server_Send_SHOWERROR(connection, STR_CANT_DO_THIS, STR_PERMISSION_DENIED);
                 return;
             }
         }
+    }
 
-        uint32_t cooldownTime = ga->GetCooldownTime();
-        if (cooldownTime > 0)
+    // Player who is hosting is not affected by cooldowns. The actions in a batch are rate limited like the same actions
+    // sent one by one, so a batch is rejected as a whole if any of them is cooling down or a rate limited action is in it
+    // more than once.
+    if ((player->Flags & NETWORK_PLAYER_FLAG_ISSERVER) == 0)
+    {
+        std::vector<const GameAction*> cooldownActions;
+        if (actionType == GameCommand::Batch)
         {
-            player->CooldownTime[actionType] = cooldownTime;
+            for (const auto& action : static_cast<const BatchAction&>(*ga).GetActions())
+            {
+                cooldownActions.push_back(action.get());
+            }
         }
-    }
+        cooldownActions.push_back(ga.get());
 
-    DataSerialiser stream(false);
-    const size_t size = packet.Header.Size - packet.BytesRead;
-    stream.GetStream().WriteArray(packet.Read(size), size);
-    stream.GetStream().SetPosition(0);
+        auto cooldownTimes = player->CooldownTime;
+        for (const auto* action : cooldownActions)
+        {
+            auto cooldownIt = cooldownTimes.find(action->GetType());
+            if (cooldownIt != std::end(cooldownTimes) && cooldownIt->second > 0)
+            {
+                Server_Send_SHOWERROR(connection, STR_CANT_DO_THIS, STR_NETWORK_ACTION_RATE_LIMIT_MESSAGE);
+                return;
+            }
 
-    ga->Serialise(stream);
-    // Set player to sender, should be 0 if sent from client.
-    ga->SetPlayer(NetworkPlayerId_t{ connection.Player->Id });
+            uint32_t cooldownTime = action->GetCooldownTime();
+            if (cooldownTime > 0)
+            {
+                cooldownTimes[action->GetType()] = cooldownTime;
+            }
+        }
+        player->CooldownTime = std::move(cooldownTimes);
+    }
 
     GameActions::Enqueue(std::move(ga), tick);
 }
@@ -2962,11 +3377,20 @@ void NetworkBase::Client_Handle_TICK([[maybe_unused]] NetworkConnection& connect
 
     if (flags & NETWORK_TICK_FLAG_CHECKSUMS)
     {
-        auto text = packet.ReadString();
-        if (!text.empty())
+        uint8_t numSections;
+        packet >> numSections;
+
+        GameStateChecksum checksum;
+        for (uint8_t i = 0; i < numSections; i++)
         {
-            tickData.spriteHash = text;
+            uint64_t section;
+            packet >> section;
+            if (i < checksum.Sections.size())
+            {
+                checksum.Sections[i] = section;
+            }
         }
+        tickData.checksum = checksum;
     }
 
     // Don't let the history grow too much.
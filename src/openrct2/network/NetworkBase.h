@@ -1,17 +1,22 @@
 #pragma once
 
+#include "../GameStateChecksum.h"
 #include "../System.hpp"
 #include "../actions/GameAction.h"
 #include "../object/Object.h"
 #include "NetworkConnection.h"
 #include "NetworkGroup.h"
+#include "NetworkIoThread.h"
 #include "NetworkPlayer.h"
 #include "NetworkServerAdvertiser.h"
 #include "NetworkTypes.h"
 #include "NetworkUser.h"
 
+#include <deque>
 #include <fstream>
+#include <list>
 #include <memory>
+#include <optional>
 
 #ifndef DISABLE_NETWORK
 
@@ -28,6 +33,7 @@ public:
 public: // Uncategorized
     bool BeginServer(uint16_t port, const std::string& address);
     bool BeginClient(const std::string& host, uint16_t port);
+    bool BeginRelay(const std::string& host, uint16_t port, uint16_t listenPort, const std::string& listenAddress);
 
 public: // Common
     bool Init();
@@ -81,6 +87,7 @@ public: // Server
     bool SaveMap(OpenRCT2::IStream* stream, const std::vector<const ObjectRepositoryItem*>& objects) const;
     std::vector<uint8_t> save_for_network(const std::vector<const ObjectRepositoryItem*>& objects) const;
     std::string MakePlayerNameUnique(const std::string& name);
+    void ReadRequestedObjects(NetworkConnection& connection, NetworkPacket& packet);
 
     // Packet dispatchers.
     void Server_Send_AUTH(NetworkConnection& connection);
@@ -128,6 +135,7 @@ public: // Client
     bool CheckDesynchronizaton();
     void RequestStateSnapshot();
     bool IsDesynchronised() const noexcept;
+    bool IsClientMapLoaded() const noexcept;
     NetworkServerState_t GetServerState() const noexcept;
     void ServerClientDisconnected();
     bool LoadMap(OpenRCT2::IStream* stream);
@@ -144,6 +152,7 @@ public: // Client
     void Client_Send_GAMEINFO();
     void Client_Send_MAPREQUEST(const std::vector<ObjectEntryDescriptor>& objects);
     void Client_Send_HEARTBEAT(NetworkConnection& connection) const;
+    void Send_COMPRESS_STREAM(NetworkConnection& connection) const;
 
     // Handlers.
     void Client_Handle_AUTH(NetworkConnection& connection, NetworkPacket& packet);
@@ -164,6 +173,20 @@ public: // Client
     void Client_Handle_OBJECTS_LIST(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_SCRIPTS(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_GAMESTATE(NetworkConnection& connection, NetworkPacket& packet);
+    void Client_Handle_COMPRESS_STREAM(NetworkConnection& connection, NetworkPacket& packet);
+
+public: // Relay
+    bool IsRelay() const noexcept;
+    void UpdateRelay();
+    void CloseRelay();
+    void RelayPacket(NetworkPacket& packet);
+    void Relay_BeginMapChange();
+    void Relay_EndMapChange();
+    void Relay_Send_AUTH(NetworkConnection& connection);
+    void Relay_Send_MAP(NetworkConnection& connection);
+    void Relay_Send_PLAYERLIST(NetworkConnection& connection);
+    void Relay_Handle_AUTH(NetworkConnection& connection, NetworkPacket& packet);
+    void Relay_Handle_MAPREQUEST(NetworkConnection& connection, NetworkPacket& packet);
 
     std::vector<uint8_t> _challenge;
     std::map<uint32_t, GameAction::Callback_t> _gameActionCallbacks;
@@ -214,7 +237,7 @@ private: // Client Data
     {
         uint32_t srand0;
         uint32_t tick;
-        std::string spriteHash;
+        std::optional<GameStateChecksum> checksum;
     };
 
     std::unordered_map<NetworkCommand, CommandHandler> client_command_handlers;
@@ -239,6 +262,32 @@ private: // Client Data
     SocketStatus _lastConnectStatus = SocketStatus::Closed;
     bool _requireReconnect = false;
     bool _clientMapLoaded = false;
+
+private: // Relay Data
+    struct RelaySpectator
+    {
+        std::unique_ptr<NetworkConnection> Connection;
+        // Waiting for the relay to have a map it can send.
+        bool MapRequested = false;
+        // Receives the stream forwarded from the upstream server.
+        bool Streaming = false;
+    };
+
+    struct RelayBacklogEntry
+    {
+        uint32_t Tick;
+        NetworkWirePacketPtr Packet;
+    };
+
+    std::unordered_map<NetworkCommand, CommandHandler> relay_command_handlers;
+    std::unique_ptr<ITcpSocket> _relayListenSocket;
+    std::list<RelaySpectator> _relaySpectators;
+    // Forwarded packets for ticks the relay has not simulated yet, new spectators need them after the map.
+    std::deque<RelayBacklogEntry> _relayBacklog;
+
+private: // I/O Data
+    // Declared last so it is stopped before any of the connections it services are destroyed.
+    std::unique_ptr<NetworkIoThread> _ioThread;
 };
 
 #endif // DISABLE_NETWORK
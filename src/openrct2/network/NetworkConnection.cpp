@@ -17,34 +17,164 @@
 #    include "Socket.h"
 #    include "network.h"
 
+#    include <zlib.h>
+
 constexpr size_t NETWORK_DISCONNECT_REASON_BUFFER_SIZE = 256;
 constexpr size_t NetworkBufferSize = 1024 * 64; // 64 KiB, maximum packet size.
+constexpr size_t NetworkCompressionChunkSize = 1024 * 16;
+// Maximum amount of packets read in one I/O pass so a flood on one connection does not starve the others.
+constexpr uint32_t MaxPacketsPerService = 100;
+
+/**
+ * Deflate stream spanning all packets sent on a connection. Every packet is flushed with Z_SYNC_FLUSH
+ * so the receiver can decode it as soon as it arrives, while the window still covers earlier packets.
+ */
+class NetworkStreamCompressor
+{
+    z_stream _stream{};
+
+public:
+    NetworkStreamCompressor()
+    {
+        if (deflateInit(&_stream, Z_DEFAULT_COMPRESSION) != Z_OK)
+        {
+            throw std::runtime_error("deflateInit failed");
+        }
+    }
+
+    ~NetworkStreamCompressor()
+    {
+        deflateEnd(&_stream);
+    }
+
+    void Compress(const uint8_t* data, size_t size, std::vector<uint8_t>& output)
+    {
+        output.clear();
+        _stream.next_in = const_cast<Bytef*>(data);
+        _stream.avail_in = static_cast<uInt>(size);
+        do
+        {
+            const auto offset = output.size();
+            output.resize(offset + std::max(NetworkCompressionChunkSize, size / 2));
+            _stream.next_out = output.data() + offset;
+            _stream.avail_out = static_cast<uInt>(output.size() - offset);
+            if (deflate(&_stream, Z_SYNC_FLUSH) == Z_STREAM_ERROR)
+            {
+                throw std::runtime_error("deflate failed");
+            }
+            output.resize(output.size() - _stream.avail_out);
+        } while (_stream.avail_out == 0);
+    }
+};
+
+class NetworkStreamDecompressor
+{
+    z_stream _stream{};
+
+public:
+    NetworkStreamDecompressor()
+    {
+        if (inflateInit(&_stream) != Z_OK)
+        {
+            throw std::runtime_error("inflateInit failed");
+        }
+    }
+
+    ~NetworkStreamDecompressor()
+    {
+        inflateEnd(&_stream);
+    }
+
+    // Appends the decompressed data to output, returns false if the stream is corrupt.
+    bool Decompress(const uint8_t* data, size_t size, std::vector<uint8_t>& output)
+    {
+        _stream.next_in = const_cast<Bytef*>(data);
+        _stream.avail_in = static_cast<uInt>(size);
+        do
+        {
+            const auto offset = output.size();
+            output.resize(offset + NetworkCompressionChunkSize);
+            _stream.next_out = output.data() + offset;
+            _stream.avail_out = static_cast<uInt>(NetworkCompressionChunkSize);
+            const auto result = inflate(&_stream, Z_SYNC_FLUSH);
+            output.resize(output.size() - _stream.avail_out);
+            if (result != Z_OK && result != Z_BUF_ERROR)
+            {
+                return false;
+            }
+        } while (_stream.avail_out == 0);
+        return true;
+    }
+};
 
 NetworkConnection::NetworkConnection() noexcept
 {
     ResetLastPacketTime();
 }
 
+NetworkConnection::~NetworkConnection() = default;
+
+NetworkReadPacket NetworkConnection::ReceiveData(uint8_t* buffer, size_t size, size_t* sizeReceived)
+{
+    if (_decompressor == nullptr)
+    {
+        return Socket->ReceiveData(buffer, size, sizeReceived);
+    }
+
+    if (_decompressedDataRead == _decompressedData.size())
+    {
+        _decompressedData.clear();
+        _decompressedDataRead = 0;
+
+        uint8_t compressed[NetworkCompressionChunkSize];
+        size_t compressedSize = 0;
+        NetworkReadPacket status = Socket->ReceiveData(compressed, sizeof(compressed), &compressedSize);
+        if (status != NetworkReadPacket::Success)
+        {
+            *sizeReceived = 0;
+            return status;
+        }
+        if (!_decompressor->Decompress(compressed, compressedSize, _decompressedData))
+        {
+            log_verbose("Received invalid compressed data");
+            *sizeReceived = 0;
+            return NetworkReadPacket::Disconnected;
+        }
+        if (_decompressedData.empty())
+        {
+            // Only part of a compressed block has arrived so far.
+            *sizeReceived = 0;
+            return NetworkReadPacket::NoData;
+        }
+    }
+
+    const size_t available = std::min(size, _decompressedData.size() - _decompressedDataRead);
+    std::memcpy(buffer, _decompressedData.data() + _decompressedDataRead, available);
+    _decompressedDataRead += available;
+    *sizeReceived = available;
+    return NetworkReadPacket::Success;
+}
+
 NetworkReadPacket NetworkConnection::ReadPacket()
 {
     size_t bytesRead = 0;
 
     // Read packet header.
-    auto& header = InboundPacket.Header;
-    if (InboundPacket.BytesTransferred < sizeof(InboundPacket.Header))
+    auto& header = _readPacket.Header;
+    if (_readPacket.BytesTransferred < sizeof(_readPacket.Header))
     {
-        const size_t missingLength = sizeof(header) - InboundPacket.BytesTransferred;
+        const size_t missingLength = sizeof(header) - _readPacket.BytesTransferred;
 
-        uint8_t* buffer = reinterpret_cast<uint8_t*>(&InboundPacket.Header);
+        uint8_t* buffer = reinterpret_cast<uint8_t*>(&_readPacket.Header);
 
-        NetworkReadPacket status = Socket->ReceiveData(buffer, missingLength, &bytesRead);
+        NetworkReadPacket status = ReceiveData(buffer, missingLength, &bytesRead);
         if (status != NetworkReadPacket::Success)
         {
             return status;
         }
 
-        InboundPacket.BytesTransferred += bytesRead;
-        if (InboundPacket.BytesTransferred < sizeof(InboundPacket.Header))
+        _readPacket.BytesTransferred += bytesRead;
+        if (_readPacket.BytesTransferred < sizeof(_readPacket.Header))
         {
             // If still not enough data for header, keep waiting.
             return NetworkReadPacket::MoreData;
@@ -64,29 +194,37 @@ NetworkReadPacket NetworkConnection::ReadPacket()
     // Read packet body.
     {
         // NOTE: BytesTransfered includes the header length, this will not underflow.
-        const size_t missingLength = header.Size - (InboundPacket.BytesTransferred - sizeof(header));
+        const size_t missingLength = header.Size - (_readPacket.BytesTransferred - sizeof(header));
 
         uint8_t buffer[NetworkBufferSize];
 
         if (missingLength > 0)
         {
-            NetworkReadPacket status = Socket->ReceiveData(buffer, std::min(missingLength, NetworkBufferSize), &bytesRead);
+            NetworkReadPacket status = ReceiveData(buffer, std::min(missingLength, NetworkBufferSize), &bytesRead);
             if (status != NetworkReadPacket::Success)
             {
                 return status;
             }
 
-            InboundPacket.BytesTransferred += bytesRead;
-            InboundPacket.Write(buffer, bytesRead);
+            _readPacket.BytesTransferred += bytesRead;
+            _readPacket.Write(buffer, bytesRead);
         }
 
-        if (InboundPacket.Data.size() == header.Size)
+        if (_readPacket.Data.size() == header.Size)
         {
             // Received complete packet.
             _lastPacketTime = Platform::GetTicks();
 
-            RecordPacketStats(InboundPacket, false);
+            RecordPacketStats(_readPacket.GetCommand(), _readPacket.BytesTransferred, false);
 
+            // The peer compresses everything it sends after this packet.
+            if (_readPacket.GetCommand() == NetworkCommand::CompressStream && _decompressor == nullptr)
+            {
+                _decompressor = std::make_unique<NetworkStreamDecompressor>();
+            }
+
+            _inboundPackets.push(std::move(_readPacket));
+            _readPacket = NetworkPacket();
             return NetworkReadPacket::Success;
         }
     }
@@ -94,21 +232,14 @@ NetworkReadPacket NetworkConnection::ReadPacket()
     return NetworkReadPacket::MoreData;
 }
 
-bool NetworkConnection::SendPacket(NetworkPacket& packet)
+bool NetworkConnection::SendPacket(OutboundPacket& packet)
 {
-    auto header = packet.Header;
-
-    std::vector<uint8_t> buffer;
-    buffer.reserve(sizeof(header) + header.Size);
-
-    // NOTE: For compatibility reasons for the master server we need to add sizeof(Header.Id) to the size.
-    // Previously the Id field was not part of the header rather part of the body.
-    header.Size += sizeof(header.Id);
-    header.Size = Convert::HostToNetwork(header.Size);
-    header.Id = ByteSwapBE(header.Id);
-
-    buffer.insert(buffer.end(), reinterpret_cast<uint8_t*>(&header), reinterpret_cast<uint8_t*>(&header) + sizeof(header));
-    buffer.insert(buffer.end(), packet.Data.begin(), packet.Data.end());
+    if (_compressor != nullptr && !packet.IsCompressed && packet.BytesTransferred == 0)
+    {
+        _compressor->Compress(packet.Wire->Buffer.data(), packet.Wire->Buffer.size(), packet.Compressed);
+        packet.IsCompressed = true;
+    }
+    const auto& buffer = packet.IsCompressed ? packet.Compressed : packet.Wire->Buffer;
 
     size_t bufferSize = buffer.size() - packet.BytesTransferred;
     size_t sent = Socket->SendData(buffer.data() + packet.BytesTransferred, bufferSize);
@@ -120,37 +251,39 @@ bool NetworkConnection::SendPacket(NetworkPacket& packet)
     bool sendComplete = packet.BytesTransferred == buffer.size();
     if (sendComplete)
     {
-        RecordPacketStats(packet, true);
+        RecordPacketStats(packet.Wire->Command, packet.BytesTransferred, true);
     }
     return sendComplete;
 }
 
-void NetworkConnection::QueuePacket(NetworkPacket&& packet, bool front)
+void NetworkConnection::QueuePacket(const NetworkPacket& packet, bool front)
 {
     if (AuthStatus == NetworkAuth::Ok || !packet.CommandRequiresAuth())
     {
-        packet.Header.Size = static_cast<uint16_t>(packet.Data.size());
+        QueuePacket(packet.ToWire(), front);
+    }
+}
+
+void NetworkConnection::QueuePacket(const NetworkWirePacketPtr& packet, bool front)
+{
+    if (AuthStatus == NetworkAuth::Ok || !NetworkPacket::CommandRequiresAuth(packet->Command))
+    {
         if (front)
         {
-            // If the first packet was already partially sent add new packet to second position
-            if (!_outboundPackets.empty() && _outboundPackets.front().BytesTransferred > 0)
-            {
-                auto it = _outboundPackets.begin();
-                it++; // Second position
-                _outboundPackets.insert(it, std::move(packet));
-            }
-            else
-            {
-                _outboundPackets.push_front(std::move(packet));
-            }
+            _outboundQueueFront.push(packet);
         }
         else
         {
-            _outboundPackets.push_back(std::move(packet));
+            _outboundQueue.push(packet);
         }
     }
 }
 
+bool NetworkConnection::PopInboundPacket(NetworkPacket& packet)
+{
+    return _inboundPackets.pop(packet);
+}
+
 void NetworkConnection::Disconnect() noexcept
 {
     ShouldDisconnect = true;
@@ -158,15 +291,94 @@ void NetworkConnection::Disconnect() noexcept
 
 bool NetworkConnection::IsValid() const
 {
-    return !ShouldDisconnect && Socket->GetStatus() == SocketStatus::Connected;
+    return !ShouldDisconnect && _socketStatus == SocketStatus::Connected;
 }
 
-void NetworkConnection::SendQueuedPackets()
+void NetworkConnection::PublishSocketStatus() noexcept
 {
+    _socketStatus = Socket->GetStatus();
+}
+
+bool NetworkConnection::ServiceIo()
+{
+    if (_ioDisconnected)
+    {
+        return false;
+    }
+
+    bool transferred = false;
+    try
+    {
+        for (uint32_t i = 0; i < MaxPacketsPerService; i++)
+        {
+            const auto status = ReadPacket();
+            if (status == NetworkReadPacket::Disconnected)
+            {
+                _ioDisconnected = true;
+                PublishSocketStatus();
+                return transferred;
+            }
+            if (status != NetworkReadPacket::Success)
+            {
+                break;
+            }
+            transferred = true;
+        }
+        transferred |= SendQueuedPackets();
+    }
+    catch (const std::exception& e)
+    {
+        log_verbose("Network I/O failed: %s", e.what());
+        _ioDisconnected = true;
+    }
+    PublishSocketStatus();
+    return transferred;
+}
+
+bool NetworkConnection::SendQueuedPackets()
+{
+    NetworkWirePacketPtr wire;
+    while (_outboundQueueFront.pop(wire))
+    {
+        // If the first packet was already compressed or partially sent add new packet to second position
+        if (!_outboundPackets.empty() && _outboundPackets.front().HasStarted())
+        {
+            auto it = _outboundPackets.begin();
+            it++; // Second position
+            _outboundPackets.insert(it, OutboundPacket{ std::move(wire) });
+        }
+        else
+        {
+            _outboundPackets.push_front(OutboundPacket{ std::move(wire) });
+        }
+    }
+    while (_outboundQueue.pop(wire))
+    {
+        _outboundPackets.push_back(OutboundPacket{ std::move(wire) });
+    }
+
+    bool sentAny = false;
     while (!_outboundPackets.empty() && SendPacket(_outboundPackets.front()))
     {
+        // Everything after this packet is compressed, the peer switches at the same point when reading it.
+        if (_outboundPackets.front().Wire->Command == NetworkCommand::CompressStream && _compressor == nullptr)
+        {
+            _compressor = std::make_unique<NetworkStreamCompressor>();
+        }
         _outboundPackets.pop_front();
+        sentAny = true;
     }
+    return sentAny;
+}
+
+bool NetworkConnection::IsIoDisconnected() const noexcept
+{
+    return _ioDisconnected;
+}
+
+bool NetworkConnection::HasPendingOutboundPackets() const noexcept
+{
+    return !_outboundPackets.empty();
 }
 
 void NetworkConnection::ResetLastPacketTime() noexcept
@@ -185,6 +397,17 @@ bool NetworkConnection::ReceivedPacketRecently() const noexcept
     return true;
 }
 
+NetworkStats_t NetworkConnection::GetStats() const noexcept
+{
+    NetworkStats_t stats{};
+    for (size_t i = 0; i < _bytesReceived.size(); i++)
+    {
+        stats.bytesReceived[i] = _bytesReceived[i].load(std::memory_order_relaxed);
+        stats.bytesSent[i] = _bytesSent[i].load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
 const utf8* NetworkConnection::GetLastDisconnectReason() const noexcept
 {
     return this->_lastDisconnectReason.c_str();
@@ -202,12 +425,11 @@ void NetworkConnection::SetLastDisconnectReason(const StringId string_id, void*
     SetLastDisconnectReason(buffer);
 }
 
-void NetworkConnection::RecordPacketStats(const NetworkPacket& packet, bool sending)
+void NetworkConnection::RecordPacketStats(NetworkCommand command, size_t packetSize, bool sending)
 {
-    uint32_t packetSize = static_cast<uint32_t>(packet.BytesTransferred);
     NetworkStatisticsGroup trafficGroup;
 
-    switch (packet.GetCommand())
+    switch (command)
     {
         case NetworkCommand::GameAction:
             trafficGroup = NetworkStatisticsGroup::Commands;
@@ -222,13 +444,13 @@ void NetworkConnection::RecordPacketStats(const NetworkPacket& packet, bool send
 
     if (sending)
     {
-        Stats.bytesSent[EnumValue(trafficGroup)] += packetSize;
-        Stats.bytesSent[EnumValue(NetworkStatisticsGroup::Total)] += packetSize;
+        _bytesSent[EnumValue(trafficGroup)].fetch_add(packetSize, std::memory_order_relaxed);
+        _bytesSent[EnumValue(NetworkStatisticsGroup::Total)].fetch_add(packetSize, std::memory_order_relaxed);
     }
     else
     {
-        Stats.bytesReceived[EnumValue(trafficGroup)] += packetSize;
-        Stats.bytesReceived[EnumValue(NetworkStatisticsGroup::Total)] += packetSize;
+        _bytesReceived[EnumValue(trafficGroup)].fetch_add(packetSize, std::memory_order_relaxed);
+        _bytesReceived[EnumValue(NetworkStatisticsGroup::Total)].fetch_add(packetSize, std::memory_order_relaxed);
     }
 }
 
@@ -11,63 +11,116 @@
 
 #ifndef DISABLE_NETWORK
 #    include "../common.h"
+#    include "../core/SpscQueue.hpp"
 #    include "NetworkKey.h"
 #    include "NetworkPacket.h"
 #    include "NetworkTypes.h"
 #    include "Socket.h"
 
+#    include <array>
+#    include <atomic>
 #    include <deque>
 #    include <memory>
 #    include <string_view>
 #    include <vector>
 
 class NetworkPlayer;
+class NetworkStreamCompressor;
+class NetworkStreamDecompressor;
 struct ObjectRepositoryItem;
 
 class NetworkConnection final
 {
 public:
     std::unique_ptr<ITcpSocket> Socket = nullptr;
-    NetworkPacket InboundPacket;
     NetworkAuth AuthStatus = NetworkAuth::None;
-    NetworkStats_t Stats = {};
     NetworkPlayer* Player = nullptr;
     uint32_t PingTime = 0;
     NetworkKey Key;
     std::vector<uint8_t> Challenge;
     std::vector<const ObjectRepositoryItem*> RequestedObjects;
     bool ShouldDisconnect = false;
+    // Set on the server when the client asked for a compressed stream in its auth request.
+    bool CompressStreamRequested = false;
 
     NetworkConnection() noexcept;
+    ~NetworkConnection();
 
-    NetworkReadPacket ReadPacket();
-    void QueuePacket(NetworkPacket&& packet, bool front = false);
-    void QueuePacket(const NetworkPacket& packet, bool front = false)
-    {
-        auto copy = packet;
-        return QueuePacket(std::move(copy), front);
-    }
+    // Game thread: takes the next complete packet read by the I/O thread.
+    bool PopInboundPacket(NetworkPacket& packet);
+    void QueuePacket(const NetworkPacket& packet, bool front = false);
+    // Queues an already serialised packet, used to share one buffer when broadcasting to many connections.
+    void QueuePacket(const NetworkWirePacketPtr& packet, bool front = false);
 
     // This will not immediately disconnect the client. The disconnect
     // will happen post-tick.
     void Disconnect() noexcept;
 
     bool IsValid() const;
-    void SendQueuedPackets();
     void ResetLastPacketTime() noexcept;
     bool ReceivedPacketRecently() const noexcept;
+    NetworkStats_t GetStats() const noexcept;
+
+    // I/O thread: reads and frames incoming data, then sends whatever has been queued.
+    // Returns true if any data was transferred. Also called from the game thread once the
+    // connection is no longer serviced by the I/O thread, to flush it before disconnecting.
+    bool ServiceIo();
+    bool SendQueuedPackets();
+    // Set by the I/O thread when the socket was closed or sent invalid data.
+    bool IsIoDisconnected() const noexcept;
+    // I/O thread: true while packets are waiting for room in the socket's send buffer.
+    bool HasPendingOutboundPackets() const noexcept;
+    // Called by the thread servicing the socket, so the game thread can check the status without touching the socket.
+    void PublishSocketStatus() noexcept;
 
     const utf8* GetLastDisconnectReason() const noexcept;
     void SetLastDisconnectReason(std::string_view src);
     void SetLastDisconnectReason(const StringId string_id, void* args = nullptr);
 
 private:
-    std::deque<NetworkPacket> _outboundPackets;
-    uint32_t _lastPacketTime = 0;
+    struct OutboundPacket
+    {
+        NetworkWirePacketPtr Wire{};
+        size_t BytesTransferred = 0;
+        // The wire buffer compressed with this connection's stream, only used once compression is enabled.
+        std::vector<uint8_t> Compressed{};
+        bool IsCompressed = false;
+
+        // Once a packet went through the compressor or is partially sent it has to stay in its position, packets
+        // queued afterwards follow it in the compressed stream.
+        bool HasStarted() const noexcept
+        {
+            return IsCompressed || BytesTransferred > 0;
+        }
+    };
+
+    // Filled by the I/O thread, drained by the game thread.
+    SpscQueue<NetworkPacket> _inboundPackets;
+    // Filled by the game thread, drained by the I/O thread. Front packets skip ahead of anything already queued.
+    SpscQueue<NetworkWirePacketPtr> _outboundQueue;
+    SpscQueue<NetworkWirePacketPtr> _outboundQueueFront;
+
+    // Only touched by the thread servicing the socket.
+    NetworkPacket _readPacket;
+    std::deque<OutboundPacket> _outboundPackets;
+
+    std::atomic<uint32_t> _lastPacketTime{};
+    std::atomic<bool> _ioDisconnected{};
+    std::atomic<SocketStatus> _socketStatus{ SocketStatus::Closed };
+    std::array<std::atomic<uint64_t>, EnumValue(NetworkStatisticsGroup::Max)> _bytesReceived{};
+    std::array<std::atomic<uint64_t>, EnumValue(NetworkStatisticsGroup::Max)> _bytesSent{};
     std::string _lastDisconnectReason;
 
-    void RecordPacketStats(const NetworkPacket& packet, bool sending);
-    bool SendPacket(NetworkPacket& packet);
+    // Everything sent after a CompressStream packet is compressed, likewise for everything received after one.
+    std::unique_ptr<NetworkStreamCompressor> _compressor;
+    std::unique_ptr<NetworkStreamDecompressor> _decompressor;
+    std::vector<uint8_t> _decompressedData;
+    size_t _decompressedDataRead = 0;
+
+    void RecordPacketStats(NetworkCommand command, size_t packetSize, bool sending);
+    NetworkReadPacket ReadPacket();
+    bool SendPacket(OutboundPacket& packet);
+    NetworkReadPacket ReceiveData(uint8_t* buffer, size_t size, size_t* sizeReceived);
 };
 
 #endif // DISABLE_NETWORK
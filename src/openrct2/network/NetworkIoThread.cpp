@@ -0,0 +1,108 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2022 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifndef DISABLE_NETWORK
+
+#    include "NetworkIoThread.h"
+
+#    include "NetworkConnection.h"
+#    include "Socket.h"
+
+#    include <algorithm>
+#    include <chrono>
+
+// The thread blocks until a socket is ready or it is woken up, this is only an upper bound in case a wake up is missed.
+constexpr auto NetworkIoWaitTimeout = std::chrono::milliseconds(100);
+
+NetworkIoThread::NetworkIoThread()
+    : _waiter(CreateSocketWaiter())
+{
+    _thread = std::thread(&NetworkIoThread::Run, this);
+}
+
+NetworkIoThread::~NetworkIoThread()
+{
+    _shouldStop = true;
+    _waiter->Wake();
+    _thread.join();
+}
+
+NetworkIoThread::unique_lock NetworkIoThread::LockConnections()
+{
+    _pendingChanges++;
+    _waiter->Wake();
+    unique_lock lock(_mutex);
+    _pendingChanges--;
+    return lock;
+}
+
+void NetworkIoThread::Add(NetworkConnection& connection)
+{
+    {
+        auto lock = LockConnections();
+        connection.PublishSocketStatus();
+        _connections.push_back(&connection);
+    }
+    _condChanged.notify_all();
+}
+
+void NetworkIoThread::Remove(NetworkConnection& connection)
+{
+    {
+        auto lock = LockConnections();
+        _connections.erase(std::remove(_connections.begin(), _connections.end(), &connection), _connections.end());
+    }
+    _condChanged.notify_all();
+}
+
+void NetworkIoThread::Notify()
+{
+    // The wake up is remembered by the waiter, so it is not lost if the thread is not waiting yet.
+    _waiter->Wake();
+}
+
+void NetworkIoThread::Run()
+{
+    std::vector<ITcpSocket*> readSockets;
+    std::vector<ITcpSocket*> writeSockets;
+
+    unique_lock lock(_mutex);
+    while (!_shouldStop)
+    {
+        // Let the game thread add or remove connections first.
+        _condChanged.wait(lock, [this] { return _pendingChanges == 0; });
+
+        bool transferred = false;
+        for (auto* connection : _connections)
+        {
+            transferred |= connection->ServiceIo();
+        }
+
+        // Keep going while data is flowing, otherwise block until a socket is ready or new packets are queued.
+        if (!transferred && !_shouldStop)
+        {
+            readSockets.clear();
+            writeSockets.clear();
+            for (auto* connection : _connections)
+            {
+                if (connection->IsIoDisconnected())
+                    continue;
+
+                readSockets.push_back(connection->Socket.get());
+                if (connection->HasPendingOutboundPackets())
+                {
+                    writeSockets.push_back(connection->Socket.get());
+                }
+            }
+            _waiter->Wait(readSockets, writeSockets, NetworkIoWaitTimeout);
+        }
+    }
+}
+
+#endif // DISABLE_NETWORK
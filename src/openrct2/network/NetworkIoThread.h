@@ -0,0 +1,60 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2022 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#ifndef DISABLE_NETWORK
+
+#    include <atomic>
+#    include <condition_variable>
+#    include <memory>
+#    include <mutex>
+#    include <thread>
+#    include <vector>
+
+class NetworkConnection;
+struct ISocketWaiter;
+
+/**
+ * Services the sockets of all registered connections on a dedicated thread, so reading, framing
+ * and sending is not tied to the game tick. The game thread only exchanges complete packets with
+ * the connections through their queues.
+ */
+class NetworkIoThread final
+{
+private:
+    std::atomic_bool _shouldStop = { false };
+    // Number of Add and Remove calls waiting for the I/O thread to let go of the connection list.
+    std::atomic<uint32_t> _pendingChanges = { 0 };
+    std::vector<NetworkConnection*> _connections;
+    std::unique_ptr<ISocketWaiter> _waiter;
+    std::condition_variable _condChanged;
+    std::mutex _mutex;
+    std::thread _thread;
+
+    using unique_lock = std::unique_lock<std::mutex>;
+
+public:
+    NetworkIoThread();
+    ~NetworkIoThread();
+
+    // Once Remove returns the I/O thread no longer touches the connection.
+    void Add(NetworkConnection& connection);
+    void Remove(NetworkConnection& connection);
+
+    // Wakes the thread up so newly queued packets go out right away.
+    void Notify();
+
+private:
+    // Interrupts the I/O thread and takes the lock on the connection list.
+    unique_lock LockConnections();
+    void Run();
+};
+
+#endif // DISABLE_NETWORK
@@ -12,6 +12,7 @@
 #    include "NetworkPacket.h"
 
 #    include "NetworkTypes.h"
+#    include "Socket.h"
 
 #    include <memory>
 
@@ -44,7 +45,12 @@ void NetworkPacket::Clear() noexcept
 
 bool NetworkPacket::CommandRequiresAuth() const noexcept
 {
-    switch (GetCommand())
+    return CommandRequiresAuth(GetCommand());
+}
+
+bool NetworkPacket::CommandRequiresAuth(NetworkCommand command) noexcept
+{
+    switch (command)
     {
         case NetworkCommand::Ping:
         case NetworkCommand::Auth:
@@ -54,12 +60,31 @@ bool NetworkPacket::CommandRequiresAuth() const noexcept
         case NetworkCommand::Scripts:
         case NetworkCommand::MapRequest:
         case NetworkCommand::Heartbeat:
+        case NetworkCommand::CompressStream:
             return false;
         default:
             return true;
     }
 }
 
+NetworkWirePacketPtr NetworkPacket::ToWire() const
+{
+    auto header = Header;
+
+    // NOTE: For compatibility reasons for the master server we need to add sizeof(Header.Id) to the size.
+    // Previously the Id field was not part of the header rather part of the body.
+    header.Size = Convert::HostToNetwork(static_cast<uint16_t>(Data.size() + sizeof(header.Id)));
+    header.Id = ByteSwapBE(header.Id);
+
+    auto wire = std::make_shared<NetworkWirePacket>();
+    wire->Command = GetCommand();
+    wire->Buffer.reserve(sizeof(header) + Data.size());
+    wire->Buffer.insert(
+        wire->Buffer.end(), reinterpret_cast<const uint8_t*>(&header), reinterpret_cast<const uint8_t*>(&header) + sizeof(header));
+    wire->Buffer.insert(wire->Buffer.end(), Data.begin(), Data.end());
+    return wire;
+}
+
 void NetworkPacket::Write(const void* bytes, size_t size)
 {
     const uint8_t* src = reinterpret_cast<const uint8_t*>(bytes);
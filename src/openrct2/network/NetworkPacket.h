@@ -25,6 +25,17 @@ struct PacketHeader
 static_assert(sizeof(PacketHeader) == 6);
 #pragma pack(pop)
 
+/**
+ * A packet as it is sent over the wire: the header in network byte order followed by the data.
+ * It is immutable, so a single instance can be queued on any number of connections.
+ */
+struct NetworkWirePacket final
+{
+    NetworkCommand Command = NetworkCommand::Invalid;
+    std::vector<uint8_t> Buffer;
+};
+using NetworkWirePacketPtr = std::shared_ptr<const NetworkWirePacket>;
+
 struct NetworkPacket final
 {
     NetworkPacket() noexcept = default;
@@ -37,6 +48,9 @@ struct NetworkPacket final
 
     void Clear() noexcept;
     bool CommandRequiresAuth() const noexcept;
+    static bool CommandRequiresAuth(NetworkCommand command) noexcept;
+
+    NetworkWirePacketPtr ToWire() const;
 
     const uint8_t* Read(size_t size);
     std::string_view ReadString();
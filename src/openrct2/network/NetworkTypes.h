@@ -83,6 +83,7 @@ enum class NetworkCommand : uint32_t
     GameState,
     Scripts,
     Heartbeat,
+    CompressStream,
     Max,
     Invalid = static_cast<uint32_t>(-1),
 };
@@ -102,6 +103,8 @@ struct NetworkServerState_t
     uint32_t tick = 0;
     uint32_t srand0 = 0;
     bool gamestateSnapshotsEnabled = false;
+    // GameStateChecksumSectionMask of the sections that diverged, zero when only srand0 differed.
+    uint32_t desyncSections = 0;
 };
 
 // Structure is used for networking specific fields with meaning,
@@ -9,6 +9,7 @@
 
 #ifndef DISABLE_NETWORK
 
+#    include <algorithm>
 #    include <atomic>
 #    include <chrono>
 #    include <cmath>
@@ -49,6 +50,7 @@
     #include <netdb.h>
     #include <netinet/in.h>
     #include <netinet/tcp.h>
+    #include <poll.h>
     #include <sys/ioctl.h>
     #include <sys/socket.h>
     #include "../common.h"
@@ -279,6 +281,12 @@ public:
         return _status;
     }
 
+    uintptr_t GetNativeHandle() const override
+    {
+        // INVALID_SOCKET converts to InvalidNativeSocketHandle on every platform.
+        return static_cast<uintptr_t>(_socket);
+    }
+
     const char* GetError() const override
     {
         return _error.empty() ? nullptr : _error.c_str();
@@ -859,6 +867,128 @@ private:
     }
 };
 
+/**
+ * Waits on the sockets with poll. Wake sends a datagram to a UDP socket bound to the loopback address, which is
+ * part of every poll call, this works the same way on all platforms.
+ */
+class SocketWaiter final : public ISocketWaiter, protected Socket
+{
+private:
+    SOCKET _wakeSocket = INVALID_SOCKET;
+    sockaddr_in _wakeAddress{};
+    std::vector<pollfd> _pollFds;
+
+public:
+    SocketWaiter()
+    {
+        _wakeSocket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        if (_wakeSocket == INVALID_SOCKET)
+        {
+            log_warning("Unable to create wake socket: %d", LAST_SOCKET_ERROR());
+            return;
+        }
+
+        _wakeAddress.sin_family = AF_INET;
+        _wakeAddress.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        _wakeAddress.sin_port = 0;
+        socklen_t addressLen = sizeof(_wakeAddress);
+        if (bind(_wakeSocket, reinterpret_cast<const sockaddr*>(&_wakeAddress), sizeof(_wakeAddress)) != 0
+            || getsockname(_wakeSocket, reinterpret_cast<sockaddr*>(&_wakeAddress), &addressLen) != 0
+            || !SetNonBlocking(_wakeSocket, true))
+        {
+            log_warning("Unable to bind wake socket: %d", LAST_SOCKET_ERROR());
+            closesocket(_wakeSocket);
+            _wakeSocket = INVALID_SOCKET;
+        }
+    }
+
+    ~SocketWaiter() override
+    {
+        if (_wakeSocket != INVALID_SOCKET)
+        {
+            closesocket(_wakeSocket);
+        }
+    }
+
+    void Wait(
+        const std::vector<ITcpSocket*>& readSockets, const std::vector<ITcpSocket*>& writeSockets,
+        std::chrono::milliseconds timeout) override
+    {
+        _pollFds.clear();
+        if (_wakeSocket != INVALID_SOCKET)
+        {
+            AddPollFd(_wakeSocket, POLLIN);
+        }
+        for (auto* socket : readSockets)
+        {
+            AddPollFd(socket, POLLIN);
+        }
+        for (auto* socket : writeSockets)
+        {
+            AddPollFd(socket, POLLOUT);
+        }
+
+        const auto result = Poll(static_cast<int32_t>(timeout.count()));
+        if (result < 0)
+        {
+            // Nothing to wait on, e.g. no wake socket and no connections on Windows. Do not spin.
+            std::this_thread::sleep_for(timeout);
+        }
+        else if (result > 0 && _wakeSocket != INVALID_SOCKET && (_pollFds.front().revents & POLLIN))
+        {
+            // Drain all pending wake ups, one pass handles them all.
+            char buffer[64];
+            while (recv(_wakeSocket, buffer, sizeof(buffer), 0) > 0)
+            {
+            }
+        }
+    }
+
+    void Wake() override
+    {
+        if (_wakeSocket != INVALID_SOCKET)
+        {
+            const char data = 0;
+            sendto(
+                _wakeSocket, &data, sizeof(data), FLAG_NO_PIPE, reinterpret_cast<const sockaddr*>(&_wakeAddress),
+                sizeof(_wakeAddress));
+        }
+    }
+
+private:
+    void AddPollFd(const ITcpSocket* socket, int16_t events)
+    {
+        const auto handle = socket->GetNativeHandle();
+        if (handle == InvalidNativeSocketHandle)
+            return;
+
+        AddPollFd(static_cast<SOCKET>(handle), events);
+    }
+
+    void AddPollFd(SOCKET handle, int16_t events)
+    {
+        // A socket waited on for reading and writing only gets one entry.
+        auto it = std::find_if(_pollFds.begin(), _pollFds.end(), [handle](const pollfd& fd) { return fd.fd == handle; });
+        if (it != _pollFds.end())
+        {
+            it->events |= events;
+        }
+        else
+        {
+            _pollFds.push_back({ handle, events, 0 });
+        }
+    }
+
+    int32_t Poll(int32_t timeoutMs)
+    {
+#    ifdef _WIN32
+        return WSAPoll(_pollFds.data(), static_cast<ULONG>(_pollFds.size()), timeoutMs);
+#    else
+        return poll(_pollFds.data(), static_cast<nfds_t>(_pollFds.size()), timeoutMs);
+#    endif
+    }
+};
+
 std::unique_ptr<ITcpSocket> CreateTcpSocket()
 {
     InitialiseWSA();
@@ -871,6 +1001,12 @@ std::unique_ptr<IUdpSocket> CreateUdpSocket()
     return std::make_unique<UdpSocket>();
 }
 
+std::unique_ptr<ISocketWaiter> CreateSocketWaiter()
+{
+    InitialiseWSA();
+    return std::make_unique<SocketWaiter>();
+}
+
 #    ifdef _WIN32
 static std::vector<INTERFACE_INFO> GetNetworkInterfaces()
 {
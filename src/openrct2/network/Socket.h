@@ -11,6 +11,7 @@
 
 #include "../common.h"
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <vector>
@@ -33,6 +34,8 @@ enum class NetworkReadPacket : int32_t
     Disconnected
 };
 
+constexpr uintptr_t InvalidNativeSocketHandle = ~uintptr_t{ 0 };
+
 /**
  * Represents an address and port.
  */
@@ -70,6 +73,9 @@ public:
 
     virtual void SetNoDelay(bool noDelay) abstract;
 
+    // The system socket for waiting on it with ISocketWaiter, InvalidNativeSocketHandle if there is none.
+    virtual uintptr_t GetNativeHandle() const abstract;
+
     virtual void Finish() abstract;
     virtual void Disconnect() abstract;
     virtual void Close() abstract;
@@ -98,8 +104,25 @@ public:
     virtual void Close() abstract;
 };
 
+/**
+ * Blocks a thread until one of a set of TCP sockets is ready, or until another thread wakes it up.
+ */
+struct ISocketWaiter
+{
+public:
+    virtual ~ISocketWaiter() = default;
+
+    // Returns once a read socket has data, a write socket has room for more data, Wake was called or the timeout passed.
+    virtual void Wait(
+        const std::vector<ITcpSocket*>& readSockets, const std::vector<ITcpSocket*>& writeSockets,
+        std::chrono::milliseconds timeout) abstract;
+    // Can be called from any thread, a wake up before Wait is called makes the next Wait return immediately.
+    virtual void Wake() abstract;
+};
+
 [[nodiscard]] std::unique_ptr<ITcpSocket> CreateTcpSocket();
 [[nodiscard]] std::unique_ptr<IUdpSocket> CreateUdpSocket();
+[[nodiscard]] std::unique_ptr<ISocketWaiter> CreateSocketWaiter();
 [[nodiscard]] std::vector<std::unique_ptr<INetworkEndpoint>> GetBroadcastAddresses();
 
 namespace Convert
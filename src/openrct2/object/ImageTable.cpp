@@ -159,8 +159,12 @@ std::vector<std::unique_ptr<ImageTable::RequiredImage>> ImageTable::ParseImages(
     {
         try
         {
-            auto imageData = context->GetData(s);
-            auto image = Imaging::ReadFromBuffer(imageData);
+            auto imageStream = context->GetStream(s);
+            if (imageStream == nullptr)
+            {
+                throw std::runtime_error("Unable to open image.");
+            }
+            auto image = Imaging::ReadFromStream(*imageStream);
 
             ImageImporter importer;
             auto importResult = importer.Import(image, 0, 0, ImageImporter::Palette::OpenRCT2, ImageImporter::ImportFlags::RLE);
@@ -428,7 +432,7 @@ std::string ImageTable::FindLegacyObject(const std::string& name)
 
 ImageTable::~ImageTable()
 {
-    if (_data == nullptr)
+    if (_data == nullptr && _sharedData == nullptr)
     {
         for (auto& entry : _entries)
         {
@@ -458,22 +462,15 @@ void ImageTable::Read(IReadObjectContext* context, OpenRCT2::IStream* stream)
         }
 
         auto dataSize = static_cast<size_t>(imageDataSize);
-        auto data = std::make_unique<uint8_t[]>(dataSize);
-        if (data == nullptr)
-        {
-            context->LogError(ObjectError::BadImageTable, "Image table too large.");
-            throw std::runtime_error("Image table too large.");
-        }
 
-        // Read g1 element headers
-        uintptr_t imageDataBase = reinterpret_cast<uintptr_t>(data.get());
+        // Read g1 element headers, the offsets are relative to the image data until it has been located
         std::vector<rct_g1_element> newEntries;
         for (uint32_t i = 0; i < numImages; i++)
         {
             rct_g1_element g1Element{};
 
             uintptr_t imageDataOffset = static_cast<uintptr_t>(stream->ReadValue<uint32_t>());
-            g1Element.offset = reinterpret_cast<uint8_t*>(imageDataBase + imageDataOffset);
+            g1Element.offset = reinterpret_cast<uint8_t*>(imageDataOffset);
 
             g1Element.width = stream->ReadValue<int16_t>();
             g1Element.height = stream->ReadValue<int16_t>();
@@ -485,6 +482,35 @@ void ImageTable::Read(IReadObjectContext* context, OpenRCT2::IStream* stream)
             newEntries.push_back(std::move(g1Element));
         }
 
+        // If the stream data is immutable and outlives the object, reference the image data in place
+        auto sharedDataOwner = context->GetSharedDataOwner();
+        auto streamData = static_cast<const uint8_t*>(stream->GetData());
+        if (sharedDataOwner != nullptr && streamData != nullptr && stream->GetLength() - stream->GetPosition() >= dataSize)
+        {
+            auto imageDataBase = reinterpret_cast<uintptr_t>(streamData + stream->GetPosition());
+            for (auto& g1Element : newEntries)
+            {
+                g1Element.offset = reinterpret_cast<uint8_t*>(imageDataBase + reinterpret_cast<uintptr_t>(g1Element.offset));
+            }
+            stream->Seek(dataSize, OpenRCT2::STREAM_SEEK_CURRENT);
+            _sharedData = std::move(sharedDataOwner);
+            _entries.insert(_entries.end(), newEntries.begin(), newEntries.end());
+            return;
+        }
+
+        auto data = std::make_unique<uint8_t[]>(dataSize);
+        if (data == nullptr)
+        {
+            context->LogError(ObjectError::BadImageTable, "Image table too large.");
+            throw std::runtime_error("Image table too large.");
+        }
+
+        uintptr_t imageDataBase = reinterpret_cast<uintptr_t>(data.get());
+        for (auto& g1Element : newEntries)
+        {
+            g1Element.offset = reinterpret_cast<uint8_t*>(imageDataBase + reinterpret_cast<uintptr_t>(g1Element.offset));
+        }
+
         // Read g1 element data
         size_t readBytes = static_cast<size_t>(stream->TryRead(data.get(), dataSize));
 
@@ -520,9 +546,13 @@ std::vector<std::pair<std::string, Image>> ImageTable::GetImageSources(IReadObje
             });
             if (itSource == result.end())
             {
-                auto imageData = context->GetData(path);
+                auto imageStream = context->GetStream(path);
+                if (imageStream == nullptr)
+                {
+                    throw std::runtime_error("Unable to open image '" + path + "'.");
+                }
                 auto imageFormat = keepPalette ? IMAGE_FORMAT::PNG : IMAGE_FORMAT::PNG_32;
-                auto image = Imaging::ReadFromBuffer(imageData, imageFormat);
+                auto image = Imaging::ReadFromStream(*imageStream, imageFormat);
                 auto pair = std::make_pair<std::string, Image>(std::move(path), std::move(image));
                 result.push_back(std::move(pair));
             }
@@ -27,6 +27,8 @@ class ImageTable
 {
 private:
     std::unique_ptr<uint8_t[]> _data;
+    // Keeps image data that is referenced in place (rather than owned by _data) alive.
+    std::shared_ptr<const void> _sharedData;
     std::vector<rct_g1_element> _entries;
 
     /**
@@ -234,7 +234,13 @@ struct IReadObjectContext
     virtual IObjectRepository& GetObjectRepository() abstract;
     virtual bool ShouldLoadImages() abstract;
     virtual std::vector<uint8_t> GetData(std::string_view path) abstract;
+    virtual std::unique_ptr<OpenRCT2::IStream> GetStream(std::string_view path) abstract;
     virtual ObjectAsset GetAsset(std::string_view path) abstract;
+    /**
+     * Gets the owner of the immutable data the object is being read from, if it outlives the read.
+     * When available, data such as images can be referenced in place rather than copied.
+     */
+    virtual std::shared_ptr<const void> GetSharedDataOwner() abstract;
 
     virtual void LogVerbose(ObjectError code, const utf8* text) abstract;
     virtual void LogWarning(ObjectError code, const utf8* text) abstract;
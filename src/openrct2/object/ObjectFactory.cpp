@@ -35,6 +35,7 @@
 #include "ObjectList.h"
 #include "RideObject.h"
 #include "SceneryGroupObject.h"
+#include "SharedObjectCache.h"
 #include "SmallSceneryObject.h"
 #include "StationObject.h"
 #include "TerrainEdgeObject.h"
@@ -50,6 +51,7 @@ struct IFileDataRetriever
 {
     virtual ~IFileDataRetriever() = default;
     virtual std::vector<uint8_t> GetData(std::string_view path) const abstract;
+    virtual std::unique_ptr<OpenRCT2::IStream> GetStream(std::string_view path) const abstract;
     virtual ObjectAsset GetAsset(std::string_view path) const abstract;
 };
 
@@ -70,6 +72,12 @@ public:
         return File::ReadAllBytes(absolutePath);
     }
 
+    std::unique_ptr<OpenRCT2::IStream> GetStream(std::string_view path) const override
+    {
+        auto absolutePath = Path::Combine(_basePath, path);
+        return std::make_unique<OpenRCT2::FileStream>(absolutePath, OpenRCT2::FILE_MODE_OPEN);
+    }
+
     ObjectAsset GetAsset(std::string_view path) const override
     {
         if (Path::IsAbsolute(path))
@@ -102,6 +110,11 @@ public:
         return _zipArchive.GetFileData(path);
     }
 
+    std::unique_ptr<OpenRCT2::IStream> GetStream(std::string_view path) const override
+    {
+        return _zipArchive.GetFileStream(path);
+    }
+
     ObjectAsset GetAsset(std::string_view path) const override
     {
         return ObjectAsset(_path, path);
@@ -117,6 +130,7 @@ private:
     std::string _identifier;
     bool _loadImages;
     std::string _basePath;
+    std::shared_ptr<const void> _sharedDataOwner;
     bool _wasVerbose = false;
     bool _wasWarning = false;
     bool _wasError = false;
@@ -169,6 +183,15 @@ public:
         return {};
     }
 
+    std::unique_ptr<OpenRCT2::IStream> GetStream(std::string_view path) override
+    {
+        if (_fileDataRetriever != nullptr)
+        {
+            return _fileDataRetriever->GetStream(path);
+        }
+        return {};
+    }
+
     ObjectAsset GetAsset(std::string_view path) override
     {
         if (_fileDataRetriever != nullptr)
@@ -178,6 +201,16 @@ public:
         return {};
     }
 
+    std::shared_ptr<const void> GetSharedDataOwner() override
+    {
+        return _sharedDataOwner;
+    }
+
+    void SetSharedDataOwner(std::shared_ptr<const void> owner)
+    {
+        _sharedDataOwner = std::move(owner);
+    }
+
     void LogVerbose(ObjectError code, const utf8* text) override
     {
         _wasVerbose = true;
@@ -251,6 +284,42 @@ namespace ObjectFactory
         }
     }
 
+    /**
+     * Creates the object for a legacy object entry from its decoded chunk, scenario text objects are not loaded.
+     * @param sharedDataOwner Keeps the chunk alive when the object refers to it rather than copying it.
+     */
+    static std::unique_ptr<Object> CreateObjectFromLegacyChunk(
+        IObjectRepository& objectRepository, const rct_object_entry& entry, const void* data, size_t dataSize,
+        bool loadImages, std::shared_ptr<const void> sharedDataOwner)
+    {
+        if (entry.GetType() == ObjectType::ScenarioText)
+        {
+            return nullptr;
+        }
+
+        auto result = CreateObject(entry.GetType());
+        result->SetDescriptor(ObjectEntryDescriptor(entry));
+
+        utf8 objectName[DAT_NAME_LENGTH + 1] = { 0 };
+        object_entry_get_name_fixed(objectName, sizeof(objectName), &entry);
+        log_verbose("  entry: { 0x%08X, \"%s\", 0x%08X }", entry.flags, objectName, entry.checksum);
+        log_verbose("  size: %zu", dataSize);
+
+        auto chunkStream = OpenRCT2::MemoryStream(data, dataSize);
+        auto readContext = ReadObjectContext(objectRepository, objectName, loadImages, nullptr);
+        if (sharedDataOwner != nullptr)
+        {
+            readContext.SetSharedDataOwner(std::move(sharedDataOwner));
+        }
+        ReadObjectLegacy(*result, &readContext, &chunkStream);
+        if (readContext.WasError())
+        {
+            throw std::runtime_error("Object has errors");
+        }
+        result->SetSourceGames({ entry.GetSourceGame() });
+        return result;
+    }
+
     std::unique_ptr<Object> CreateObjectFromLegacyFile(IObjectRepository& objectRepository, const utf8* path, bool loadImages)
     {
         log_verbose("CreateObjectFromLegacyFile(..., \"%s\")", path);
@@ -258,31 +327,26 @@ namespace ObjectFactory
         std::unique_ptr<Object> result;
         try
         {
+            if (SharedObjectCache::IsEnabled())
+            {
+                if (auto sharedObject = SharedObjectCache::GetLegacyObject(path); sharedObject.has_value())
+                {
+                    log_verbose("  shared");
+                    return CreateObjectFromLegacyChunk(
+                        objectRepository, sharedObject->Entry, sharedObject->Data, sharedObject->DataSize, loadImages,
+                        sharedObject->Mapping);
+                }
+            }
+
             auto fs = OpenRCT2::FileStream(path, OpenRCT2::FILE_MODE_OPEN);
             auto chunkReader = SawyerChunkReader(&fs);
 
             rct_object_entry entry = fs.ReadValue<rct_object_entry>();
-
             if (entry.GetType() != ObjectType::ScenarioText)
             {
-                result = CreateObject(entry.GetType());
-                result->SetDescriptor(ObjectEntryDescriptor(entry));
-
-                utf8 objectName[DAT_NAME_LENGTH + 1] = { 0 };
-                object_entry_get_name_fixed(objectName, sizeof(objectName), &entry);
-                log_verbose("  entry: { 0x%08X, \"%s\", 0x%08X }", entry.flags, objectName, entry.checksum);
-
                 auto chunk = chunkReader.ReadChunk();
-                log_verbose("  size: %zu", chunk->GetLength());
-
-                auto chunkStream = OpenRCT2::MemoryStream(chunk->GetData(), chunk->GetLength());
-                auto readContext = ReadObjectContext(objectRepository, objectName, loadImages, nullptr);
-                ReadObjectLegacy(*result, &readContext, &chunkStream);
-                if (readContext.WasError())
-                {
-                    throw std::runtime_error("Object has errors");
-                }
-                result->SetSourceGames({ entry.GetSourceGame() });
+                result = CreateObjectFromLegacyChunk(
+                    objectRepository, entry, chunk->GetData(), chunk->GetLength(), loadImages, nullptr);
             }
         }
         catch (const std::exception& e)
@@ -428,13 +492,13 @@ namespace ObjectFactory
         try
         {
             auto archive = Zip::Open(path, ZIP_ACCESS::READ);
-            auto jsonBytes = archive->GetFileData("object.json");
-            if (jsonBytes.empty())
+            auto jsonStream = archive->GetFileStream("object.json");
+            if (jsonStream == nullptr || jsonStream->GetLength() == 0)
             {
                 throw std::runtime_error("Unable to open object.json.");
             }
 
-            json_t jRoot = Json::FromVector(jsonBytes);
+            json_t jRoot = Json::FromStream(*jsonStream);
 
             if (jRoot.is_object())
             {
@@ -0,0 +1,151 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2022 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "SharedObjectCache.h"
+
+#include "../Context.h"
+#include "../PlatformEnvironment.h"
+#include "../config/Config.h"
+#include "../core/File.h"
+#include "../core/FileStream.h"
+#include "../core/MemoryMappedFile.h"
+#include "../core/Path.hpp"
+#include "../core/String.hpp"
+#include "../rct12/SawyerChunkReader.h"
+
+#include <cstring>
+#include <random>
+
+using namespace OpenRCT2;
+
+namespace SharedObjectCache
+{
+    static constexpr uint32_t MAGIC_NUMBER = 0x4A424F53; // SOBJ
+    static constexpr uint32_t VERSION = 1;
+
+    struct CacheEntryHeader
+    {
+        uint32_t MagicNumber = MAGIC_NUMBER;
+        uint32_t Version = VERSION;
+        uint64_t SourceSize = 0;
+        uint64_t SourceLastModified = 0;
+        uint64_t DataSize = 0;
+        rct_object_entry Entry{};
+    };
+
+    static uint64_t GetPathHash(std::string_view path)
+    {
+        // FNV-1a
+        uint64_t hash = 0xCBF29CE484222325;
+        for (auto ch : path)
+        {
+            hash ^= static_cast<uint8_t>(ch);
+            hash *= 0x100000001B3;
+        }
+        return hash;
+    }
+
+    static std::string GetCachePath(std::string_view path)
+    {
+        auto env = GetContext()->GetPlatformEnvironment();
+        auto directory = Path::Combine(env->GetDirectoryPath(DIRBASE::CACHE), u8"objects");
+        auto fileName = String::StdFormat(
+            "%016llx.dat", static_cast<unsigned long long>(GetPathHash(Path::GetAbsolute(path))));
+        return Path::Combine(directory, fileName);
+    }
+
+    static bool IsEntryValid(const MemoryMappedFile& mapping, uint64_t sourceSize, uint64_t sourceLastModified)
+    {
+        if (mapping.GetSize() < sizeof(CacheEntryHeader))
+            return false;
+
+        CacheEntryHeader header;
+        std::memcpy(&header, mapping.GetData(), sizeof(CacheEntryHeader));
+        return header.MagicNumber == MAGIC_NUMBER && header.Version == VERSION && header.SourceSize == sourceSize
+            && header.SourceLastModified == sourceLastModified
+            && header.DataSize == mapping.GetSize() - sizeof(CacheEntryHeader);
+    }
+
+    static void WriteEntry(std::string_view path, const std::string& cachePath, uint64_t sourceSize, uint64_t sourceLastModified)
+    {
+        auto fs = FileStream(path, FILE_MODE_OPEN);
+        auto chunkReader = SawyerChunkReader(&fs);
+
+        CacheEntryHeader header;
+        header.SourceSize = sourceSize;
+        header.SourceLastModified = sourceLastModified;
+        header.Entry = fs.ReadValue<rct_object_entry>();
+
+        auto chunk = chunkReader.ReadChunk();
+        header.DataSize = chunk->GetLength();
+
+        // Other processes may be reading or writing the same entry, write to a temporary file first and
+        // then replace the entry so that a partially written file is never mapped.
+        auto tempPath = String::StdFormat("%s.%08x.tmp", cachePath.c_str(), std::random_device{}());
+        {
+            auto cacheStream = FileStream(tempPath, FILE_MODE_WRITE);
+            cacheStream.WriteValue(header);
+            cacheStream.Write(chunk->GetData(), chunk->GetLength());
+        }
+        if (!File::Move(tempPath, cachePath))
+        {
+            File::Delete(tempPath);
+        }
+    }
+
+    bool IsEnabled()
+    {
+        return gConfigGeneral.SharedObjectCache;
+    }
+
+    std::optional<SharedLegacyObject> GetLegacyObject(std::string_view path)
+    {
+        try
+        {
+            auto sourceSize = File::GetSize(path);
+            auto sourceLastModified = File::GetLastModified(path);
+            auto cachePath = GetCachePath(path);
+
+            std::shared_ptr<MemoryMappedFile> mapping;
+            if (File::Exists(cachePath))
+            {
+                mapping = std::make_shared<MemoryMappedFile>(cachePath);
+                if (!IsEntryValid(*mapping, sourceSize, sourceLastModified))
+                {
+                    mapping = nullptr;
+                }
+            }
+            if (mapping == nullptr)
+            {
+                log_verbose("SharedObjectCache: Decoding '%s'", std::string(path).c_str());
+                WriteEntry(path, cachePath, sourceSize, sourceLastModified);
+                mapping = std::make_shared<MemoryMappedFile>(cachePath);
+                if (!IsEntryValid(*mapping, sourceSize, sourceLastModified))
+                {
+                    return std::nullopt;
+                }
+            }
+
+            CacheEntryHeader header;
+            std::memcpy(&header, mapping->GetData(), sizeof(CacheEntryHeader));
+
+            SharedLegacyObject result;
+            result.Entry = header.Entry;
+            result.Data = static_cast<const uint8_t*>(mapping->GetData()) + sizeof(CacheEntryHeader);
+            result.DataSize = static_cast<size_t>(header.DataSize);
+            result.Mapping = std::move(mapping);
+            return result;
+        }
+        catch (const std::exception& e)
+        {
+            log_error("Unable to use shared object cache for '%s': %s", std::string(path).c_str(), e.what());
+        }
+        return std::nullopt;
+    }
+} // namespace SharedObjectCache
@@ -0,0 +1,46 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2022 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "Object.h"
+
+#include <memory>
+#include <optional>
+#include <string_view>
+
+namespace OpenRCT2
+{
+    class MemoryMappedFile;
+}
+
+/**
+ * Decoded legacy object data stored in the user cache directory. Each entry is mapped read-only into
+ * memory, so multiple processes on the same host (e.g. several dedicated servers) share the same
+ * physical pages for the decoded chunk and the image data referenced from it.
+ */
+struct SharedLegacyObject
+{
+    rct_object_entry Entry;
+    const void* Data;
+    size_t DataSize;
+    std::shared_ptr<OpenRCT2::MemoryMappedFile> Mapping;
+};
+
+namespace SharedObjectCache
+{
+    bool IsEnabled();
+
+    /**
+     * Gets the decoded data of the given legacy object file, decoding it and adding it to the
+     * cache if it is missing or out of date.
+     */
+    std::optional<SharedLegacyObject> GetLegacyObject(std::string_view path);
+} // namespace SharedObjectCache
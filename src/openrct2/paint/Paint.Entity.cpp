@@ -30,6 +30,31 @@
 #include "../world/Park.h"
 #include "Paint.h"
 
+static bool EntityIsWithinDPI(const rct_drawpixelinfo& dpi, const EntityBase& entity)
+{
+    return dpi.y + dpi.height > entity.SpriteRect.GetTop() && entity.SpriteRect.GetBottom() > dpi.y
+        && dpi.x + dpi.width > entity.SpriteRect.GetLeft() && entity.SpriteRect.GetRight() > dpi.x;
+}
+
+bool EntityPaintMayOverlap(const rct_drawpixelinfo& dpi, uint32_t viewFlags, const CoordsXY& pos)
+{
+    if (!MapIsLocationValid(pos) || gTrackDesignSaveMode || (viewFlags & VIEWPORT_FLAG_HIDE_ENTITIES)
+        || dpi.zoom_level > ZoomLevel{ 2 })
+    {
+        return false;
+    }
+
+    // Entities skipped for the path issue highlight or the clip view are included, this only has to be conservative.
+    for (const auto* entity : EntityTileList(pos))
+    {
+        if (EntityIsWithinDPI(dpi, *entity))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 /**
  * Paint Quadrant
  *  rct2: 0x0069E8B0
@@ -97,8 +122,7 @@ void EntityPaintSetup(PaintSession& session, const CoordsXY& pos)
 
         dpi = &session.DPI;
 
-        if (dpi->y + dpi->height <= spr->SpriteRect.GetTop() || spr->SpriteRect.GetBottom() <= dpi->y
-            || dpi->x + dpi->width <= spr->SpriteRect.GetLeft() || spr->SpriteRect.GetRight() <= dpi->x)
+        if (!EntityIsWithinDPI(*dpi, *spr))
         {
             continue;
         }
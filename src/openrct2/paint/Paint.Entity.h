@@ -9,7 +9,15 @@
 
 #pragma once
 
+#include <cstdint>
+
 struct PaintSession;
 struct CoordsXY;
+struct rct_drawpixelinfo;
 
 void EntityPaintSetup(PaintSession& session, const CoordsXY& pos);
+
+/**
+ * Returns whether EntityPaintSetup may add anything for the entities on the tile within the dpi.
+ */
+bool EntityPaintMayOverlap(const rct_drawpixelinfo& dpi, uint32_t viewFlags, const CoordsXY& pos);
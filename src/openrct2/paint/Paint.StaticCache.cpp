@@ -0,0 +1,642 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2022 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "Paint.StaticCache.h"
+
+#include "../Cheats.h"
+#include "../OpenRCT2.h"
+#include "../config/Config.h"
+#include "../drawing/Drawing.h"
+#include "../drawing/LightFX.h"
+#include "../entity/PatrolArea.h"
+#include "../interface/Viewport.h"
+#include "../profiling/Profiling.h"
+#include "../ride/TrackDesign.h"
+#include "../util/Util.h"
+#include "../world/Banner.h"
+#include "../world/Map.h"
+#include "../world/Scenery.h"
+#include "../world/SmallScenery.h"
+#include "../world/TileInspector.h"
+#include "Paint.h"
+#include "VirtualFloor.h"
+#include "tile_element/Paint.TileElement.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+using namespace OpenRCT2;
+
+// Every viewport with its own zoom, rotation or view flags needs a cache, e.g. the main view plus a few ride and
+// staff windows. Each cache holds at most NumStaticPaintCacheShards * MaxTilesPerShard tiles.
+static constexpr size_t MaxStaticPaintCaches = 8;
+static constexpr size_t NumStaticPaintCacheShards = 64;
+static constexpr size_t MaxTilesPerShard = 1024;
+
+// Tiles are recorded without culling so the output can be re-used by every column and frame that shows them.
+static constexpr int32_t RecordingExtent = 1 << 28;
+
+// Everything the paint output of a static tile depends on, other than the tile elements on and around it.
+struct StaticPaintCacheKey
+{
+    uint32_t ViewFlags{};
+    ZoomLevel Zoom{};
+    uint8_t Rotation{};
+    uint8_t ClipHeight{};
+    uint8_t Options{};
+    CoordsXY ClipSelectionA{};
+    CoordsXY ClipSelectionB{};
+
+    bool operator==(const StaticPaintCacheKey& other) const
+    {
+        return ViewFlags == other.ViewFlags && Zoom == other.Zoom && Rotation == other.Rotation
+            && ClipHeight == other.ClipHeight && Options == other.Options && ClipSelectionA == other.ClipSelectionA
+            && ClipSelectionB == other.ClipSelectionB;
+    }
+};
+
+namespace StaticPaintCacheOptions
+{
+    constexpr uint8_t LandscapeSmoothing = 1u << 0;
+    constexpr uint8_t TransparentWater = 1u << 1;
+    constexpr uint8_t WidePathsAsGhost = 1u << 2;
+    constexpr uint8_t BlockedTiles = 1u << 3;
+    // Height markers are drawn in units, feet or metres.
+    constexpr uint8_t HeightsAsUnits = 1u << 4;
+    constexpr uint8_t MeasurementFormatShift = 5;
+} // namespace StaticPaintCacheOptions
+
+// Screen area covered by the image of a paint struct.
+struct CachedPaintBounds
+{
+    int32_t Left = std::numeric_limits<int32_t>::max();
+    int32_t Top = std::numeric_limits<int32_t>::max();
+    int32_t Right = std::numeric_limits<int32_t>::min();
+    int32_t Bottom = std::numeric_limits<int32_t>::min();
+};
+
+/**
+ * A paint struct that was added to a quadrant together with its children. The structs of a tree are stored next to
+ * each other with every child directly after its parent, the tree ends where the next one starts.
+ */
+struct CachedPaintTree
+{
+    uint32_t StructEnd{};
+    // Covers the images of all structs in the tree, attached images are painted along with the struct they belong to.
+    CachedPaintBounds Bounds;
+};
+
+struct CachedPaintTile
+{
+    const TileElement* FirstElement{};
+    uint64_t Hash{};
+    // Children and attached pointers hold the index of the struct they point to plus one, nullptr stays nullptr.
+    std::vector<PaintStruct> Structs;
+    std::vector<CachedPaintBounds> StructBounds;
+    std::vector<AttachedPaintStruct> Attached;
+    std::vector<CachedPaintTree> Trees;
+};
+
+struct StaticPaintCache
+{
+    struct Shard
+    {
+        std::mutex Mutex;
+        std::unordered_map<uint32_t, CachedPaintTile> Tiles;
+    };
+
+    StaticPaintCacheKey Key;
+    uint32_t LastUsed{};
+    std::array<Shard, NumStaticPaintCacheShards> Shards;
+};
+
+bool gPaintStaticCacheEnabled = false;
+
+static std::mutex _cachesMutex;
+static std::vector<std::unique_ptr<StaticPaintCache>> _caches;
+static uint32_t _cacheUseCounter;
+static PaintEntryPool _recordingPool;
+
+template<typename T> static T* EncodeIndex(size_t index)
+{
+    return reinterpret_cast<T*>(index + 1);
+}
+
+template<typename T> static size_t DecodeIndex(const T* ptr)
+{
+    return reinterpret_cast<uintptr_t>(ptr) - 1;
+}
+
+static uint32_t GetTileIndex(const CoordsXY& mapCoords)
+{
+    const auto tilePos = TileCoordsXY(mapCoords);
+    return static_cast<uint32_t>(tilePos.x) | (static_cast<uint32_t>(tilePos.y) << 16);
+}
+
+static uint64_t HashWord(uint64_t hash, uint64_t word)
+{
+    hash = (hash ^ word) * 0x9E3779B97F4A7C15ULL;
+    return hash ^ (hash >> 32);
+}
+
+// Tiles are hashed for every column they are painted in, so elements are mixed in whole words rather than bytes.
+static uint64_t HashElement(uint64_t hash, const void* element)
+{
+    static_assert(sizeof(TileElement) == 2 * sizeof(uint64_t) && sizeof(SurfaceElement) == sizeof(TileElement));
+    uint64_t words[2];
+    std::memcpy(words, element, sizeof(words));
+    return HashWord(HashWord(hash, words[0]), words[1]);
+}
+
+static uint64_t HashTile(const TileElement* element, const CoordsXY& mapCoords)
+{
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    do
+    {
+        hash = HashElement(hash, element);
+    } while (!(element++)->IsLastForTile());
+
+    // Surface edges, water and land smoothing depend on the surfaces of the adjacent tiles.
+    for (const auto& offset : CoordsDirectionDelta)
+    {
+        const auto neighbour = mapCoords + offset;
+        const SurfaceElement* surface = MapIsLocationValid(neighbour) ? MapGetSurfaceElementAt(neighbour) : nullptr;
+        if (surface != nullptr)
+        {
+            hash = HashElement(hash, surface);
+        }
+        else
+        {
+            hash = HashWord(hash, 0);
+        }
+    }
+    return hash;
+}
+
+static bool TileElementHasStaticPaint(const TileElement& element)
+{
+    if (element.IsGhost() || TileInspector::IsElementSelected(&element))
+    {
+        return false;
+    }
+
+    switch (element.GetType())
+    {
+        case TileElementType::Surface:
+            return true;
+        case TileElementType::Path:
+        {
+            const auto* path = element.AsPath();
+            return !path->HasQueueBanner() && !path->AdditionIsGhost();
+        }
+        case TileElementType::SmallScenery:
+        {
+            const auto* entry = element.AsSmallScenery()->GetEntry();
+            return entry == nullptr || !entry->HasFlag(SMALL_SCENERY_FLAG_ANIMATED);
+        }
+        case TileElementType::Wall:
+        {
+            const auto* entry = element.AsWall()->GetEntry();
+            return entry == nullptr
+                || (!(entry->flags2 & WALL_SCENERY_2_ANIMATED) && entry->scrolling_mode == SCROLLING_MODE_NONE);
+        }
+        case TileElementType::LargeScenery:
+        {
+            // Sign text is stored in the banner rather than the tile element.
+            const auto* entry = element.AsLargeScenery()->GetEntry();
+            return entry == nullptr
+                || (!(entry->flags & LARGE_SCENERY_FLAG_3D_TEXT) && entry->scrolling_mode == SCROLLING_MODE_NONE);
+        }
+        default:
+            // Tracks and entrances depend on the state of their ride, banners scroll their text every tick.
+            return false;
+    }
+}
+
+static bool TileIsInMapSelection(const CoordsXY& mapCoords)
+{
+    if ((gMapSelectFlags & MAP_SELECT_FLAG_ENABLE) && mapCoords.x >= gMapSelectPositionA.x
+        && mapCoords.x <= gMapSelectPositionB.x && mapCoords.y >= gMapSelectPositionA.y
+        && mapCoords.y <= gMapSelectPositionB.y)
+    {
+        return true;
+    }
+    if ((gMapSelectFlags & MAP_SELECT_FLAG_ENABLE_ARROW) && mapCoords.x == gMapSelectArrowPosition.x
+        && mapCoords.y == gMapSelectArrowPosition.y)
+    {
+        return true;
+    }
+    if (gMapSelectFlags & MAP_SELECT_FLAG_ENABLE_CONSTRUCT)
+    {
+        return std::find(gMapSelectionTiles.begin(), gMapSelectionTiles.end(), mapCoords) != gMapSelectionTiles.end();
+    }
+    return false;
+}
+
+static bool TileHasStaticPaint(const TileElement* element, const CoordsXY& mapCoords)
+{
+    if (TileIsInMapSelection(mapCoords))
+    {
+        return false;
+    }
+    if (gConfigGeneral.VirtualFloorStyle != VirtualFloorStyles::Off && VirtualFloorTileIsFloor(mapCoords))
+    {
+        return false;
+    }
+
+    do
+    {
+        if (!TileElementHasStaticPaint(*element))
+        {
+            return false;
+        }
+    } while (!(element++)->IsLastForTile());
+    return true;
+}
+
+static CachedPaintBounds GetImageBounds(ImageId imageId, int32_t x, int32_t y)
+{
+    CachedPaintBounds bounds;
+    const auto* g1 = gfx_get_g1_element(imageId);
+    if (g1 != nullptr)
+    {
+        bounds.Left = x + g1->x_offset;
+        bounds.Top = y + g1->y_offset;
+        bounds.Right = bounds.Left + g1->width;
+        bounds.Bottom = bounds.Top + g1->height;
+    }
+    return bounds;
+}
+
+// Same test as painting from scratch uses to cull a paint struct.
+static bool BoundsWithinDPI(const CachedPaintBounds& bounds, const rct_drawpixelinfo& dpi)
+{
+    return bounds.Right > dpi.x && bounds.Bottom > dpi.y && bounds.Left < dpi.x + dpi.width
+        && bounds.Top < dpi.y + dpi.height;
+}
+
+static size_t CopyPaintStruct(CachedPaintTile& tile, CachedPaintTree& tree, const PaintStruct& ps)
+{
+    const auto index = tile.Structs.size();
+    const auto bounds = GetImageBounds(ps.image_id, ps.x, ps.y);
+    tile.Structs.push_back(ps);
+    tile.StructBounds.push_back(bounds);
+    tree.Bounds.Left = std::min(tree.Bounds.Left, bounds.Left);
+    tree.Bounds.Top = std::min(tree.Bounds.Top, bounds.Top);
+    tree.Bounds.Right = std::max(tree.Bounds.Right, bounds.Right);
+    tree.Bounds.Bottom = std::max(tree.Bounds.Bottom, bounds.Bottom);
+
+    AttachedPaintStruct* firstAttached = nullptr;
+    size_t previousAttached = 0;
+    for (const auto* attached = ps.attached_ps; attached != nullptr; attached = attached->next)
+    {
+        const auto attachedIndex = tile.Attached.size();
+        tile.Attached.push_back(*attached);
+        tile.Attached.back().next = nullptr;
+
+        if (firstAttached == nullptr)
+        {
+            firstAttached = EncodeIndex<AttachedPaintStruct>(attachedIndex);
+        }
+        else
+        {
+            tile.Attached[previousAttached].next = EncodeIndex<AttachedPaintStruct>(attachedIndex);
+        }
+        previousAttached = attachedIndex;
+    }
+    tile.Structs[index].attached_ps = firstAttached;
+
+    if (ps.children != nullptr)
+    {
+        const auto childIndex = CopyPaintStruct(tile, tree, *ps.children);
+        tile.Structs[index].children = EncodeIndex<PaintStruct>(childIndex);
+    }
+    return index;
+}
+
+static PaintSession& GetRecordingSession()
+{
+    thread_local std::unique_ptr<PaintSession> session;
+    if (session == nullptr)
+    {
+        session = std::make_unique<PaintSession>();
+        std::fill(std::begin(session->Quadrants), std::end(session->Quadrants), nullptr);
+        session->PaintEntryChain = _recordingPool.Create();
+    }
+    return *session;
+}
+
+static void RecordTile(CachedPaintTile& tile, const PaintSession& session, const CoordsXY& mapCoords)
+{
+    auto& recording = GetRecordingSession();
+    recording.DPI = session.DPI;
+    recording.DPI.bits = nullptr;
+    recording.DPI.x = -RecordingExtent;
+    recording.DPI.y = -RecordingExtent;
+    recording.DPI.width = RecordingExtent * 2;
+    recording.DPI.height = RecordingExtent * 2;
+    recording.ViewFlags = session.ViewFlags;
+    recording.CurrentRotation = session.CurrentRotation;
+    recording.QuadrantBackIndex = std::numeric_limits<uint32_t>::max();
+    recording.QuadrantFrontIndex = 0;
+    recording.LastPS = nullptr;
+    recording.LastAttachedPS = nullptr;
+    recording.PSStringHead = nullptr;
+    recording.LastPSString = nullptr;
+    recording.WoodenSupportsPrependTo = nullptr;
+    recording.CurrentlyDrawnEntity = nullptr;
+    recording.CurrentlyDrawnTileElement = nullptr;
+    recording.SurfaceElement = nullptr;
+
+    TileElementPaintSetup(recording, mapCoords);
+
+    tile.Structs.clear();
+    tile.StructBounds.clear();
+    tile.Attached.clear();
+    tile.Trees.clear();
+
+    // The quadrant lists are built by prepending, copy them back to front so replaying them keeps the original order.
+    thread_local std::vector<const PaintStruct*> quadrant;
+    if (recording.QuadrantBackIndex != std::numeric_limits<uint32_t>::max())
+    {
+        for (auto i = recording.QuadrantBackIndex; i <= recording.QuadrantFrontIndex; i++)
+        {
+            quadrant.clear();
+            for (const auto* ps = recording.Quadrants[i]; ps != nullptr; ps = ps->next_quadrant_ps)
+            {
+                quadrant.push_back(ps);
+            }
+            recording.Quadrants[i] = nullptr;
+
+            for (auto it = quadrant.rbegin(); it != quadrant.rend(); it++)
+            {
+                CachedPaintTree tree;
+                CopyPaintStruct(tile, tree, **it);
+                tree.StructEnd = static_cast<uint32_t>(tile.Structs.size());
+                tile.Trees.push_back(tree);
+            }
+        }
+    }
+    recording.PaintEntryChain.Reset();
+}
+
+template<typename TAllocateStruct, typename TAllocateAttached>
+static bool ReplayTree(
+    PaintSessionCore& session, const CachedPaintTile& tile, size_t structBegin, size_t structEnd,
+    TAllocateStruct allocateStruct, TAllocateAttached allocateAttached)
+{
+    PaintStruct* root = nullptr;
+    PaintStruct* parent = nullptr;
+    for (auto i = structBegin; i < structEnd; i++)
+    {
+        PaintStruct* ps = allocateStruct();
+        if (ps == nullptr)
+        {
+            return false;
+        }
+        *ps = tile.Structs[i];
+        ps->children = nullptr;
+        ps->attached_ps = nullptr;
+
+        AttachedPaintStruct* previousAttached = nullptr;
+        for (const auto* next = tile.Structs[i].attached_ps; next != nullptr; next = tile.Attached[DecodeIndex(next)].next)
+        {
+            AttachedPaintStruct* attached = allocateAttached();
+            if (attached == nullptr)
+            {
+                return false;
+            }
+            *attached = tile.Attached[DecodeIndex(next)];
+            attached->next = nullptr;
+            if (previousAttached == nullptr)
+            {
+                ps->attached_ps = attached;
+            }
+            else
+            {
+                previousAttached->next = attached;
+            }
+            previousAttached = attached;
+        }
+
+        if (parent == nullptr)
+        {
+            root = ps;
+        }
+        else
+        {
+            parent->children = ps;
+        }
+        parent = ps;
+    }
+
+    if (root != nullptr)
+    {
+        PaintSessionAddPSToQuadrant(session, root);
+    }
+    return true;
+}
+
+/**
+ * Painting from scratch culls every struct on its own, a culled parent turns its first visible child into a parent and
+ * hands its attached structs to the previous struct. Children are rare for static tiles, so rather than replicating
+ * that, tiles with trees that are only partly within the dpi are not replayed and false is returned.
+ */
+template<typename TAllocateStruct, typename TAllocateAttached>
+static bool ReplayTile(
+    PaintSessionCore& session, const rct_drawpixelinfo& dpi, const CachedPaintTile& tile, TAllocateStruct allocateStruct,
+    TAllocateAttached allocateAttached)
+{
+    size_t structBegin = 0;
+    for (const auto& tree : tile.Trees)
+    {
+        if (BoundsWithinDPI(tree.Bounds, dpi))
+        {
+            const bool rootVisible = BoundsWithinDPI(tile.StructBounds[structBegin], dpi);
+            for (auto i = structBegin + 1; i < tree.StructEnd; i++)
+            {
+                if (BoundsWithinDPI(tile.StructBounds[i], dpi) != rootVisible)
+                {
+                    return false;
+                }
+            }
+        }
+        structBegin = tree.StructEnd;
+    }
+
+    structBegin = 0;
+    for (const auto& tree : tile.Trees)
+    {
+        if (BoundsWithinDPI(tile.StructBounds[structBegin], dpi)
+            && !ReplayTree(session, tile, structBegin, tree.StructEnd, allocateStruct, allocateAttached))
+        {
+            break;
+        }
+        structBegin = tree.StructEnd;
+    }
+
+    session.LastPS = nullptr;
+    session.LastAttachedPS = nullptr;
+    return true;
+}
+
+static StaticPaintCacheKey GetCacheKey(uint32_t viewFlags, ZoomLevel zoom, uint8_t rotation)
+{
+    StaticPaintCacheKey key;
+    key.ViewFlags = viewFlags;
+    key.Zoom = zoom;
+    key.Rotation = rotation;
+    if (viewFlags & VIEWPORT_FLAG_CLIP_VIEW)
+    {
+        key.ClipHeight = gClipHeight;
+        key.ClipSelectionA = gClipSelectionA;
+        key.ClipSelectionB = gClipSelectionB;
+    }
+    if (gConfigGeneral.LandscapeSmoothing)
+        key.Options |= StaticPaintCacheOptions::LandscapeSmoothing;
+    if (gConfigGeneral.TransparentWater)
+        key.Options |= StaticPaintCacheOptions::TransparentWater;
+    if (gPaintWidePathsAsGhost)
+        key.Options |= StaticPaintCacheOptions::WidePathsAsGhost;
+    if (gPaintBlockedTiles)
+        key.Options |= StaticPaintCacheOptions::BlockedTiles;
+    if (gConfigGeneral.ShowHeightAsUnits)
+        key.Options |= StaticPaintCacheOptions::HeightsAsUnits;
+    key.Options |= static_cast<uint8_t>(
+        EnumValue(gConfigGeneral.MeasurementFormat) << StaticPaintCacheOptions::MeasurementFormatShift);
+    return key;
+}
+
+StaticPaintCache* PaintStaticCacheGet(uint32_t viewFlags, ZoomLevel zoom, uint8_t rotation)
+{
+    if (!gPaintStaticCacheEnabled || gScreenFlags != SCREEN_FLAGS_PLAYING || gTrackDesignSaveMode
+        || gShowSupportSegmentHeights || lightfx_is_available())
+    {
+        return nullptr;
+    }
+
+    // Peep spawns and patrol areas are drawn on top of surfaces without changing them.
+    if (gCheatsSandboxMode && (viewFlags & VIEWPORT_FLAG_LAND_OWNERSHIP))
+    {
+        return nullptr;
+    }
+    const auto patrolArea = GetPatrolAreaToRender();
+    const auto* patrolAreaStaff = std::get_if<EntityId>(&patrolArea);
+    if (patrolAreaStaff == nullptr || !patrolAreaStaff->IsNull())
+    {
+        return nullptr;
+    }
+
+    const auto key = GetCacheKey(viewFlags, zoom, rotation);
+
+    std::lock_guard<std::mutex> lock(_cachesMutex);
+    _cacheUseCounter++;
+    for (auto& cache : _caches)
+    {
+        if (cache->Key == key)
+        {
+            cache->LastUsed = _cacheUseCounter;
+            return cache.get();
+        }
+    }
+
+    if (_caches.size() >= MaxStaticPaintCaches)
+    {
+        auto oldest = std::min_element(_caches.begin(), _caches.end(), [](const auto& a, const auto& b) {
+            return a->LastUsed < b->LastUsed;
+        });
+        _caches.erase(oldest);
+    }
+
+    auto& cache = _caches.emplace_back(std::make_unique<StaticPaintCache>());
+    cache->Key = key;
+    cache->LastUsed = _cacheUseCounter;
+    return cache.get();
+}
+
+void PaintStaticCacheTileSetup(StaticPaintCache& cache, PaintSession& session, const CoordsXY& mapCoords)
+{
+    PROFILED_FUNCTION();
+
+    const auto* firstElement = MapIsEdge(mapCoords) ? nullptr : MapGetFirstElementAt(mapCoords);
+    if (firstElement == nullptr || !TileHasStaticPaint(firstElement, mapCoords))
+    {
+        TileElementPaintSetup(session, mapCoords);
+        return;
+    }
+
+    const auto tileIndex = GetTileIndex(mapCoords);
+    const auto hash = HashTile(firstElement, mapCoords);
+
+    auto& shard = cache.Shards[tileIndex % NumStaticPaintCacheShards];
+    std::lock_guard<std::mutex> lock(shard.Mutex);
+
+    auto it = shard.Tiles.find(tileIndex);
+    if (it == shard.Tiles.end())
+    {
+        if (shard.Tiles.size() >= MaxTilesPerShard)
+        {
+            shard.Tiles.clear();
+        }
+        it = shard.Tiles.emplace(tileIndex, CachedPaintTile{}).first;
+    }
+
+    auto& tile = it->second;
+    if (tile.FirstElement != firstElement || tile.Hash != hash)
+    {
+        RecordTile(tile, session, mapCoords);
+        tile.FirstElement = firstElement;
+        tile.Hash = hash;
+    }
+    if (!ReplayTile(
+            session, session.DPI, tile, [&session]() { return session.AllocateNormalPaintEntry(); },
+            [&session]() { return session.AllocateAttachedPaintEntry(); }))
+    {
+        TileElementPaintSetup(session, mapCoords);
+    }
+}
+
+bool PaintStaticCacheTilePick(
+    StaticPaintCache& cache, PaintSessionCore& session, const rct_drawpixelinfo& dpi, const CoordsXY& mapCoords,
+    StaticPaintPickStorage& storage)
+{
+    const auto* firstElement = MapIsEdge(mapCoords) ? nullptr : MapGetFirstElementAt(mapCoords);
+    if (firstElement == nullptr || !TileHasStaticPaint(firstElement, mapCoords))
+    {
+        return false;
+    }
+
+    const auto tileIndex = GetTileIndex(mapCoords);
+    auto& shard = cache.Shards[tileIndex % NumStaticPaintCacheShards];
+    std::lock_guard<std::mutex> lock(shard.Mutex);
+
+    auto it = shard.Tiles.find(tileIndex);
+    if (it == shard.Tiles.end() || it->second.FirstElement != firstElement
+        || it->second.Hash != HashTile(firstElement, mapCoords))
+    {
+        return false;
+    }
+
+    return ReplayTile(
+        session, dpi, it->second, [&storage]() { return &storage.Structs.emplace_back(); },
+        [&storage]() { return &storage.Attached.emplace_back(); });
+}
+
+void PaintStaticCacheClear()
+{
+    std::lock_guard<std::mutex> lock(_cachesMutex);
+    _caches.clear();
+}
@@ -0,0 +1,58 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2022 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../world/Location.hpp"
+#include "Paint.h"
+
+#include <deque>
+
+struct StaticPaintCache;
+
+/**
+ * Whether static tile paint output is cached, off unless enabled by the static_paint_cache setting or to compare the
+ * output against painting from scratch.
+ */
+extern bool gPaintStaticCacheEnabled;
+
+/**
+ * Paint structs copied out of the cache for picking, deques keep them in place as more are added.
+ */
+struct StaticPaintPickStorage
+{
+    std::deque<PaintStruct> Structs;
+    std::deque<AttachedPaintStruct> Attached;
+};
+
+/**
+ * Returns the cache of static tile paint output for a view, or nullptr if the current view can not be cached (e.g.
+ * patrol areas are shown or the game is not in play mode).
+ */
+StaticPaintCache* PaintStaticCacheGet(uint32_t viewFlags, ZoomLevel zoom, uint8_t rotation);
+
+/**
+ * Paints the tile elements of a tile by re-using the paint structs generated for it in an earlier frame. Tiles with
+ * animated elements, or whose elements or neighbouring surfaces changed since, are painted from scratch.
+ */
+void PaintStaticCacheTileSetup(StaticPaintCache& cache, PaintSession& session, const CoordsXY& mapCoords);
+
+/**
+ * Adds the cached paint output of a tile within the dpi to the quadrants of the session like PaintStaticCacheTileSetup,
+ * without painting or recording anything. Returns false if the tile is not static or its output is not cached yet.
+ */
+bool PaintStaticCacheTilePick(
+    StaticPaintCache& cache, PaintSessionCore& session, const rct_drawpixelinfo& dpi, const CoordsXY& mapCoords,
+    StaticPaintPickStorage& storage);
+
+/**
+ * Drops all cached paint output, must be called whenever tile elements are replaced wholesale (e.g. loading a park)
+ * as the objects they refer to may have changed.
+ */
+void PaintStaticCacheClear();
@@ -22,11 +22,15 @@
 #include "../world/SmallScenery.h"
 #include "Boundbox.h"
 #include "Paint.Entity.h"
+#include "Paint.StaticCache.h"
 #include "tile_element/Paint.TileElement.h"
 
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <limits>
+#include <memory>
+#include <vector>
 
 using namespace OpenRCT2;
 
@@ -85,7 +89,7 @@ static int32_t RemapPositionToQuadrant(const PaintStruct& ps, uint8_t rotation)
     return 0;
 }
 
-static void PaintSessionAddPSToQuadrant(PaintSession& session, PaintStruct* ps)
+void PaintSessionAddPSToQuadrant(PaintSessionCore& session, PaintStruct* ps)
 {
     const auto positionHash = RemapPositionToQuadrant(*ps, session.CurrentRotation);
 
@@ -197,10 +201,27 @@ static PaintStruct* CreateNormalPaintStruct(
     return ps;
 }
 
-template<uint8_t direction> void PaintSessionGenerateRotate(PaintSession& session)
+static void PaintSessionTileElementSetup(PaintSession& session, StaticPaintCache* staticCache, const CoordsXY& mapCoords)
+{
+    if (staticCache != nullptr)
+    {
+        PaintStaticCacheTileSetup(*staticCache, session, mapCoords);
+    }
+    else
+    {
+        TileElementPaintSetup(session, mapCoords);
+    }
+}
+
+/**
+ * Visits the tiles whose elements and entities may be painted within the dpi, in the order they are painted. Stops as
+ * soon as a callback returns false.
+ */
+template<uint8_t direction, typename TTileElementFn, typename TEntityFn>
+static bool PaintForEachTileInColumn(const rct_drawpixelinfo& dpi, TTileElementFn tileElementFn, TEntityFn entityFn)
 {
     // Optimised modified version of viewport_coord_to_map_coord
-    ScreenCoordsXY screenCoord = { floor2(session.DPI.x, 32), floor2((session.DPI.y - 16), 32) };
+    ScreenCoordsXY screenCoord = { floor2(dpi.x, 32), floor2((dpi.y - 16), 32) };
     CoordsXY mapTile = { screenCoord.y - screenCoord.x / 2, screenCoord.y + screenCoord.x / 2 };
     mapTile = mapTile.Rotate(direction);
 
@@ -210,7 +231,7 @@ template<uint8_t direction> void PaintSessionGenerateRotate(PaintSession& sessio
     }
     mapTile = mapTile.ToTileStart();
 
-    uint16_t numVerticalTiles = (session.DPI.height + 2128) >> 5;
+    uint16_t numVerticalTiles = (dpi.height + 2128) >> 5;
 
     // Adjacent tiles to also check due to overlapping of sprites
     constexpr CoordsXY adjacentTiles[] = {
@@ -222,21 +243,55 @@ template<uint8_t direction> void PaintSessionGenerateRotate(PaintSession& sessio
 
     for (; numVerticalTiles > 0; --numVerticalTiles)
     {
-        TileElementPaintSetup(session, mapTile);
-        EntityPaintSetup(session, mapTile);
+        if (!tileElementFn(mapTile) || !entityFn(mapTile))
+            return false;
 
         const auto loc1 = mapTile + adjacentTiles[0];
-        EntityPaintSetup(session, loc1);
+        if (!entityFn(loc1))
+            return false;
 
         const auto loc2 = mapTile + adjacentTiles[1];
-        TileElementPaintSetup(session, loc2);
-        EntityPaintSetup(session, loc2);
+        if (!tileElementFn(loc2) || !entityFn(loc2))
+            return false;
 
         const auto loc3 = mapTile + adjacentTiles[2];
-        EntityPaintSetup(session, loc3);
+        if (!entityFn(loc3))
+            return false;
 
         mapTile += nextVerticalTile;
     }
+    return true;
+}
+
+template<uint8_t direction> void PaintSessionGenerateRotate(PaintSession& session)
+{
+    auto* staticCache = PaintStaticCacheGet(session.ViewFlags, session.DPI.zoom_level, session.CurrentRotation);
+
+    PaintForEachTileInColumn<direction>(
+        session.DPI,
+        [&session, staticCache](const CoordsXY& mapCoords) {
+            PaintSessionTileElementSetup(session, staticCache, mapCoords);
+            return true;
+        },
+        [&session](const CoordsXY& mapCoords) {
+            EntityPaintSetup(session, mapCoords);
+            return true;
+        });
+}
+
+template<uint8_t direction>
+static bool PaintSessionPickRotate(
+    PaintSessionCore& session, const rct_drawpixelinfo& dpi, StaticPaintCache& staticCache,
+    StaticPaintPickStorage& storage)
+{
+    return PaintForEachTileInColumn<direction>(
+        dpi,
+        [&](const CoordsXY& mapCoords) {
+            // Tiles without cached output are fine as long as painting them would not add anything.
+            return PaintStaticCacheTilePick(staticCache, session, dpi, mapCoords, storage)
+                || !TileElementPaintMayOverlap(dpi, session.ViewFlags, session.CurrentRotation, mapCoords);
+        },
+        [&](const CoordsXY& mapCoords) { return !EntityPaintMayOverlap(dpi, session.ViewFlags, mapCoords); });
 }
 
 /**
@@ -316,148 +371,212 @@ namespace PaintSortFlags
     static constexpr uint8_t OutsideQuadrant = (1U << 7);
 } // namespace PaintSortFlags
 
+/**
+ * The sort only reads the bounds and quadrant of each paint struct. These are copied into a contiguous array kept in
+ * list order, so the passes over dense quadrants scan memory linearly instead of chasing pointers through the much
+ * larger paint structs. The first node holds the head of the list.
+ */
+struct PaintSortNode
+{
+    PaintStructBoundBox Bounds;
+    uint16_t QuadrantIndex;
+    uint8_t SortFlags;
+    PaintStruct* Struct;
+};
+
+struct PaintSortBuffers
+{
+    std::vector<PaintSortNode> Nodes;
+    std::vector<PaintSortNode> MovedNodes;
+    std::vector<size_t> MovedIndices;
+};
+
 template<uint8_t TRotation>
-static PaintStruct* PaintArrangeStructsHelperRotation(PaintStruct* ps_next, uint16_t quadrantIndex, uint8_t flag)
+static size_t PaintArrangeStructsHelperRotation(
+    PaintSortBuffers& buffers, size_t psNext, uint16_t quadrantIndex, uint8_t flag)
 {
-    PaintStruct* ps;
-    PaintStruct* ps_temp;
+    auto& nodes = buffers.Nodes;
+    const size_t count = nodes.size();
 
     // Get the first node in the specified quadrant.
+    size_t ps;
     do
     {
-        ps = ps_next;
-        ps_next = ps_next->next_quadrant_ps;
-        if (ps_next == nullptr)
+        ps = psNext;
+        psNext = ps + 1;
+        if (psNext == count)
             return ps;
-    } while (quadrantIndex > ps_next->quadrant_index);
+    } while (quadrantIndex > nodes[psNext].QuadrantIndex);
 
     // We keep track of the first node in the quadrant so the next call with a higher quadrant index
     // can use this node to skip some iterations.
-    PaintStruct* psQuadrantEntry = ps;
+    const size_t psQuadrantEntry = ps;
 
-    // Visit all nodes in the linked quadrant list and determine their current
-    // sorting relevancy.
-    ps_temp = ps;
-    do
+    // Visit all nodes in the list and determine their current sorting relevancy. Only the nodes before the first
+    // one outside of the range take part in this pass.
+    size_t rangeEnd = count;
+    for (size_t i = psQuadrantEntry + 1; i < count; i++)
     {
-        ps = ps->next_quadrant_ps;
-        if (ps == nullptr)
-            break;
-
-        if (ps->quadrant_index > quadrantIndex + 1)
+        auto& node = nodes[i];
+        if (node.QuadrantIndex > quadrantIndex + 1)
         {
             // Outside of the range.
-            ps->SortFlags = PaintSortFlags::OutsideQuadrant;
+            node.SortFlags = PaintSortFlags::OutsideQuadrant;
+            rangeEnd = std::min(rangeEnd, i);
+            break;
         }
-        else if (ps->quadrant_index == quadrantIndex + 1)
+        if (node.QuadrantIndex == quadrantIndex + 1)
         {
             // Is neighbour and requires a visit.
-            ps->SortFlags = PaintSortFlags::Neighbour | PaintSortFlags::PendingVisit;
+            node.SortFlags = PaintSortFlags::Neighbour | PaintSortFlags::PendingVisit;
         }
-        else if (ps->quadrant_index == quadrantIndex)
+        else if (node.QuadrantIndex == quadrantIndex)
         {
             // In specified quadrant, requires visit.
-            ps->SortFlags = flag | PaintSortFlags::PendingVisit;
+            node.SortFlags = flag | PaintSortFlags::PendingVisit;
         }
-    } while (ps->quadrant_index <= quadrantIndex + 1);
-    ps = ps_temp;
+        else if (node.SortFlags & PaintSortFlags::OutsideQuadrant)
+        {
+            rangeEnd = std::min(rangeEnd, i);
+        }
+    }
 
-    // Iterate all nodes in the current list and re-order them based on
-    // the current rotation and their bounding box.
+    auto& movedNodes = buffers.MovedNodes;
+    auto& movedIndices = buffers.MovedIndices;
+    size_t visit = psQuadrantEntry + 1;
     while (true)
     {
-        // Get the first pending node in the quadrant list
-        while (true)
+        // Get the first pending node in the range.
+        while (visit < rangeEnd && !(nodes[visit].SortFlags & PaintSortFlags::PendingVisit))
         {
-            ps_next = ps->next_quadrant_ps;
-            if (ps_next == nullptr)
-            {
-                // End of the current list.
-                return psQuadrantEntry;
-            }
-            if (ps_next->SortFlags & PaintSortFlags::OutsideQuadrant)
-            {
-                // Reached point outside of specified quadrant.
-                return psQuadrantEntry;
-            }
-            if (ps_next->SortFlags & PaintSortFlags::PendingVisit)
-            {
-                // Found node to check on.
-                break;
-            }
-            ps = ps_next;
+            visit++;
         }
+        if (visit == rangeEnd)
+            return psQuadrantEntry;
 
         // Mark visited.
-        ps_next->SortFlags &= ~PaintSortFlags::PendingVisit;
-        ps_temp = ps;
+        nodes[visit].SortFlags &= ~PaintSortFlags::PendingVisit;
 
-        // Compare current node against the remaining children.
-        const PaintStructBoundBox& initialBBox = ps_next->bounds;
-        while (true)
+        // Compare current node against the remaining neighbours, each one that intersects moves in front of it.
+        const PaintStructBoundBox initialBBox = nodes[visit].Bounds;
+        movedNodes.clear();
+        movedIndices.clear();
+        for (size_t i = visit + 1; i < rangeEnd; i++)
         {
-            ps = ps_next;
-            ps_next = ps_next->next_quadrant_ps;
-            if (ps_next == nullptr)
-                break;
-            if (ps_next->SortFlags & PaintSortFlags::OutsideQuadrant)
-                break;
-            if (!(ps_next->SortFlags & PaintSortFlags::Neighbour))
-                continue;
-
-            const PaintStructBoundBox& currentBBox = ps_next->bounds;
-
-            const bool compareResult = CheckBoundingBox<TRotation>(initialBBox, currentBBox);
-
-            if (compareResult)
+            const auto& node = nodes[i];
+            if ((node.SortFlags & PaintSortFlags::Neighbour) && CheckBoundingBox<TRotation>(initialBBox, node.Bounds))
+            {
+                movedNodes.push_back(node);
+                movedIndices.push_back(i);
+            }
+        }
+        if (movedNodes.empty())
+            continue;
+
+        // Every moved node is inserted directly in front of the current one, so the last one found ends up first.
+        // Shift the other nodes up to the last moved one back to make room.
+        size_t dst = movedIndices.back();
+        size_t moved = movedIndices.size();
+        for (size_t i = movedIndices.back() + 1; i-- > visit;)
+        {
+            if (moved > 0 && movedIndices[moved - 1] == i)
             {
-                // Child node intersects with current node, move behind.
-                ps->next_quadrant_ps = ps_next->next_quadrant_ps;
-                PaintStruct* ps_temp2 = ps_temp->next_quadrant_ps;
-                ps_temp->next_quadrant_ps = ps_next;
-                ps_next->next_quadrant_ps = ps_temp2;
-                ps_next = ps;
+                moved--;
+                continue;
             }
+            nodes[dst--] = nodes[i];
         }
+        std::copy(movedNodes.rbegin(), movedNodes.rend(), nodes.begin() + visit);
 
-        ps = ps_temp;
+        // The moved nodes are visited next, they might require other neighbours to be moved in front of them.
     }
 }
 
 template<int TRotation> static void PaintSessionArrange(PaintSessionCore& session, bool)
 {
     PaintStruct* psHead = &session.PaintHead;
+    psHead->next_quadrant_ps = nullptr;
+
+    if (session.QuadrantBackIndex == UINT32_MAX)
+        return;
 
-    PaintStruct* ps = psHead;
-    ps->next_quadrant_ps = nullptr;
+    // Columns are arranged on the job pool, each thread keeps its own buffers.
+    thread_local PaintSortBuffers buffers;
+    auto& nodes = buffers.Nodes;
+    nodes.clear();
 
-    uint32_t quadrantIndex = session.QuadrantBackIndex;
-    if (quadrantIndex != UINT32_MAX)
+    // Concatenate the quadrants back to front, the head of the list is kept in the first node.
+    nodes.push_back({ {}, 0, PaintSortFlags::None, psHead });
+    for (uint32_t quadrantIndex = session.QuadrantBackIndex; quadrantIndex <= session.QuadrantFrontIndex; quadrantIndex++)
     {
-        do
+        for (PaintStruct* ps = session.Quadrants[quadrantIndex]; ps != nullptr; ps = ps->next_quadrant_ps)
         {
-            PaintStruct* ps_next = session.Quadrants[quadrantIndex];
-            if (ps_next != nullptr)
-            {
-                ps->next_quadrant_ps = ps_next;
-                do
-                {
-                    ps = ps_next;
-                    ps_next = ps_next->next_quadrant_ps;
+            nodes.push_back({ ps->bounds, ps->quadrant_index, PaintSortFlags::None, ps });
+        }
+    }
 
-                } while (ps_next != nullptr);
-            }
-        } while (++quadrantIndex <= session.QuadrantFrontIndex);
+    size_t psCache = PaintArrangeStructsHelperRotation<TRotation>(
+        buffers, 0, session.QuadrantBackIndex & 0xFFFF, PaintSortFlags::Neighbour);
 
-        PaintStruct* ps_cache = PaintArrangeStructsHelperRotation<TRotation>(
-            psHead, session.QuadrantBackIndex & 0xFFFF, PaintSortFlags::Neighbour);
+    uint32_t quadrantIndex = session.QuadrantBackIndex;
+    while (++quadrantIndex < session.QuadrantFrontIndex)
+    {
+        psCache = PaintArrangeStructsHelperRotation<TRotation>(
+            buffers, psCache, quadrantIndex & 0xFFFF, PaintSortFlags::None);
+    }
 
-        quadrantIndex = session.QuadrantBackIndex;
-        while (++quadrantIndex < session.QuadrantFrontIndex)
-        {
-            ps_cache = PaintArrangeStructsHelperRotation<TRotation>(ps_cache, quadrantIndex & 0xFFFF, PaintSortFlags::None);
-        }
+    // Link the paint structs in the sorted order.
+    for (size_t i = 0; i + 1 < nodes.size(); i++)
+    {
+        nodes[i].Struct->next_quadrant_ps = nodes[i + 1].Struct;
+    }
+    nodes.back().Struct->next_quadrant_ps = nullptr;
+}
+
+PaintStruct* PaintSessionPick(const rct_drawpixelinfo& dpi, uint32_t viewFlags)
+{
+    PROFILED_FUNCTION();
+
+    const auto rotation = get_current_rotation();
+    auto* staticCache = PaintStaticCacheGet(viewFlags, dpi.zoom_level, rotation);
+    if (staticCache == nullptr)
+        return nullptr;
+
+    thread_local std::unique_ptr<PaintSessionCore> session;
+    thread_local StaticPaintPickStorage storage;
+    if (session == nullptr)
+    {
+        session = std::make_unique<PaintSessionCore>();
+    }
+    std::fill(std::begin(session->Quadrants), std::end(session->Quadrants), nullptr);
+    session->ViewFlags = viewFlags;
+    session->CurrentRotation = rotation;
+    session->QuadrantBackIndex = std::numeric_limits<uint32_t>::max();
+    session->QuadrantFrontIndex = 0;
+    storage.Structs.clear();
+    storage.Attached.clear();
+
+    bool picked = false;
+    switch (DirectionFlipXAxis(rotation))
+    {
+        case 0:
+            picked = PaintSessionPickRotate<0>(*session, dpi, *staticCache, storage);
+            break;
+        case 1:
+            picked = PaintSessionPickRotate<1>(*session, dpi, *staticCache, storage);
+            break;
+        case 2:
+            picked = PaintSessionPickRotate<2>(*session, dpi, *staticCache, storage);
+            break;
+        case 3:
+            picked = PaintSessionPickRotate<3>(*session, dpi, *staticCache, storage);
+            break;
     }
+    if (!picked)
+        return nullptr;
+
+    PaintSessionArrange(*session);
+    return &session->PaintHead;
 }
 
 /**
@@ -977,12 +1096,15 @@ PaintEntry* PaintEntryPool::Chain::Allocate()
     }
     else if (Current->Count >= NodeSize)
     {
-        // We need another node
-        Current->Next = Pool->AllocateNode();
+        // We need another node, unless one was kept from before the chain was reset
         if (Current->Next == nullptr)
         {
-            // Unable to allocate any more nodes
-            return nullptr;
+            Current->Next = Pool->AllocateNode();
+            if (Current->Next == nullptr)
+            {
+                // Unable to allocate any more nodes
+                return nullptr;
+            }
         }
         Current = Current->Next;
     }
@@ -1003,6 +1125,28 @@ void PaintEntryPool::Chain::Clear()
     assert(Current == nullptr);
 }
 
+void PaintEntryPool::Chain::Reset()
+{
+    if (Current == nullptr)
+    {
+        return;
+    }
+
+    // Keep the nodes that were used since the last reset, the rest go back to the pool so one busy frame does not
+    // hold on to them.
+    if (Pool != nullptr && Current->Next != nullptr)
+    {
+        Pool->FreeNodes(Current->Next);
+    }
+    Current->Next = nullptr;
+
+    for (auto* node = Head; node != nullptr; node = node->Next)
+    {
+        node->Count = 0;
+    }
+    Current = Head;
+}
+
 size_t PaintEntryPool::Chain::GetCount() const
 {
     size_t count = 0;
@@ -1037,7 +1181,12 @@ PaintEntryPool::Node* PaintEntryPool::AllocateNode()
     else
     {
         result = new (std::nothrow) PaintEntryPool::Node();
+        if (result != nullptr)
+        {
+            _nodeCount++;
+        }
     }
+    _rentCount++;
     return result;
 }
 
@@ -1060,3 +1209,15 @@ void PaintEntryPool::FreeNodes(PaintEntryPool::Node* head)
         node = next;
     }
 }
+
+size_t PaintEntryPool::GetNodeCount() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _nodeCount;
+}
+
+size_t PaintEntryPool::GetRentCount() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _rentCount;
+}
@@ -134,7 +134,9 @@ static constexpr int32_t MaxPaintQuadrants = MAXIMUM_MAP_SIZE_TECHNICAL * 2;
  * The internal implementation uses an unrolled linked list so that each
  * paint session can quickly allocate a new paint entry until it requires
  * another node / block of paint entries. Only the node allocation needs to
- * be thread safe.
+ * be thread safe. A chain that is reset rather than cleared keeps its nodes,
+ * so a session that is reused every frame only goes to the pool when it
+ * needs more entries than it did last time.
  */
 class PaintEntryPool
 {
@@ -163,12 +165,15 @@ public:
 
         PaintEntry* Allocate();
         void Clear();
+        void Reset();
         size_t GetCount() const;
     };
 
 private:
     std::vector<Node*> _available;
-    std::mutex _mutex;
+    mutable std::mutex _mutex;
+    size_t _nodeCount{};
+    size_t _rentCount{};
 
     Node* AllocateNode();
 
@@ -177,6 +182,12 @@ public:
 
     Chain Create();
     void FreeNodes(Node* head);
+
+    // Returns the number of nodes the pool has allocated.
+    size_t GetNodeCount() const;
+
+    // Returns the number of times a chain had to rent a node from the pool.
+    size_t GetRentCount() const;
 };
 
 struct PaintSessionCore
@@ -330,6 +341,15 @@ void PaintFloatingMoneyEffect(
 PaintSession* PaintSessionAlloc(rct_drawpixelinfo* dpi, uint32_t viewFlags);
 void PaintSessionFree(PaintSession* session);
 void PaintSessionGenerate(PaintSession& session);
+void PaintSessionAddPSToQuadrant(PaintSessionCore& session, PaintStruct* ps);
 void PaintSessionArrange(PaintSessionCore& session);
+
+/**
+ * Arranges the paint structs within a single pixel dpi like PaintSessionGenerate and PaintSessionArrange would, but from
+ * the paint output cached for static tiles instead of painting them. Returns nullptr if anything there has to be painted
+ * (entities, animated elements or tiles not cached yet), otherwise the head of the arranged list. The list stays valid
+ * until the next call on the same thread.
+ */
+PaintStruct* PaintSessionPick(const rct_drawpixelinfo& dpi, uint32_t viewFlags);
 void PaintDrawStructs(PaintSession& session);
 void PaintDrawMoneyStructs(rct_drawpixelinfo* dpi, PaintStringStruct* ps);
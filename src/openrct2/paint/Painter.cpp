@@ -147,19 +147,19 @@ PaintSession* Painter::CreateSession(rct_drawpixelinfo* dpi, uint32_t viewFlags)
     }
     else
     {
-        // Create new one in pool.
+        // Create new one in pool, sessions keep their chain of paint entries for as long as they live.
         _paintSessionPool.emplace_back(std::make_unique<PaintSession>());
         session = _paintSessionPool.back().get();
+        session->PaintEntryChain = _paintStructPool.Create();
+        std::fill(std::begin(session->Quadrants), std::end(session->Quadrants), nullptr);
     }
 
     session->DPI = *dpi;
     session->ViewFlags = viewFlags;
     session->QuadrantBackIndex = std::numeric_limits<uint32_t>::max();
     session->QuadrantFrontIndex = 0;
-    session->PaintEntryChain = _paintStructPool.Create();
     session->Flags = 0;
 
-    std::fill(std::begin(session->Quadrants), std::end(session->Quadrants), nullptr);
     session->LastPS = nullptr;
     session->LastAttachedPS = nullptr;
     session->PSStringHead = nullptr;
@@ -176,10 +176,24 @@ void Painter::ReleaseSession(PaintSession* session)
 {
     PROFILED_FUNCTION();
 
-    session->PaintEntryChain.Clear();
+    // Only the quadrants between the back and front index can have been used.
+    if (session->QuadrantBackIndex != std::numeric_limits<uint32_t>::max())
+    {
+        std::fill(
+            std::begin(session->Quadrants) + session->QuadrantBackIndex,
+            std::begin(session->Quadrants) + session->QuadrantFrontIndex + 1, nullptr);
+        session->QuadrantBackIndex = std::numeric_limits<uint32_t>::max();
+    }
+
+    session->PaintEntryChain.Reset();
     _freePaintSessions.push_back(session);
 }
 
+const PaintEntryPool& Painter::GetPaintEntryPool() const
+{
+    return _paintStructPool;
+}
+
 Painter::~Painter()
 {
     for (auto&& session : _paintSessionPool)
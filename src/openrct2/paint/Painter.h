@@ -49,6 +49,7 @@ namespace OpenRCT2
 
             PaintSession* CreateSession(rct_drawpixelinfo* dpi, uint32_t viewFlags);
             void ReleaseSession(PaintSession* session);
+            const PaintEntryPool& GetPaintEntryPool() const;
             ~Painter();
 
         private:
@@ -36,6 +36,10 @@
 
 static void BlankTilesPaint(PaintSession& session, int32_t x, int32_t y);
 static void PaintTileElementBase(PaintSession& session, const CoordsXY& origCoords);
+static int32_t BlankTileGetScreenY(uint8_t rotation, int32_t& x, int32_t& y);
+static bool BlankTileWithinDPI(const rct_drawpixelinfo& dpi, int32_t screenY);
+static bool TileElementsWithinDPI(
+    const rct_drawpixelinfo& dpi, int32_t screenMinY, const TileElement* element, bool partOfVirtualFloor);
 
 const int32_t SEGMENTS_ALL = SEGMENT_B4 | SEGMENT_B8 | SEGMENT_BC | SEGMENT_C0 | SEGMENT_C4 | SEGMENT_C8 | SEGMENT_CC
     | SEGMENT_D0 | SEGMENT_D4;
@@ -63,14 +67,68 @@ void TileElementPaintSetup(PaintSession& session, const CoordsXY& mapCoords, boo
     }
 }
 
+bool TileElementPaintMayOverlap(
+    const rct_drawpixelinfo& dpi, uint32_t viewFlags, uint8_t rotation, const CoordsXY& mapCoords)
+{
+    if (MapIsEdge(mapCoords))
+    {
+        if (viewFlags & VIEWPORT_FLAG_TRANSPARENT_BACKGROUND)
+            return false;
+
+        int32_t x = mapCoords.x;
+        int32_t y = mapCoords.y;
+        return BlankTileWithinDPI(dpi, BlankTileGetScreenY(rotation, x, y));
+    }
+
+    if (viewFlags & VIEWPORT_FLAG_CLIP_VIEW)
+    {
+        if (mapCoords.x < gClipSelectionA.x || mapCoords.x > gClipSelectionB.x)
+            return false;
+        if (mapCoords.y < gClipSelectionA.y || mapCoords.y > gClipSelectionB.y)
+            return false;
+    }
+
+    const auto* element = MapGetFirstElementAt(mapCoords);
+    if (element == nullptr)
+        return false;
+
+    // The arrow is painted regardless of the other elements.
+    if ((gMapSelectFlags & MAP_SELECT_FLAG_ENABLE_ARROW) && mapCoords.x == gMapSelectArrowPosition.x
+        && mapCoords.y == gMapSelectArrowPosition.y)
+    {
+        return true;
+    }
+
+    const bool partOfVirtualFloor = gConfigGeneral.VirtualFloorStyle != VirtualFloorStyles::Off
+        && VirtualFloorTileIsFloor(mapCoords);
+    auto origin = mapCoords;
+    if (rotation == 1 || rotation == 2)
+        origin.x += COORDS_XY_STEP;
+    if (rotation == 2 || rotation == 3)
+        origin.y += COORDS_XY_STEP;
+    const int32_t screenMinY = Translate3DTo2DWithZ(rotation, { origin, 0 }).y;
+    return TileElementsWithinDPI(dpi, screenMinY, element, partOfVirtualFloor);
+}
+
 /**
  *
  *  rct2: 0x0068B60E
  */
 static void BlankTilesPaint(PaintSession& session, int32_t x, int32_t y)
+{
+    if (!BlankTileWithinDPI(session.DPI, BlankTileGetScreenY(session.CurrentRotation, x, y)))
+        return;
+
+    session.SpritePosition.x = x;
+    session.SpritePosition.y = y;
+    session.InteractionType = ViewportInteractionItem::None;
+    PaintAddImageAsParent(session, ImageId(SPR_BLANK_TILE), { 0, 0, 16 }, { 32, 32, -1 });
+}
+
+static int32_t BlankTileGetScreenY(uint8_t rotation, int32_t& x, int32_t& y)
 {
     int32_t dx = 0;
-    switch (session.CurrentRotation)
+    switch (rotation)
     {
         case 0:
             dx = x + y;
@@ -91,20 +149,40 @@ static void BlankTilesPaint(PaintSession& session, int32_t x, int32_t y)
     }
     dx /= 2;
     dx -= 16;
-    int32_t bx = dx + 32;
+    return dx;
+}
 
-    rct_drawpixelinfo* dpi = &session.DPI;
-    if (bx <= dpi->y)
-        return;
-    dx -= 20;
-    dx -= dpi->height;
-    if (dx >= dpi->y)
-        return;
+static bool BlankTileWithinDPI(const rct_drawpixelinfo& dpi, int32_t screenY)
+{
+    return screenY + 32 > dpi.y && screenY - 20 - dpi.height < dpi.y;
+}
 
-    session.SpritePosition.x = x;
-    session.SpritePosition.y = y;
-    session.InteractionType = ViewportInteractionItem::None;
-    PaintAddImageAsParent(session, ImageId(SPR_BLANK_TILE), { 0, 0, 16 }, { 32, 32, -1 });
+static bool TileElementsWithinDPI(
+    const rct_drawpixelinfo& dpi, int32_t screenMinY, const TileElement* element, bool partOfVirtualFloor)
+{
+    if (screenMinY + 52 <= dpi.y)
+        return false;
+
+    uint16_t max_height = 0;
+    do
+    {
+        max_height = std::max(max_height, static_cast<uint16_t>(element->GetClearanceZ()));
+    } while (!(element++)->IsLastForTile());
+
+    element--;
+
+    if (element->GetType() == TileElementType::Surface && (element->AsSurface()->GetWaterHeight() > 0))
+    {
+        max_height = element->AsSurface()->GetWaterHeight();
+    }
+
+    if (partOfVirtualFloor)
+    {
+        // We must pretend this tile is at least as tall as the virtual floor
+        max_height = std::max(max_height, VirtualFloorGetHeight());
+    }
+
+    return screenMinY - (max_height + 32) < dpi.y + dpi.height;
 }
 
 bool gShowSupportSegmentHeights = false;
@@ -183,31 +261,7 @@ static void PaintTileElementBase(PaintSession& session, const CoordsXY& origCoor
         PaintAddImageAsParent(session, imageId, { 0, 0, arrowZ }, { 32, 32, -1 }, { 0, 0, arrowZ + 18 });
     }
 
-    if (screenMinY + 52 <= dpi->y)
-        return;
-
-    const TileElement* element = tile_element; // push tile_element
-
-    uint16_t max_height = 0;
-    do
-    {
-        max_height = std::max(max_height, static_cast<uint16_t>(element->GetClearanceZ()));
-    } while (!(element++)->IsLastForTile());
-
-    element--;
-
-    if (element->GetType() == TileElementType::Surface && (element->AsSurface()->GetWaterHeight() > 0))
-    {
-        max_height = element->AsSurface()->GetWaterHeight();
-    }
-
-    if (partOfVirtualFloor)
-    {
-        // We must pretend this tile is at least as tall as the virtual floor
-        max_height = std::max(max_height, VirtualFloorGetHeight());
-    }
-
-    if (screenMinY - (max_height + 32) >= dpi->y + dpi->height)
+    if (!TileElementsWithinDPI(*dpi, screenMinY, tile_element, partOfVirtualFloor))
         return;
 
     session.SpritePosition.x = coords.x;
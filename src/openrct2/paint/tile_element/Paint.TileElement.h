@@ -13,6 +13,7 @@
 #include "../../world/Map.h"
 
 struct PaintSession;
+struct rct_drawpixelinfo;
 
 enum edge_t
 {
@@ -97,6 +98,13 @@ uint16_t PaintUtilRotateSegments(uint16_t segments, uint8_t rotation);
 
 void TileElementPaintSetup(PaintSession& session, const CoordsXY& mapCoords, bool isTrackPiecePreview = false);
 
+/**
+ * Returns whether TileElementPaintSetup may add anything for the tile within the dpi, using the same conservative screen
+ * bounds it skips tiles by.
+ */
+bool TileElementPaintMayOverlap(
+    const rct_drawpixelinfo& dpi, uint32_t viewFlags, uint8_t rotation, const CoordsXY& mapCoords);
+
 void PaintEntrance(PaintSession& session, uint8_t direction, int32_t height, const EntranceElement& entranceElement);
 void PaintBanner(PaintSession& session, uint8_t direction, int32_t height, const BannerElement& bannerElement);
 void PaintSurface(PaintSession& session, uint8_t direction, uint16_t height, const SurfaceElement& tileElement);
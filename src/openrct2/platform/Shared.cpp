@@ -48,6 +48,7 @@ namespace Platform
             InitTicks();
             bitcount_init();
             mask_init();
+            blit_run_init();
         }
     }
 
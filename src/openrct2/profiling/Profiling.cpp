@@ -9,6 +9,7 @@
 
 #include "Profiling.h"
 
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <fstream>
@@ -120,13 +121,79 @@ namespace OpenRCT2::Profiling
             return Registry;
         }
 
+        static std::vector<Counter*>& GetCounterRegistry()
+        {
+            static std::vector<Counter*> Registry;
+            return Registry;
+        }
+
     } // namespace Detail
 
+    Counter::Counter(const char* name)
+        : _name(name)
+    {
+        Detail::GetCounterRegistry().push_back(this);
+    }
+
+    void Counter::EndFrame()
+    {
+        if (!IsEnabled())
+            return;
+
+        const auto value = _value.exchange(0);
+
+        std::scoped_lock lock(_mutex);
+        _samples[_sampleIterator++ % _samples.size()] = value;
+        _frameCount++;
+        _total += value;
+        _max = std::max(_max, value);
+    }
+
+    void Counter::Reset()
+    {
+        std::scoped_lock lock(_mutex);
+        _value = 0;
+        _sampleIterator = 0;
+        _frameCount = 0;
+        _total = 0;
+        _max = 0;
+    }
+
+    uint64_t Counter::GetFrameCount() const
+    {
+        std::scoped_lock lock(_mutex);
+        return _frameCount;
+    }
+
+    uint64_t Counter::GetTotal() const
+    {
+        std::scoped_lock lock(_mutex);
+        return _total;
+    }
+
+    uint64_t Counter::GetMax() const
+    {
+        std::scoped_lock lock(_mutex);
+        return _max;
+    }
+
+    std::vector<uint64_t> Counter::GetFrameSamples() const
+    {
+        std::scoped_lock lock(_mutex);
+        const auto numSamples = std::min(_sampleIterator, _samples.size());
+        return { _samples.begin(), _samples.begin() + numSamples };
+    }
+
     const std::vector<Function*>& GetData()
     {
         return Detail::GetRegistry();
     }
 
+    const std::vector<Counter*>& GetCounters()
+    {
+        return Detail::GetCounterRegistry();
+    }
+
     void ResetData()
     {
         for (auto* func : Detail::GetRegistry())
@@ -141,6 +208,11 @@ namespace OpenRCT2::Profiling
             funcInternal->Children.clear();
             funcInternal->Parents.clear();
         }
+
+        for (auto* counter : Detail::GetCounterRegistry())
+        {
+            counter->Reset();
+        }
     }
 
     bool ExportCSV(const std::string& filePath)
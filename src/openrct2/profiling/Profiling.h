@@ -182,12 +182,72 @@ namespace OpenRCT2::Profiling
         }
     };
 
-    // Clears all the current data of each function.
+    /**
+     * A value summed up over each frame by the code that owns it, e.g. the number of pixels drawn. Counters are created
+     * as globals and only count while the profiler is enabled.
+     */
+    class Counter
+    {
+        const char* _name;
+
+        mutable std::mutex _mutex;
+
+        // Value of the frame in progress.
+        std::atomic<uint64_t> _value{};
+
+        // Values of the most recent frames.
+        std::array<uint64_t, Detail::MaxSamplesSize> _samples{};
+        size_t _sampleIterator{};
+
+        uint64_t _frameCount{};
+        uint64_t _total{};
+        uint64_t _max{};
+
+    public:
+        explicit Counter(const char* name);
+        Counter(const Counter&) = delete;
+        Counter& operator=(const Counter&) = delete;
+
+        const char* GetName() const noexcept
+        {
+            return _name;
+        }
+
+        void Add(uint64_t value) noexcept
+        {
+            if (IsEnabled())
+            {
+                _value += value;
+            }
+        }
+
+        // Ends the current frame, its value becomes the latest sample.
+        void EndFrame();
+
+        // Clears the value of the current frame and all samples.
+        void Reset();
+
+        uint64_t GetFrameCount() const;
+
+        // Returns the sum of all frames.
+        uint64_t GetTotal() const;
+
+        // Returns the highest value of a frame.
+        uint64_t GetMax() const;
+
+        // Returns a small window of the most recent frame values.
+        std::vector<uint64_t> GetFrameSamples() const;
+    };
+
+    // Clears all the current data of each function and counter.
     void ResetData();
 
     // Returns all functions.
     const std::vector<Function*>& GetData();
 
+    // Returns all counters.
+    const std::vector<Counter*>& GetCounters();
+
     bool ExportCSV(const std::string& filePath);
 
 } // namespace OpenRCT2::Profiling
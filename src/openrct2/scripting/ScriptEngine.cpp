@@ -12,6 +12,7 @@
 #    include "ScriptEngine.h"
 
 #    include "../PlatformEnvironment.h"
+#    include "../actions/BatchAction.h"
 #    include "../actions/CustomAction.h"
 #    include "../actions/GameAction.h"
 #    include "../actions/RideCreateAction.h"
@@ -1157,6 +1158,22 @@ DukValue ScriptEngine::GameActionResultToDuk(const GameAction& action, const Gam
             obj.Set("ride", rideIndex.ToUnderlying());
         }
     }
+    else if (action.GetType() == GameCommand::Batch)
+    {
+        if (result.Error == GameActions::Status::Ok)
+        {
+            const auto actionResult = result.GetData<BatchActionResult>();
+            duk_push_array(_context);
+            duk_uarridx_t index = 0;
+            for (auto outcome : actionResult.Outcomes)
+            {
+                duk_push_int(_context, EnumValue(outcome));
+                duk_put_prop_index(_context, -2, index);
+                index++;
+            }
+            obj.Set("errors", DukValue::take_from_stack(_context));
+        }
+    }
     else if (action.GetType() == GameCommand::HireNewStaffMember)
     {
         if (result.Error == GameActions::Status::Ok)
@@ -1270,6 +1287,7 @@ const static EnumMap<GameCommand> ActionNameToType = {
     { "bannersetcolour", GameCommand::SetBannerColour },
     { "bannersetname", GameCommand::SetBannerName },
     { "bannersetstyle", GameCommand::SetBannerStyle },
+    { "batch", GameCommand::Batch },
     { "changemapsize", GameCommand::ChangeMapSize },
     { "clearscenery", GameCommand::ClearScenery },
     { "climateset", GameCommand::SetClimate },
@@ -1448,6 +1466,19 @@ std::unique_ptr<GameAction> ScriptEngine::CreateGameAction(const std::string& ac
         {
             action->AcceptFlags(visitor);
         }
+        if (action->GetType() == GameCommand::Batch)
+        {
+            // { actions: [ { action: "smallsceneryplace", args: { ... } }, ... ] }
+            auto& batch = static_cast<BatchAction&>(*action);
+            auto dukActions = args["actions"];
+            if (dukActions.is_array())
+            {
+                for (const auto& dukAction : dukActions.as_array())
+                {
+                    batch.AddAction(CreateGameAction(AsOrDefault<std::string>(dukAction["action"]), dukAction["args"]));
+                }
+            }
+        }
         return action;
     }
 
@@ -69,6 +69,38 @@ namespace OpenRCT2::Scripting
             return DukValue::take_from_stack(_ctx);
         }
 
+        DukValue getCounters()
+        {
+            duk_push_array(_ctx);
+            duk_uarridx_t index = 0;
+            for (const auto* counter : OpenRCT2::Profiling::GetCounters())
+            {
+                DukObject obj(_ctx);
+                obj.Set("name", counter->GetName());
+                obj.Set("frameCount", counter->GetFrameCount());
+                obj.Set("total", counter->GetTotal());
+                obj.Set("max", counter->GetMax());
+                obj.Set("frameSamples", GetSampleArray(counter->GetFrameSamples()));
+                obj.Take().push();
+                duk_put_prop_index(_ctx, /* duk stack index */ -2, index);
+                index++;
+            }
+            return DukValue::take_from_stack(_ctx);
+        }
+
+        DukValue GetSampleArray(const std::vector<uint64_t>& samples)
+        {
+            duk_push_array(_ctx);
+            duk_uarridx_t index = 0;
+            for (auto sample : samples)
+            {
+                duk_push_number(_ctx, static_cast<duk_double_t>(sample));
+                duk_put_prop_index(_ctx, /* duk stack index */ -2, index);
+                index++;
+            }
+            return DukValue::take_from_stack(_ctx);
+        }
+
         void start()
         {
             OpenRCT2::Profiling::Enable();
@@ -93,6 +125,7 @@ namespace OpenRCT2::Scripting
         static void Register(duk_context* ctx)
         {
             dukglue_register_method(ctx, &ScProfiler::getData, "getData");
+            dukglue_register_method(ctx, &ScProfiler::getCounters, "getCounters");
             dukglue_register_method(ctx, &ScProfiler::start, "start");
             dukglue_register_method(ctx, &ScProfiler::stop, "stop");
             dukglue_register_method(ctx, &ScProfiler::reset, "reset");
@@ -22,6 +22,7 @@
 #include "../core/String.hpp"
 #include "../core/StringBuilder.h"
 #include "../core/Zip.h"
+#include "../core/ZipStream.hpp"
 #include "../scenario/ScenarioRepository.h"
 #include "../scenario/ScenarioSources.h"
 #include "../util/Util.h"
@@ -113,13 +114,21 @@ namespace OpenRCT2::Title
                 auto zip = Zip::TryOpen(seq.Path, ZIP_ACCESS::READ);
                 if (zip != nullptr)
                 {
-                    auto data = zip->GetFileData(filename);
-                    auto ms = std::make_unique<OpenRCT2::MemoryStream>();
-                    ms->Write(data.data(), data.size());
-                    ms->SetPosition(0);
+                    std::unique_ptr<OpenRCT2::IStream> stream;
+                    auto zipStream = zip->GetFileStream(filename);
+                    if (zipStream != nullptr && zipStream->GetData() != nullptr)
+                    {
+                        // Stored entries can be read in place for as long as the archive is open
+                        stream = std::make_unique<OpenRCT2::ZipStreamWrapper>(std::move(zip), std::move(zipStream));
+                    }
+                    else
+                    {
+                        // Park importers need to seek, which is slow on compressed entries, so decompress it up front
+                        stream = std::make_unique<OpenRCT2::MemoryStream>(zip->GetFileData(filename));
+                    }
 
                     handle = std::make_unique<TitleSequenceParkHandle>();
-                    handle->Stream = std::move(ms);
+                    handle->Stream = std::move(stream);
                     handle->HintPath = filename;
                 }
                 else
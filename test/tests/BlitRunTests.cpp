@@ -0,0 +1,152 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2022 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <array>
+#include <gtest/gtest.h>
+#include <openrct2/drawing/Drawing.h>
+#include <openrct2/util/Util.h>
+#include <random>
+#include <vector>
+
+// Amount of random runs drawn with every blend op by every set of run blitters.
+constexpr int32_t TEST_RUN_COUNT = 20000;
+// Longest run drawn, long enough to cover several vectors plus a scalar tail.
+constexpr int32_t TEST_MAX_RUN_LENGTH = 160;
+
+using BlitRunFn = void (*)(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count);
+using BlitRunRemapFn = void (*)(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const uint8_t* RESTRICT table);
+
+struct RunBlitters
+{
+    const char* Name;
+    BlitRunFn Transparent;
+    BlitRunRemapFn Remap;
+    BlitRunRemapFn RemapDst;
+};
+
+static std::vector<RunBlitters> GetRunBlitters()
+{
+    std::vector<RunBlitters> blitters = {
+        { "scalar", blit_run_transparent_scalar, blit_run_remap_scalar, blit_run_remap_dst_scalar },
+    };
+    if (sse41_available())
+    {
+        blitters.push_back({ "SSE4.1", blit_run_transparent_sse4_1, blit_run_remap_sse4_1, blit_run_remap_dst_sse4_1 });
+    }
+    if (avx2_available())
+    {
+        blitters.push_back({ "AVX2", blit_run_transparent_avx2, blit_run_remap_avx2, blit_run_remap_dst_avx2 });
+    }
+    return blitters;
+}
+
+class BlitRunTests : public testing::Test
+{
+protected:
+    std::mt19937 _random{ 0x4F52 };
+    std::array<uint8_t, 256> _table{};
+    std::vector<uint8_t> _src;
+    std::vector<uint8_t> _dst;
+    int32_t _count{};
+
+    // Makes up a run with transparent pixels, unaligned pointers and a table that maps some colours to 0.
+    void RandomiseRun()
+    {
+        std::uniform_int_distribution<int32_t> byte(0, 255);
+        std::uniform_int_distribution<int32_t> length(0, TEST_MAX_RUN_LENGTH);
+        std::uniform_int_distribution<int32_t> offset(0, 31);
+
+        for (auto& entry : _table)
+        {
+            entry = byte(_random) < 32 ? 0 : static_cast<uint8_t>(byte(_random));
+        }
+
+        _count = length(_random);
+        _src.resize(static_cast<size_t>(offset(_random)) + _count);
+        _dst.resize(static_cast<size_t>(offset(_random)) + _count);
+        for (auto& pixel : _src)
+        {
+            pixel = byte(_random) < 64 ? 0 : static_cast<uint8_t>(byte(_random));
+        }
+        for (auto& pixel : _dst)
+        {
+            pixel = static_cast<uint8_t>(byte(_random));
+        }
+    }
+
+    const uint8_t* Src() const
+    {
+        return _src.data() + (_src.size() - _count);
+    }
+
+    uint8_t* Dst(std::vector<uint8_t>& dst) const
+    {
+        return dst.data() + (dst.size() - _count);
+    }
+
+    template<DrawBlendOp TBlendOp> std::vector<uint8_t> BlitPixels()
+    {
+        auto expected = _dst;
+        PaletteMap paletteMap(_table.data(), 1, static_cast<uint16_t>(_table.size()));
+        for (int32_t i = 0; i < _count; i++)
+        {
+            BlitPixel<TBlendOp>(Src() + i, Dst(expected) + i, paletteMap);
+        }
+        return expected;
+    }
+};
+
+TEST_F(BlitRunTests, transparent_matches_blit_pixel)
+{
+    for (const auto& blitters : GetRunBlitters())
+    {
+        SCOPED_TRACE(blitters.Name);
+        for (int32_t i = 0; i < TEST_RUN_COUNT; i++)
+        {
+            RandomiseRun();
+            const auto expected = BlitPixels<BLEND_TRANSPARENT>();
+            auto actual = _dst;
+            blitters.Transparent(Src(), Dst(actual), _count);
+            ASSERT_EQ(actual, expected) << "run " << i << " of " << _count << " pixels";
+        }
+    }
+}
+
+TEST_F(BlitRunTests, remap_matches_blit_pixel)
+{
+    for (const auto& blitters : GetRunBlitters())
+    {
+        SCOPED_TRACE(blitters.Name);
+        for (int32_t i = 0; i < TEST_RUN_COUNT; i++)
+        {
+            RandomiseRun();
+            const auto expected = BlitPixels<BLEND_TRANSPARENT | BLEND_SRC>();
+            auto actual = _dst;
+            blitters.Remap(Src(), Dst(actual), _count, _table.data());
+            ASSERT_EQ(actual, expected) << "run " << i << " of " << _count << " pixels";
+        }
+    }
+}
+
+TEST_F(BlitRunTests, remap_dst_matches_blit_pixel)
+{
+    for (const auto& blitters : GetRunBlitters())
+    {
+        SCOPED_TRACE(blitters.Name);
+        for (int32_t i = 0; i < TEST_RUN_COUNT; i++)
+        {
+            RandomiseRun();
+            const auto expected = BlitPixels<BLEND_TRANSPARENT | BLEND_DST>();
+            auto actual = _dst;
+            blitters.RemapDst(Src(), Dst(actual), _count, _table.data());
+            ASSERT_EQ(actual, expected) << "run " << i << " of " << _count << " pixels";
+        }
+    }
+}
@@ -0,0 +1,100 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2022 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TestData.h"
+
+#include <gtest/gtest.h>
+#include <openrct2/Cheats.h>
+#include <openrct2/Context.h>
+#include <openrct2/Game.h>
+#include <openrct2/GameState.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/actions/SetCheatAction.h>
+#include <openrct2/entity/EntityList.h>
+#include <openrct2/entity/EntityRegistry.h>
+#include <openrct2/entity/Guest.h>
+#include <openrct2/platform/Platform.h>
+
+using namespace OpenRCT2;
+
+// Ticks between two checks, the same interval the server sends checksums at.
+constexpr uint32_t ChecksumInterval = 40;
+constexpr uint32_t ChecksumTicks = ChecksumInterval * 50;
+
+class EntityChecksumTests : public testing::Test
+{
+protected:
+    std::unique_ptr<IContext> _context;
+
+    void SetUp() override
+    {
+        gOpenRCT2Headless = true;
+        gOpenRCT2NoGraphics = true;
+        Platform::CoreInit();
+
+        _context = CreateContext();
+        ASSERT_TRUE(_context->Initialise());
+        ASSERT_TRUE(_context->LoadParkFromFile(TestData::GetParkPath("bpb.sv6")));
+        game_load_init();
+    }
+
+    void TearDown() override
+    {
+        _context = nullptr;
+    }
+};
+
+TEST_F(EntityChecksumTests, rolling_matches_full_after_ticks)
+{
+    auto* gs = _context->GetGameState();
+    ASSERT_TRUE(VerifyRollingEntitiesChecksum());
+
+    for (uint32_t i = 1; i <= ChecksumTicks; i++)
+    {
+        gs->UpdateLogic();
+        if (i % ChecksumInterval == 0)
+        {
+            ASSERT_TRUE(VerifyRollingEntitiesChecksum()) << "after tick " << i;
+        }
+    }
+}
+
+TEST_F(EntityChecksumTests, rolling_picks_up_direct_writes)
+{
+    ASSERT_TRUE(VerifyRollingEntitiesChecksum());
+    const auto before = GetRollingEntitiesChecksum();
+
+    // Fields written outside of any update loop or action are still noticed.
+    auto guests = EntityList<Guest>();
+    auto* guest = *guests.begin();
+    ASSERT_NE(guest, nullptr);
+    guest->Energy = guest->Energy == 100 ? 101 : 100;
+
+    ASSERT_NE(GetRollingEntitiesChecksum().raw, before.raw);
+    ASSERT_TRUE(VerifyRollingEntitiesChecksum());
+}
+
+TEST_F(EntityChecksumTests, rolling_matches_full_after_actions)
+{
+    auto* gs = _context->GetGameState();
+
+    auto happiness = SetCheatAction(CheatType::SetGuestParameter, GUEST_PARAMETER_HAPPINESS, 0);
+    ASSERT_EQ(GameActions::Execute(&happiness).Error, GameActions::Status::Ok);
+    ASSERT_TRUE(VerifyRollingEntitiesChecksum());
+
+    auto removeGuests = SetCheatAction(CheatType::RemoveAllGuests);
+    ASSERT_EQ(GameActions::Execute(&removeGuests).Error, GameActions::Status::Ok);
+    ASSERT_TRUE(VerifyRollingEntitiesChecksum());
+
+    for (uint32_t i = 0; i < ChecksumInterval; i++)
+    {
+        gs->UpdateLogic();
+    }
+    ASSERT_TRUE(VerifyRollingEntitiesChecksum());
+}
@@ -0,0 +1,130 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2022 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <openrct2/core/File.h>
+#include <openrct2/core/FileSystem.hpp>
+#include <openrct2/core/Imaging.h>
+#include <openrct2/core/Path.hpp>
+#include <openrct2/drawing/Drawing.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+class PngRowWriterTests : public testing::Test
+{
+protected:
+    static constexpr uint32_t Width = 37;
+    static constexpr uint32_t Height = 23;
+
+    std::string _path;
+    GamePalette _palette{};
+
+    void SetUp() override
+    {
+        _path = Path::Combine(fs::temp_directory_path().u8string(), u8"png_row_writer_test.png");
+        File::Delete(_path);
+    }
+
+    void TearDown() override
+    {
+        File::Delete(_path);
+    }
+
+    // Rows with a stride larger than the image, to check only the image width is written.
+    static std::vector<uint8_t> CreatePixels(uint32_t stride)
+    {
+        std::vector<uint8_t> pixels(static_cast<size_t>(stride) * Height);
+        for (uint32_t y = 0; y < Height; y++)
+        {
+            for (uint32_t x = 0; x < stride; x++)
+            {
+                pixels[y * stride + x] = x < Width ? static_cast<uint8_t>(x * 7 + y * 13) : 0xFF;
+            }
+        }
+        return pixels;
+    }
+
+    bool TempFileExists() const
+    {
+        return File::Exists(_path + ".tmp");
+    }
+};
+
+TEST_F(PngRowWriterTests, rows_written_in_parts_read_back)
+{
+    constexpr uint32_t stride = Width + 3;
+    const auto pixels = CreatePixels(stride);
+
+    {
+        Imaging::PngRowWriter writer(_path, Width, Height, _palette);
+        ASSERT_FALSE(File::Exists(_path));
+
+        // Uneven parts, the last one smaller than the others.
+        for (uint32_t y = 0; y < Height; y += 5)
+        {
+            writer.WriteRows(pixels.data() + y * stride, stride, std::min(5u, Height - y));
+        }
+        writer.Finish();
+    }
+    ASSERT_TRUE(File::Exists(_path));
+    ASSERT_FALSE(TempFileExists());
+
+    auto image = Imaging::ReadFromFile(_path, IMAGE_FORMAT::PNG);
+    ASSERT_EQ(image.Width, Width);
+    ASSERT_EQ(image.Height, Height);
+    ASSERT_EQ(image.Depth, 8u);
+    for (uint32_t y = 0; y < Height; y++)
+    {
+        for (uint32_t x = 0; x < Width; x++)
+        {
+            ASSERT_EQ(image.Pixels[y * image.Stride + x], pixels[y * stride + x]);
+        }
+    }
+}
+
+TEST_F(PngRowWriterTests, missing_rows_leave_no_file)
+{
+    const auto pixels = CreatePixels(Width);
+    {
+        Imaging::PngRowWriter writer(_path, Width, Height, _palette);
+        writer.WriteRows(pixels.data(), Width, Height - 1);
+        ASSERT_THROW(writer.Finish(), std::runtime_error);
+    }
+    ASSERT_FALSE(File::Exists(_path));
+    ASSERT_FALSE(TempFileExists());
+}
+
+TEST_F(PngRowWriterTests, unfinished_image_leaves_no_file)
+{
+    const auto pixels = CreatePixels(Width);
+    {
+        Imaging::PngRowWriter writer(_path, Width, Height, _palette);
+        writer.WriteRows(pixels.data(), Width, 3);
+        ASSERT_TRUE(TempFileExists());
+    }
+    ASSERT_FALSE(File::Exists(_path));
+    ASSERT_FALSE(TempFileExists());
+}
+
+TEST_F(PngRowWriterTests, finished_image_replaces_existing_file)
+{
+    const std::string previous = "previous";
+    File::WriteAllBytes(_path, previous.data(), previous.size());
+
+    const auto pixels = CreatePixels(Width);
+    Imaging::PngRowWriter writer(_path, Width, Height, _palette);
+    writer.WriteRows(pixels.data(), Width, Height);
+    writer.Finish();
+
+    auto image = Imaging::ReadFromFile(_path, IMAGE_FORMAT::PNG);
+    ASSERT_EQ(image.Width, Width);
+    ASSERT_EQ(image.Height, Height);
+}
@@ -0,0 +1,212 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2022 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <gtest/gtest.h>
+#include <memory>
+#include <openrct2/network/NetworkConnection.h>
+#include <openrct2/network/NetworkPacket.h>
+#include <vector>
+
+/**
+ * In-memory socket, everything sent ends up in Sent. Sending can be blocked to simulate a full socket buffer.
+ */
+class FakeSocket final : public ITcpSocket
+{
+public:
+    std::shared_ptr<std::deque<uint8_t>> Sent = std::make_shared<std::deque<uint8_t>>();
+    std::shared_ptr<std::deque<uint8_t>> Received = std::make_shared<std::deque<uint8_t>>();
+    bool Blocked = false;
+
+    SocketStatus GetStatus() const override
+    {
+        return SocketStatus::Connected;
+    }
+    const char* GetError() const override
+    {
+        return nullptr;
+    }
+    const char* GetHostName() const override
+    {
+        return "fake";
+    }
+    std::string GetIpAddress() const override
+    {
+        return "127.0.0.1";
+    }
+    void Listen(uint16_t port) override
+    {
+    }
+    void Listen(const std::string& address, uint16_t port) override
+    {
+    }
+    std::unique_ptr<ITcpSocket> Accept() override
+    {
+        return nullptr;
+    }
+    void Connect(const std::string& address, uint16_t port) override
+    {
+    }
+    void ConnectAsync(const std::string& address, uint16_t port) override
+    {
+    }
+
+    size_t SendData(const void* buffer, size_t size) override
+    {
+        if (Blocked)
+            return 0;
+
+        auto bytes = static_cast<const uint8_t*>(buffer);
+        Sent->insert(Sent->end(), bytes, bytes + size);
+        return size;
+    }
+
+    NetworkReadPacket ReceiveData(void* buffer, size_t size, size_t* sizeReceived) override
+    {
+        if (Received->empty())
+        {
+            *sizeReceived = 0;
+            return NetworkReadPacket::NoData;
+        }
+        const auto count = std::min(size, Received->size());
+        std::copy_n(Received->begin(), count, static_cast<uint8_t*>(buffer));
+        Received->erase(Received->begin(), Received->begin() + count);
+        *sizeReceived = count;
+        return NetworkReadPacket::Success;
+    }
+
+    void SetNoDelay(bool noDelay) override
+    {
+    }
+    uintptr_t GetNativeHandle() const override
+    {
+        return InvalidNativeSocketHandle;
+    }
+    void Finish() override
+    {
+    }
+    void Disconnect() override
+    {
+    }
+    void Close() override
+    {
+    }
+};
+
+class NetworkConnectionTests : public testing::Test
+{
+protected:
+    NetworkConnection _sender;
+    NetworkConnection _receiver;
+    FakeSocket* _senderSocket = nullptr;
+
+    void SetUp() override
+    {
+        auto senderSocket = std::make_unique<FakeSocket>();
+        auto receiverSocket = std::make_unique<FakeSocket>();
+        // Connect both ends: what the sender sends is what the receiver receives.
+        receiverSocket->Received = senderSocket->Sent;
+        senderSocket->Received = receiverSocket->Sent;
+
+        _senderSocket = senderSocket.get();
+        _sender.Socket = std::move(senderSocket);
+        _sender.AuthStatus = NetworkAuth::Ok;
+        _receiver.Socket = std::move(receiverSocket);
+        _receiver.AuthStatus = NetworkAuth::Ok;
+    }
+
+    static NetworkPacket CreatePacket(uint32_t value)
+    {
+        NetworkPacket packet(NetworkCommand::Ping);
+        packet << value;
+        return packet;
+    }
+
+    // Reads everything the sender sent so far and returns the values of the packets in the order they arrived.
+    std::vector<uint32_t> ReceiveValues()
+    {
+        _receiver.ServiceIo();
+        EXPECT_FALSE(_receiver.IsIoDisconnected());
+
+        std::vector<uint32_t> values;
+        NetworkPacket packet;
+        while (_receiver.PopInboundPacket(packet))
+        {
+            if (packet.GetCommand() == NetworkCommand::Ping)
+            {
+                uint32_t value{};
+                packet >> value;
+                values.push_back(value);
+            }
+        }
+        return values;
+    }
+
+    void EnableCompression()
+    {
+        _sender.QueuePacket(NetworkPacket(NetworkCommand::CompressStream));
+        ASSERT_TRUE(_sender.SendQueuedPackets());
+        ASSERT_TRUE(ReceiveValues().empty());
+    }
+};
+
+TEST_F(NetworkConnectionTests, front_packets_skip_queued_packets)
+{
+    _sender.QueuePacket(CreatePacket(1));
+    _sender.QueuePacket(CreatePacket(2));
+    _sender.QueuePacket(CreatePacket(3), true);
+    _sender.SendQueuedPackets();
+
+    ASSERT_EQ(ReceiveValues(), (std::vector<uint32_t>{ 3, 1, 2 }));
+}
+
+TEST_F(NetworkConnectionTests, compressed_front_packets_skip_queued_packets)
+{
+    EnableCompression();
+
+    _sender.QueuePacket(CreatePacket(1));
+    _sender.QueuePacket(CreatePacket(2));
+    _sender.QueuePacket(CreatePacket(3), true);
+    _sender.SendQueuedPackets();
+
+    ASSERT_EQ(ReceiveValues(), (std::vector<uint32_t>{ 3, 1, 2 }));
+}
+
+TEST_F(NetworkConnectionTests, compressed_packet_keeps_its_position_when_send_fails)
+{
+    EnableCompression();
+
+    // The first packet goes through the compressor, but the socket does not accept any of it.
+    _senderSocket->Blocked = true;
+    _sender.QueuePacket(CreatePacket(1));
+    ASSERT_FALSE(_sender.SendQueuedPackets());
+
+    // A front packet must not be sent ahead of it, the compressed stream already contains the first packet.
+    _sender.QueuePacket(CreatePacket(2));
+    _sender.QueuePacket(CreatePacket(3), true);
+    _senderSocket->Blocked = false;
+    _sender.SendQueuedPackets();
+
+    ASSERT_EQ(ReceiveValues(), (std::vector<uint32_t>{ 1, 3, 2 }));
+}
+
+TEST_F(NetworkConnectionTests, uncompressed_packet_can_be_overtaken_when_send_fails)
+{
+    _senderSocket->Blocked = true;
+    _sender.QueuePacket(CreatePacket(1));
+    ASSERT_FALSE(_sender.SendQueuedPackets());
+
+    _sender.QueuePacket(CreatePacket(2), true);
+    _senderSocket->Blocked = false;
+    _sender.SendQueuedPackets();
+
+    ASSERT_EQ(ReceiveValues(), (std::vector<uint32_t>{ 2, 1 }));
+}
@@ -15,17 +15,25 @@
 #include <openrct2/GameState.h>
 #include <openrct2/OpenRCT2.h>
 #include <openrct2/ReplayManager.h>
+#include <openrct2/actions/ParkSetNameAction.h>
 #include <openrct2/audio/AudioContext.h>
 #include <openrct2/core/File.h>
 #include <openrct2/core/FileScanner.h>
+#include <openrct2/core/FileSystem.hpp>
 #include <openrct2/core/Path.hpp>
 #include <openrct2/core/String.hpp>
 #include <openrct2/platform/Platform.h>
 #include <openrct2/ride/Ride.h>
+#include <openrct2/world/Park.h>
 #include <string>
 
 using namespace OpenRCT2;
 
+// Long enough for the recording to contain a keyframe after the initial one.
+constexpr uint32_t RoundTripTicks = 40 * 60 * 2 + 200;
+constexpr uint32_t RoundTripRenameTick = 20;
+constexpr uint32_t RoundTripLateRenameTick = RoundTripTicks - 100;
+
 struct ReplayTestData
 {
     std::string name;
@@ -101,6 +109,72 @@ TEST_P(ReplayTests, RunReplay)
     ASSERT_FALSE(replayManager->IsPlaybackStateMismatching());
 }
 
+TEST(ReplayRoundTripTest, write_read_seek)
+{
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+    Platform::CoreInit();
+
+    auto context = CreateContext();
+    ASSERT_TRUE(context->Initialise());
+    ASSERT_TRUE(context->LoadParkFromFile(TestData::GetParkPath("bpb.sv6")));
+    game_load_init();
+
+    auto gs = context->GetGameState();
+    auto& park = gs->GetPark();
+    IReplayManager* replayManager = context->GetReplayManager();
+    const auto originalName = park.Name;
+    const auto replayFile = Path::Combine(fs::temp_directory_path().u8string(), u8"replay_round_trip.parkrep");
+
+    // Record a replay with one action before and one after the second keyframe.
+    ASSERT_TRUE(replayManager->StartRecording(replayFile));
+    const uint32_t tickStart = gCurrentTicks;
+    for (uint32_t i = 0; i < RoundTripTicks; i++)
+    {
+        if (i == RoundTripRenameTick || i == RoundTripLateRenameTick)
+        {
+            auto action = ParkSetNameAction(i == RoundTripRenameTick ? "Replay test" : "Replay test late");
+            ASSERT_EQ(GameActions::Execute(&action).Error, GameActions::Status::Ok);
+        }
+        gs->UpdateLogic();
+    }
+    ASSERT_TRUE(replayManager->StopRecording());
+
+    // The actions read back are the ones that were recorded.
+    std::vector<std::pair<uint32_t, std::unique_ptr<GameAction>>> actions;
+    ASSERT_TRUE(replayManager->ReadReplayActions(replayFile, actions));
+    ASSERT_EQ(actions.size(), 2u);
+    ASSERT_EQ(actions[0].first, RoundTripRenameTick);
+    ASSERT_EQ(actions[0].second->GetType(), GameCommand::SetParkName);
+    ASSERT_EQ(actions[1].first, RoundTripLateRenameTick);
+
+    // Seeking forward past the second keyframe restores it and replays the remaining ticks.
+    ASSERT_TRUE(replayManager->StartPlayback(replayFile));
+    ASSERT_EQ(gCurrentTicks, tickStart);
+    ASSERT_EQ(park.Name, originalName);
+    ASSERT_TRUE(replayManager->SeekPlayback(RoundTripLateRenameTick + 1));
+    ASSERT_EQ(gCurrentTicks, tickStart + RoundTripLateRenameTick + 1);
+    ASSERT_EQ(park.Name, "Replay test late");
+
+    // Seeking backwards goes through the initial keyframe.
+    ASSERT_TRUE(replayManager->SeekPlayback(RoundTripRenameTick + 1));
+    ASSERT_EQ(gCurrentTicks, tickStart + RoundTripRenameTick + 1);
+    ASSERT_EQ(park.Name, "Replay test");
+
+    // Playing on from there still matches the recording.
+    while (replayManager->IsReplaying())
+    {
+        gs->UpdateLogic();
+        if (replayManager->IsPlaybackStateMismatching())
+            break;
+    }
+    ASSERT_FALSE(replayManager->IsReplaying());
+    ASSERT_FALSE(replayManager->IsPlaybackStateMismatching());
+    ASSERT_EQ(park.Name, "Replay test late");
+
+    File::Delete(replayFile);
+}
+
 static void PrintTo(const ReplayTestData& testData, std::ostream* os)
 {
     *os << testData.filePath;
@@ -0,0 +1,135 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2022 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+#include <gtest/gtest.h>
+#include <memory>
+#include <openrct2/core/SpscQueue.hpp>
+#include <stdint.h>
+#include <thread>
+
+// Amount of elements passed between the threads in the concurrent test.
+constexpr uint32_t TEST_CONCURRENT_COUNT = 1000000;
+
+TEST(SpscQueueTest, fifo)
+{
+    SpscQueue<uint32_t> queue;
+    ASSERT_TRUE(queue.empty());
+
+    uint32_t value = 0;
+    ASSERT_FALSE(queue.pop(value));
+
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        queue.push(i);
+    }
+    ASSERT_FALSE(queue.empty());
+
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        ASSERT_TRUE(queue.pop(value));
+        ASSERT_EQ(value, i);
+    }
+    ASSERT_TRUE(queue.empty());
+    ASSERT_FALSE(queue.pop(value));
+}
+
+TEST(SpscQueueTest, interleaved)
+{
+    SpscQueue<uint32_t> queue;
+    uint32_t next = 0;
+    uint32_t expected = 0;
+    for (uint32_t round = 1; round < 50; round++)
+    {
+        for (uint32_t i = 0; i < round; i++)
+        {
+            queue.push(next++);
+        }
+        // Leave some elements behind for the next round.
+        for (uint32_t i = 0; i < round / 2; i++)
+        {
+            uint32_t value = 0;
+            ASSERT_TRUE(queue.pop(value));
+            ASSERT_EQ(value, expected++);
+        }
+    }
+
+    uint32_t value = 0;
+    while (queue.pop(value))
+    {
+        ASSERT_EQ(value, expected++);
+    }
+    ASSERT_EQ(expected, next);
+}
+
+TEST(SpscQueueTest, move_only_values)
+{
+    SpscQueue<std::unique_ptr<uint32_t>> queue;
+    queue.push(std::make_unique<uint32_t>(1));
+    queue.push(std::make_unique<uint32_t>(2));
+
+    std::unique_ptr<uint32_t> value;
+    ASSERT_TRUE(queue.pop(value));
+    ASSERT_NE(value, nullptr);
+    ASSERT_EQ(*value, 1u);
+
+    // The remaining element is freed by the destructor.
+}
+
+TEST(SpscQueueTest, concurrent)
+{
+    SpscQueue<uint32_t> queue;
+
+    std::thread producer([&queue]() {
+        for (uint32_t i = 0; i < TEST_CONCURRENT_COUNT; i++)
+        {
+            queue.push(i);
+        }
+    });
+
+    uint32_t expected = 0;
+    bool inOrder = true;
+    while (expected < TEST_CONCURRENT_COUNT)
+    {
+        uint32_t value = 0;
+        if (queue.pop(value))
+        {
+            inOrder &= value == expected;
+            expected++;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    ASSERT_TRUE(inOrder);
+    ASSERT_TRUE(queue.empty());
+}
+
+TEST(SpscQueueTest, reuses_blocks)
+{
+    // Small blocks so elements keep crossing from one block into the next.
+    SpscQueue<uint32_t, 4> queue;
+    uint32_t next = 0;
+    uint32_t expected = 0;
+    for (uint32_t round = 1; round < 50; round++)
+    {
+        for (uint32_t i = 0; i < round % 11; i++)
+        {
+            queue.push(next++);
+        }
+        uint32_t value = 0;
+        while (queue.pop(value))
+        {
+            ASSERT_EQ(value, expected++);
+        }
+        ASSERT_TRUE(queue.empty());
+    }
+    ASSERT_EQ(expected, next);
+}
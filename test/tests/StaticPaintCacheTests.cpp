@@ -0,0 +1,172 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2022 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TestData.h"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <openrct2/Context.h>
+#include <openrct2/Game.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/config/Config.h>
+#include <openrct2/drawing/X8DrawingEngine.h>
+#include <openrct2/interface/Viewport.h>
+#include <openrct2/paint/Paint.h>
+#include <openrct2/paint/Paint.StaticCache.h>
+#include <openrct2/platform/Platform.h>
+#include <openrct2/world/Map.h>
+#include <vector>
+
+using namespace OpenRCT2;
+using namespace OpenRCT2::Drawing;
+
+constexpr int32_t ViewWidth = 640;
+constexpr int32_t ViewHeight = 480;
+// Distance between the points picked from a view, odd so the points do not line up with the tile grid.
+constexpr int32_t PickStep = 7;
+
+class StaticPaintCacheTests : public testing::Test
+{
+protected:
+    std::unique_ptr<IContext> _context;
+
+    void SetUp() override
+    {
+        // The base graphics are needed, without them nothing would be drawn to compare.
+        gOpenRCT2Headless = true;
+        gOpenRCT2NoGraphics = false;
+        Platform::CoreInit();
+
+        _context = CreateContext();
+        ASSERT_TRUE(_context->Initialise());
+        ASSERT_TRUE(_context->LoadParkFromFile(TestData::GetParkPath("bpb.sv6")));
+        game_load_init();
+        gScreenFlags = SCREEN_FLAGS_PLAYING;
+    }
+
+    void TearDown() override
+    {
+        gPaintStaticCacheEnabled = false;
+        PaintStaticCacheClear();
+        _context = nullptr;
+        gOpenRCT2NoGraphics = true;
+    }
+
+    // A view of the middle of the park.
+    static rct_viewport GetViewport(int32_t rotation, ZoomLevel zoom, uint32_t flags)
+    {
+        const auto centre = CoordsXY{ gMapSize.x * COORDS_XY_STEP / 2, gMapSize.y * COORDS_XY_STEP / 2 };
+        const auto screenCentre = Translate3DTo2DWithZ(rotation, { centre, TileElementHeight(centre) });
+
+        rct_viewport viewport{};
+        viewport.width = ViewWidth;
+        viewport.height = ViewHeight;
+        viewport.view_width = zoom.ApplyTo(ViewWidth);
+        viewport.view_height = zoom.ApplyTo(ViewHeight);
+        viewport.viewPos = screenCentre - ScreenCoordsXY{ viewport.view_width / 2, viewport.view_height / 2 };
+        viewport.zoom = zoom;
+        viewport.flags = flags;
+        gCurrentRotation = rotation;
+        return viewport;
+    }
+
+    static std::vector<uint8_t> Render(const rct_viewport& viewport, bool cached)
+    {
+        gPaintStaticCacheEnabled = cached;
+
+        std::vector<uint8_t> bits(static_cast<size_t>(ViewWidth) * ViewHeight, PALETTE_INDEX_0);
+        X8DrawingEngine drawingEngine(GetContext()->GetUiContext());
+        rct_drawpixelinfo dpi{};
+        dpi.bits = bits.data();
+        dpi.width = ViewWidth;
+        dpi.height = ViewHeight;
+        dpi.DrawingEngine = &drawingEngine;
+        viewport_render(&dpi, &viewport, { { 0, 0 }, { ViewWidth, ViewHeight } }, nullptr, false);
+        return bits;
+    }
+
+    // Renders the view from scratch, then once filling the cache and once replaying it.
+    static void ExpectCachedMatchesUncached(const rct_viewport& viewport)
+    {
+        const auto uncached = Render(viewport, false);
+        ASSERT_TRUE(std::any_of(uncached.begin(), uncached.end(), [](uint8_t pixel) { return pixel != PALETTE_INDEX_0; }));
+        ASSERT_EQ(Render(viewport, true), uncached) << "recording the cache";
+        ASSERT_EQ(Render(viewport, true), uncached) << "replaying the cache";
+    }
+};
+
+TEST_F(StaticPaintCacheTests, cached_matches_uncached)
+{
+    for (int32_t rotation = 0; rotation < NumOrthogonalDirections; rotation++)
+    {
+        for (ZoomLevel zoom{ 0 }; zoom <= ZoomLevel{ 2 }; zoom++)
+        {
+            const int32_t zoomIndex{ static_cast<int8_t>(zoom) };
+            SCOPED_TRACE(testing::Message() << "rotation " << rotation << ", zoom " << zoomIndex);
+            ExpectCachedMatchesUncached(GetViewport(rotation, zoom, 0));
+        }
+    }
+}
+
+TEST_F(StaticPaintCacheTests, cached_follows_height_marker_settings)
+{
+    const auto viewport = GetViewport(0, ZoomLevel{ 0 }, VIEWPORT_FLAG_LAND_HEIGHTS | VIEWPORT_FLAG_PATH_HEIGHTS);
+
+    // Height markers are part of the cached output, so every change of their units has to be noticed.
+    gConfigGeneral.ShowHeightAsUnits = true;
+    ExpectCachedMatchesUncached(viewport);
+
+    gConfigGeneral.ShowHeightAsUnits = false;
+    gConfigGeneral.MeasurementFormat = MeasurementFormat::Imperial;
+    ExpectCachedMatchesUncached(viewport);
+
+    gConfigGeneral.MeasurementFormat = MeasurementFormat::Metric;
+    ExpectCachedMatchesUncached(viewport);
+}
+
+TEST_F(StaticPaintCacheTests, pick_matches_painting)
+{
+    const int32_t filters[] = { 0xFFFF, EnumsToFlags(ViewportInteractionItem::Terrain) };
+    for (int32_t rotation = 0; rotation < NumOrthogonalDirections; rotation++)
+    {
+        SCOPED_TRACE(testing::Message() << "rotation " << rotation);
+        const auto viewport = GetViewport(rotation, ZoomLevel{ 0 }, 0);
+
+        // Fill the cache, picking only uses what was recorded by rendering.
+        Render(viewport, true);
+
+        size_t pickCount = 0;
+        for (int32_t y = 0; y < ViewHeight; y += PickStep)
+        {
+            for (int32_t x = 0; x < ViewWidth; x += PickStep)
+            {
+                rct_drawpixelinfo dpi{};
+                dpi.x = viewport.viewPos.x + x;
+                dpi.y = viewport.viewPos.y + y;
+                dpi.width = 1;
+                dpi.height = 1;
+                if (PaintSessionPick(dpi, viewport.flags) != nullptr)
+                    pickCount++;
+
+                for (auto filter : filters)
+                {
+                    const auto picked = get_map_coordinates_from_pos_viewport(viewport, { x, y }, filter, true);
+                    const auto painted = get_map_coordinates_from_pos_viewport(viewport, { x, y }, filter, false);
+                    ASSERT_EQ(picked.SpriteType, painted.SpriteType) << "at " << x << ", " << y;
+                    ASSERT_EQ(picked.Element, painted.Element) << "at " << x << ", " << y;
+                    ASSERT_EQ(picked.Entity, painted.Entity) << "at " << x << ", " << y;
+                    ASSERT_EQ(picked.Loc, painted.Loc) << "at " << x << ", " << y;
+                }
+            }
+        }
+
+        // Points over guests or animated elements are painted either way, the comparison is moot if nothing was picked.
+        ASSERT_GT(pickCount, 0u);
+    }
+}
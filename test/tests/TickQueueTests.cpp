@@ -0,0 +1,129 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2022 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+#include <gtest/gtest.h>
+#include <memory>
+#include <openrct2/core/TickQueue.hpp>
+#include <random>
+#include <set>
+#include <stdint.h>
+#include <utility>
+
+// Reference ordering of the queue: by tick and then by insertion order.
+using ReferenceQueue = std::multiset<std::pair<uint32_t, uint32_t>>;
+
+TEST(TickQueueTest, orders_by_tick_then_insertion)
+{
+    TickQueue<uint32_t> queue;
+    ASSERT_TRUE(queue.empty());
+
+    queue.push(10, 0);
+    queue.push(12, 1);
+    queue.push(10, 2);
+    queue.push(8, 3);
+    queue.push(12, 4);
+    ASSERT_EQ(queue.size(), 5u);
+
+    for (uint32_t expected : { 3, 0, 2, 1, 4 })
+    {
+        ASSERT_EQ(queue.front(), expected);
+        ASSERT_EQ(queue.pop(), expected);
+    }
+    ASSERT_TRUE(queue.empty());
+}
+
+TEST(TickQueueTest, move_only_values)
+{
+    TickQueue<std::unique_ptr<uint32_t>> queue;
+    queue.push(2, std::make_unique<uint32_t>(2));
+    queue.push(1, std::make_unique<uint32_t>(1));
+
+    auto value = queue.pop();
+    ASSERT_NE(value, nullptr);
+    ASSERT_EQ(*value, 1u);
+
+    // The remaining element is freed by the destructor.
+}
+
+TEST(TickQueueTest, clamps_ticks_far_from_the_queue)
+{
+    TickQueue<uint32_t> queue;
+    queue.push(100000, 0);
+    queue.push(200000, 1);
+    queue.push(1, 2);
+    queue.push(100000, 3);
+
+    // The window is full, the early tick is clamped to its first tick and the late one to its last.
+    ASSERT_EQ(queue.pop(), 0u);
+    ASSERT_EQ(queue.pop(), 2u);
+    ASSERT_EQ(queue.pop(), 3u);
+    ASSERT_EQ(queue.pop(), 1u);
+    ASSERT_TRUE(queue.empty());
+}
+
+TEST(TickQueueTest, matches_multiset)
+{
+    std::mt19937 rng(0x4F524354);
+    TickQueue<uint32_t> queue;
+    ReferenceQueue reference;
+    std::vector<uint32_t> ticks;
+
+    uint32_t currentTick = 1000;
+    uint32_t sequence = 0;
+    for (uint32_t round = 0; round < 20000; round++)
+    {
+        // Mostly push near the current tick, sometimes a bit in the past or far ahead to grow the ring.
+        const uint32_t pushes = rng() % 8;
+        for (uint32_t i = 0; i < pushes; i++)
+        {
+            uint32_t tick = currentTick + rng() % 4;
+            switch (rng() % 16)
+            {
+                case 0:
+                    tick = currentTick - rng() % 64;
+                    break;
+                case 1:
+                    tick = currentTick + rng() % 1024;
+                    break;
+            }
+            queue.push(tick, uint32_t(sequence));
+            reference.emplace(tick, sequence);
+            ticks.push_back(tick);
+            sequence++;
+        }
+
+        const uint32_t pops = rng() % 8;
+        for (uint32_t i = 0; i < pops && !reference.empty(); i++)
+        {
+            const auto expected = *reference.begin();
+            reference.erase(reference.begin());
+
+            ASSERT_EQ(queue.front(), expected.second);
+            const auto value = queue.pop();
+            ASSERT_EQ(value, expected.second);
+            ASSERT_EQ(ticks[value], expected.first);
+        }
+        ASSERT_EQ(queue.size(), reference.size());
+        ASSERT_EQ(queue.empty(), reference.empty());
+
+        if (rng() % 4 == 0)
+            currentTick++;
+        if (rng() % 2000 == 0)
+        {
+            queue.clear();
+            reference.clear();
+        }
+    }
+
+    while (!reference.empty())
+    {
+        ASSERT_EQ(queue.pop(), reference.begin()->second);
+        reference.erase(reference.begin());
+    }
+    ASSERT_TRUE(queue.empty());
+}